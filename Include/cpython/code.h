@@ -63,6 +63,7 @@ typedef uint16_t _Py_CODEUNIT;
                                       table */                                 \
     int co_flags;                  /* CO_..., see below */                     \
     int co_warmup;                 /* Warmup counter for quickening */         \
+    int co_optimizer_warmup;       /* Warmup counter for the loop optimizer */ \
                                                                                \
     /* The rest are not so impactful on performance. */                        \
     int co_argcount;              /* #arguments, except *args */               \
@@ -89,6 +90,7 @@ typedef uint16_t _Py_CODEUNIT;
     PyObject *co_linetable;       /* bytes object that holds location info */  \
     PyObject *co_weakreflist;     /* to support weakrefs to code objects */    \
     void *_co_code;               /* cached co_code object/attribute */        \
+    struct _PyExecutorArray *_co_executors; /* optimized loops */              \
     /* Scratch space for extra data relating to the code object.               \
        Type is a void* to keep the format private in codeobject.c to force     \
        people to go through the proper APIs. */                                \
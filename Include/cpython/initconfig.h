@@ -144,10 +144,13 @@ typedef struct PyConfig {
     int tracemalloc;
     int import_time;
     int code_debug_ranges;
+    int jit;
     int show_ref_count;
     int dump_refs;
     wchar_t *dump_refs_file;
     int malloc_stats;
+    int malloc_hugepages;
+    wchar_t *freelist_limits;
     wchar_t *filesystem_encoding;
     wchar_t *filesystem_errors;
     wchar_t *pycache_prefix;
@@ -10,7 +10,6 @@ extern "C" {
 
 /* Forward declarations */
 struct pyruntimestate;
-struct _ceval_runtime_state;
 
 /* WASI has limited call stack. wasmtime 0.36 can handle sufficient amount of
    C stack frames for little more than 750 recursions. */
@@ -27,8 +26,7 @@ struct _ceval_runtime_state;
 
 
 extern void _Py_FinishPendingCalls(PyThreadState *tstate);
-extern void _PyEval_InitRuntimeState(struct _ceval_runtime_state *);
-extern void _PyEval_InitState(struct _ceval_state *, PyThread_type_lock);
+extern void _PyEval_InitState(PyInterpreterState *, PyThread_type_lock);
 extern void _PyEval_FiniState(struct _ceval_state *ceval);
 PyAPI_FUNC(void) _PyEval_SignalReceived(PyInterpreterState *interp);
 PyAPI_FUNC(int) _PyEval_AddPendingCall(
@@ -82,8 +80,9 @@ _PyEval_Vector(PyThreadState *tstate,
             PyObject *kwnames);
 
 extern int _PyEval_ThreadsInitialized(struct pyruntimestate *runtime);
-extern PyStatus _PyEval_InitGIL(PyThreadState *tstate);
+extern PyStatus _PyEval_InitGIL(PyThreadState *tstate, int own_gil);
 extern void _PyEval_FiniGIL(PyInterpreterState *interp);
+extern void _PyEval_SwitchGIL(PyThreadState *oldts, PyThreadState *newts);
 
 extern void _PyEval_ReleaseLock(PyThreadState *tstate);
 
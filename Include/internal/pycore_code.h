@@ -58,8 +58,6 @@ typedef struct {
     _Py_CODEUNIT index;
 } _PyAttrCache;
 
-#define INLINE_CACHE_ENTRIES_LOAD_ATTR CACHE_ENTRIES(_PyAttrCache)
-
 #define INLINE_CACHE_ENTRIES_STORE_ATTR CACHE_ENTRIES(_PyAttrCache)
 
 typedef struct {
@@ -71,6 +69,11 @@ typedef struct {
 
 #define INLINE_CACHE_ENTRIES_LOAD_METHOD CACHE_ENTRIES(_PyLoadMethodCache)
 
+// LOAD_ATTR shares its layout with LOAD_METHOD, so that properties and class
+// attributes can cache a descriptor. The specializations that only need a
+// version and an index still use the shorter _PyAttrCache prefix.
+#define INLINE_CACHE_ENTRIES_LOAD_ATTR CACHE_ENTRIES(_PyLoadMethodCache)
+
 typedef struct {
     _Py_CODEUNIT counter;
     _Py_CODEUNIT func_version[2];
@@ -85,11 +88,37 @@ typedef struct {
 
 #define INLINE_CACHE_ENTRIES_STORE_SUBSCR CACHE_ENTRIES(_PyStoreSubscrCache)
 
+typedef struct {
+    _Py_CODEUNIT counter;
+} _PyForIterCache;
+
+#define INLINE_CACHE_ENTRIES_FOR_ITER CACHE_ENTRIES(_PyForIterCache)
+
+typedef struct {
+    _Py_CODEUNIT counter;
+} _PySendCache;
+
+#define INLINE_CACHE_ENTRIES_SEND CACHE_ENTRIES(_PySendCache)
+
+typedef struct {
+    _Py_CODEUNIT counter;
+} _PyContainsOpCache;
+
+#define INLINE_CACHE_ENTRIES_CONTAINS_OP CACHE_ENTRIES(_PyContainsOpCache)
+
+/* CONTAINS_OP_TUPLE scans tuples of at most this length */
+#define CONTAINS_OP_TUPLE_MAX_SIZE 8
+
 #define QUICKENING_WARMUP_DELAY 8
 
 /* We want to compare to zero for efficiency, so we offset values accordingly */
 #define QUICKENING_INITIAL_WARMUP_VALUE (-QUICKENING_WARMUP_DELAY)
 
+/* Back edges executed before a loop is handed to the optimizer
+ * (Python/optimizer.c), and after a loop it could not handle. */
+#define OPTIMIZER_WARMUP 16
+#define OPTIMIZER_BACKOFF 1024
+
 void _PyCode_Quicken(PyCodeObject *code);
 
 static inline void
@@ -245,6 +274,12 @@ extern void _Py_Specialize_CompareOp(PyObject *lhs, PyObject *rhs,
                                      _Py_CODEUNIT *instr, int oparg);
 extern void _Py_Specialize_UnpackSequence(PyObject *seq, _Py_CODEUNIT *instr,
                                           int oparg);
+extern void _Py_Specialize_ForIter(PyObject *iter, _Py_CODEUNIT *instr,
+                                   int oparg);
+extern void _Py_Specialize_Send(PyObject *receiver, _Py_CODEUNIT *instr,
+                                int oparg);
+extern void _Py_Specialize_ContainsOp(PyObject *item, PyObject *container,
+                                      _Py_CODEUNIT *instr);
 
 /* Deallocator function for static codeobjects used in deepfreeze.py */
 extern void _PyStaticCode_Dealloc(PyCodeObject *co);
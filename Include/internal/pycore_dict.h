@@ -9,6 +9,8 @@ extern "C" {
 #  error "this header requires Py_BUILD_CORE define"
 #endif
 
+#include "pycore_freelist.h"      // struct _Py_freelist_info
+
 
 /* runtime lifecycle */
 
@@ -28,11 +30,14 @@ extern void _PyDict_Fini(PyInterpreterState *interp);
 
 struct _Py_dict_state {
 #if PyDict_MAXFREELIST > 0
-    /* Dictionary reuse scheme to save calls to malloc and free */
-    PyDictObject *free_list[PyDict_MAXFREELIST];
+    /* Dictionary reuse scheme to save calls to malloc and free.  The arrays
+       have room for info.limit and keys_info.limit entries. */
+    PyDictObject **free_list;
     int numfree;
-    PyDictKeysObject *keys_free_list[PyDict_MAXFREELIST];
+    struct _Py_freelist_info info;
+    PyDictKeysObject **keys_free_list;
     int keys_numfree;
+    struct _Py_freelist_info keys_info;
 #endif
 };
 
@@ -8,6 +8,8 @@ extern "C" {
 #  error "this header requires Py_BUILD_CORE define"
 #endif
 
+#include "pycore_freelist.h"      // struct _Py_freelist_info
+
 
 /* runtime lifecycle */
 
@@ -35,6 +37,7 @@ struct _Py_float_state {
        linked via abuse of their ob_type members. */
     int numfree;
     PyFloatObject *free_list;
+    struct _Py_freelist_info info;
 #endif
 };
 
@@ -61,6 +61,9 @@ typedef struct _PyInterpreterFrame {
     _Py_CODEUNIT *prev_instr;
     int stacktop;     /* Offset of TOS from localsplus  */
     bool is_entry;  // Whether this is the "root" frame for the current _PyCFrame.
+    // Whether this is an __init__ frame pushed by CALL_ALLOC_AND_ENTER_INIT,
+    // whose return value must be None and is replaced by the new instance.
+    bool is_init;
     char owner;
     /* Locals and stack */
     PyObject *localsplus[1];
@@ -109,6 +112,7 @@ _PyFrame_InitializeSpecials(
     frame->frame_obj = NULL;
     frame->prev_instr = _PyCode_CODE(frame->f_code) - 1;
     frame->is_entry = false;
+    frame->is_init = false;
     frame->owner = FRAME_OWNED_BY_THREAD;
 }
 
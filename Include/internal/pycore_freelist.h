@@ -0,0 +1,78 @@
+#ifndef Py_INTERNAL_FREELIST_H
+#define Py_INTERNAL_FREELIST_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+/* The free lists of an interpreter keep deallocated objects of the most
+   common types for reuse.  The *_MAXFREELIST constants of the type headers
+   are the default limits; a constant of 0 removes the free list from the
+   build.  The limits can be changed at runtime with PyConfig.freelist_limits
+   and sys._set_freelist_limit(). */
+
+enum _Py_freelist_kind {
+    _Py_FREELIST_FLOAT,
+    _Py_FREELIST_DICT,
+    _Py_FREELIST_DICT_KEYS,
+    _Py_FREELIST_LIST,
+    _Py_FREELIST_TUPLE,             /* the limit is per tuple size */
+    _Py_FREELIST_ASYNC_GEN_VALUE,
+    _Py_FREELIST_ASYNC_GEN_ASEND,
+    _Py_FREELIST_KINDS
+};
+
+struct _Py_freelist_info {
+    /* Maximum number of objects kept */
+    int limit;
+    /* Allocations served from the free list, and allocations which found
+       it empty */
+    size_t hits;
+    size_t misses;
+};
+
+/* Set the default limits of the free lists, then those of
+   PyConfig.freelist_limits */
+extern PyStatus _PyObject_InitFreeLists(PyInterpreterState *interp);
+
+/* Parse a "name=limit,..." specification into limits, which is indexed by
+   _Py_freelist_kind; the limits of the free lists not named are left
+   unchanged.  Return -1 if it is invalid, without setting an exception. */
+extern int _PyObject_ParseFreeListLimits(const wchar_t *spec, int *limits);
+
+/* Return the name of the free list of the given kind, or NULL if there is
+   no such kind */
+extern const char* _PyObject_GetFreeListName(int kind);
+
+/* Return the limit and counters of the free list of the given kind and set
+   *numfree to the number of objects it holds, or return NULL if the build
+   has no such free list */
+extern struct _Py_freelist_info* _PyObject_GetFreeList(
+    PyInterpreterState *interp,
+    int kind,
+    Py_ssize_t *numfree);
+
+/* Set the limit of a free list, freeing the objects above it.  Return -1
+   without setting an exception on memory allocation failure. */
+extern int _PyObject_SetFreeListLimit(
+    PyInterpreterState *interp,
+    int kind,
+    int limit);
+
+/* Set the limits of the free lists of each type.  Return -1 without setting
+   an exception on memory allocation failure. */
+extern int _PyFloat_SetFreeListLimit(PyInterpreterState *interp, int limit);
+extern int _PyDict_SetFreeListLimit(PyInterpreterState *interp, int keys,
+                                    int limit);
+extern int _PyList_SetFreeListLimit(PyInterpreterState *interp, int limit);
+extern int _PyTuple_SetFreeListLimit(PyInterpreterState *interp, int limit);
+extern int _PyAsyncGen_SetFreeListLimit(PyInterpreterState *interp,
+                                        int asend, int limit);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !Py_INTERNAL_FREELIST_H */
@@ -15,7 +15,7 @@ typedef struct {
     uintptr_t _gc_next;
 
     // Pointer to previous object in the list.
-    // Lowest two bits are used for flags documented later.
+    // Lowest bits are used for flags documented later.
     uintptr_t _gc_prev;
 } PyGC_Head;
 
@@ -49,8 +49,19 @@ static inline int _PyObject_GC_MAY_BE_TRACKED(PyObject *obj) {
 #define _PyGC_PREV_MASK_FINALIZED  (1)
 /* Bit 1 is set when the object is in generation which is GCed currently. */
 #define _PyGC_PREV_MASK_COLLECTING (2)
+#if SIZEOF_VOID_P >= 8
+/* Bit 2 is set when the object waits in the pending list of an incremental
+   collection (see gc_incremental_state).  GC heads are 8-byte aligned. */
+#  define _PyGC_PREV_MASK_PENDING  (4)
+/* The (N-3) most significant bits contain the real address. */
+#  define _PyGC_PREV_SHIFT         (3)
+#else
+/* There is no room for the pending bit: incremental collections only scan
+   the objects of their slice. */
+#  define _PyGC_PREV_MASK_PENDING  (0)
 /* The (N-2) most significant bits contain the real address. */
-#define _PyGC_PREV_SHIFT           (2)
+#  define _PyGC_PREV_SHIFT         (2)
+#endif
 #define _PyGC_PREV_MASK            (((uintptr_t) -1) << _PyGC_PREV_SHIFT)
 
 // Lowest bit of _gc_next is used for flags only in GC.
@@ -63,7 +74,7 @@ static inline void _PyGCHead_SET_NEXT(PyGC_Head *gc, PyGC_Head *next) {
     gc->_gc_next = _Py_CAST(uintptr_t, next);
 }
 
-// Lowest two bits of _gc_prev is used for _PyGC_PREV_MASK_* flags.
+// Lowest bits of _gc_prev are used for _PyGC_PREV_MASK_* flags.
 static inline PyGC_Head* _PyGCHead_PREV(PyGC_Head *gc) {
     uintptr_t prev = (gc->_gc_prev & _PyGC_PREV_MASK);
     return _Py_CAST(PyGC_Head*, prev);
@@ -114,14 +125,23 @@ static inline void _PyGC_SET_FINALIZED(PyObject *op) {
    recursively, tuples of immutable objects) do not need to be tracked.
    The interpreter creates a large number of tuples, many of which will
    not survive until garbage collection. It is therefore not worthwhile
-   to untrack eligible tuples at creation time.
+   to examine the items of a tuple at creation time just to untrack it.
 
-   Instead, all tuples except the empty tuple are tracked when created.
+   Instead, most tuples except the empty tuple are tracked when created.
+   Only the tuples built by the interpreter from values already on its
+   stack (BUILD_TUPLE, *args) are created untracked if none of their items
+   may be tracked, since the items are copied one by one anyway.
    During garbage collection it is determined whether any surviving tuples
    can be untracked. A tuple can be untracked if all of its contents are
    already not tracked. Tuples are examined for untracking in all garbage
    collection cycles. It may take more than one cycle to untrack a tuple.
 
+   Lists built by the interpreter (BUILD_LIST) follow the same rule: a
+   list display of atomic items is created untracked, and the list is
+   tracked again when an item which may be tracked is stored into it
+   (see _PyList_MaintainTracking).  Unlike dictionaries, lists are never
+   untracked by the collector: they are rarely both long lived and atomic.
+
    Dictionaries containing only immutable objects also do not need to be
    tracked. Dictionaries are untracked when created. If a tracked item is
    inserted into a dictionary (either as a key or value), the dictionary
@@ -152,6 +172,84 @@ struct gc_generation_stats {
     Py_ssize_t collected;
     /* total number of uncollectable objects (put into gc.garbage) */
     Py_ssize_t uncollectable;
+    /* total time spent in collections */
+    _PyTime_t time;
+    /* running average of the fraction of examined objects which survived */
+    double survival;
+    /* number of times the adaptive policy raised or lowered the threshold */
+    Py_ssize_t raised;
+    Py_ssize_t lowered;
+};
+
+/* Incremental collection of the oldest generation.
+
+   A pass first moves the objects of the oldest generation to the pending
+   list ("arming" them), a bounded chunk per increment.  Then each increment
+   collects the young generations together with objects taken from the
+   pending list, each followed by the pending objects it refers to (so that
+   cycles are collected together), until a slice of work is used up.
+   Survivors go back to the oldest generation, and the pass ends when the
+   pending list is empty.  Objects outside an increment only count as
+   references from outside, so no write barrier is needed for correctness;
+   garbage structures larger than an increment are left to the full
+   collections, which run when a pass finds that the live objects doubled
+   since the last one. */
+struct gc_incremental_state {
+    /* Time budget of an increment in microseconds, 0 if disabled. */
+    Py_ssize_t budget;
+    /* Phase of the current pass, see gcmodule.c. */
+    int phase;
+    /* Objects of the oldest generation left to scan in this pass. */
+    PyGC_Head pending;
+    /* Number of objects and references examined per increment, tuned to
+       fit the budget. */
+    Py_ssize_t slice;
+    /* Objects which survived an increment of the current pass. */
+    Py_ssize_t survivors;
+    /* Objects which survived the last full collection. */
+    Py_ssize_t full_survivors;
+    /* Set when the next collection of the oldest generation must be full. */
+    int full_due;
+    /* Running stats */
+    Py_ssize_t increments;
+    _PyTime_t total_time;
+    _PyTime_t max_time;
+};
+
+/* Adaptive collection thresholds.
+
+   The time spent collecting is measured against the time elapsed, over a
+   window of about a second.  When this overhead exceeds the target and the
+   collections of a generation mostly promote their objects, the threshold of
+   that generation is doubled; it is halved back towards the threshold set by
+   the user once the overhead is low again, or when the collections free most
+   of what they examine. */
+struct gc_adaptive_state {
+    /* Highest fraction of the time to spend collecting, 0 if disabled. */
+    double target;
+    /* Thresholds set by the user, the lower bounds of the adapted ones. */
+    int base_threshold[NUM_GENERATIONS];
+    /* End of the last collection. */
+    _PyTime_t last_end;
+    /* Time spent collecting, and time elapsed, decaying over time. */
+    _PyTime_t gc_time;
+    _PyTime_t total_time;
+};
+
+/* Profile of the last collection, see gc.set_profile(). */
+struct gc_profile_state {
+    /* Per-type numbers of examined objects and time spent traversing them,
+       keyed by type, or NULL if profiling is disabled. */
+    struct _Py_hashtable_t *types;
+    /* Set while a profiled collection runs */
+    int active;
+    int generation;
+    int incremental;
+    /* Time spent handling weak references and finalizers */
+    _PyTime_t weakref_time;
+    _PyTime_t finalizer_time;
+    /* The profile of the last collection as a dict, or NULL */
+    PyObject *last;
 };
 
 struct _gc_runtime_state {
@@ -187,6 +285,12 @@ struct _gc_runtime_state {
        collections, and are awaiting to undergo a full collection for
        the first time. */
     Py_ssize_t long_lived_pending;
+    struct gc_incremental_state incremental;
+    struct gc_adaptive_state adaptive;
+    /* Number of threads subtracting the internal references of large
+       collections, see gc.set_parallel(). */
+    int parallel;
+    struct gc_profile_state profile;
 };
 
 
@@ -8,9 +8,12 @@ extern "C" {
 #  error "this header requires Py_BUILD_CORE define"
 #endif
 
+#include "pycore_freelist.h"      // struct _Py_freelist_info
+
 extern PyObject *_PyGen_yf(PyGenObject *);
 extern PyObject *_PyCoro_GetAwaitableIter(PyObject *o);
 extern PyObject *_PyAsyncGenValueWrapperNew(PyObject *);
+extern void _PyGen_ConvertStopIteration(PyGenObject *);
 
 /* runtime lifecycle */
 
@@ -33,12 +36,15 @@ struct _Py_async_gen_state {
     /* Freelists boost performance 6-10%; they also reduce memory
        fragmentation, as _PyAsyncGenWrappedValue and PyAsyncGenASend
        are short-living objects that are instantiated for every
-       __anext__() call. */
-    struct _PyAsyncGenWrappedValue* value_freelist[_PyAsyncGen_MAXFREELIST];
+       __anext__() call.  The arrays have room for value_info.limit and
+       asend_info.limit entries. */
+    struct _PyAsyncGenWrappedValue** value_freelist;
     int value_numfree;
+    struct _Py_freelist_info value_info;
 
-    struct PyAsyncGenASend* asend_freelist[_PyAsyncGen_MAXFREELIST];
+    struct PyAsyncGenASend** asend_freelist;
     int asend_numfree;
+    struct _Py_freelist_info asend_info;
 #endif
 };
 
@@ -21,6 +21,7 @@ extern "C" {
 #include "pycore_gil.h"           // struct _gil_runtime_state
 #include "pycore_gc.h"            // struct _gc_runtime_state
 #include "pycore_list.h"          // struct _Py_list_state
+#include "pycore_pymem.h"         // struct _Py_obmalloc_cache
 #include "pycore_tuple.h"         // struct _Py_tuple_state
 #include "pycore_typeobject.h"    // struct type_cache
 #include "pycore_unicodeobject.h" // struct _Py_unicode_state
@@ -41,6 +42,8 @@ struct _pending_calls {
     } calls[NPENDINGCALLS];
     int first;
     int last;
+    /* Set while the calls are made, to not make them recursively */
+    int busy;
 };
 
 struct _ceval_state {
@@ -51,6 +54,10 @@ struct _ceval_state {
     /* Request for dropping the GIL */
     _Py_atomic_int gil_drop_request;
     struct _pending_calls pending;
+    /* The GIL of the interpreter: its own (PyInterpreterState._gil) if
+       own_gil is set, else the GIL of the main interpreter */
+    struct _gil_runtime_state *gil;
+    int own_gil;
 };
 
 
@@ -165,6 +172,7 @@ struct _is {
        created and then deleted again. */
     PySliceObject *slice_cache;
 
+    struct _Py_obmalloc_cache obmalloc;
     struct _Py_tuple_state tuple;
     struct _Py_list_state list;
     struct _Py_dict_state dict_state;
@@ -176,6 +184,9 @@ struct _is {
     struct type_cache type_cache;
     struct callable_cache callable_cache;
 
+    /* The GIL, if the interpreter has its own (see ceval.gil) */
+    struct _gil_runtime_state _gil;
+
     /* The following fields are here to avoid allocation during init.
        The data is exposed through PyInterpreterState pointer fields.
        These fields should not be accessed directly outside of init.
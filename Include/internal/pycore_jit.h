@@ -0,0 +1,51 @@
+#ifndef Py_INTERNAL_JIT_H
+#define Py_INTERNAL_JIT_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+/* Machine code generation for optimized loops, see Python/jit.c.
+ *
+ * Compiled code is a sequence of steps.  Each step calls a function with a
+ * state shared by all steps, an argument of its own and a value passed from
+ * step to step in a register; the function returns the new value, and one of
+ * the statuses below.  Any other status makes the compiled code return it,
+ * with the value, to its caller. */
+
+#if defined(__x86_64__) && !defined(MS_WINDOWS) && defined(HAVE_MMAP)
+#  define _Py_JIT 1
+#endif
+
+#define _PyJIT_CONTINUE 0       /* Go on with the next step */
+#define _PyJIT_JUMP 1           /* Go on with the step's jump target */
+
+typedef struct {
+    void *value;
+    int status;
+} _PyJITResult;
+
+typedef _PyJITResult (*_PyJITFunction)(void *state, void *arg, void *value);
+
+typedef struct {
+    _PyJITFunction function;    /* NULL: just jump */
+    void *arg;
+    int jump;                   /* Index of the step jumped to, or -1 */
+} _PyJITStep;
+
+typedef _PyJITResult (*_PyJITCode)(void *state, void *value);
+
+#ifdef _Py_JIT
+/* Returns NULL if the code cannot be allocated. */
+extern _PyJITCode _PyJIT_Compile(const _PyJITStep *steps, int length,
+                                 size_t *size);
+extern void _PyJIT_Free(_PyJITCode code, size_t size);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !Py_INTERNAL_JIT_H */
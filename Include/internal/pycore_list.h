@@ -9,6 +9,8 @@ extern "C" {
 #endif
 
 #include "listobject.h"           // _PyList_CAST()
+#include "pycore_freelist.h"      // struct _Py_freelist_info
+#include "pycore_gc.h"            // _PyObject_GC_MAY_BE_TRACKED()
 
 
 /* runtime lifecycle */
@@ -30,13 +32,32 @@ extern void _PyList_Fini(PyInterpreterState *);
 
 struct _Py_list_state {
 #if PyList_MAXFREELIST > 0
-    PyListObject *free_list[PyList_MAXFREELIST];
+    /* Room for info.limit entries */
+    PyListObject **free_list;
     int numfree;
+    struct _Py_freelist_info info;
 #endif
 };
 
 #define _PyList_ITEMS(op) (_PyList_CAST(op)->ob_item)
 
+/* Lists built by the interpreter from atomic items only (numbers,
+   strings, untracked tuples...) are created untracked, see
+   _PyList_FromArraySteal().  Every store of an item into an existing list
+   must then track the list if the item may be part of a cycle.  The list
+   may be in an inconsistent state at this point, so it is not traversed. */
+PyAPI_FUNC(void) _PyList_Track(PyListObject *self);
+
+static inline void
+_PyList_MaintainTracking(PyListObject *self, PyObject *item)
+{
+    if (!_PyObject_GC_IS_TRACKED(self) && _PyObject_GC_MAY_BE_TRACKED(item)) {
+        _PyList_Track(self);
+    }
+}
+
+extern PyObject *_PyList_FromArraySteal(PyObject *const *src, Py_ssize_t n);
+
 extern int
 _PyList_AppendTakeRefListResize(PyListObject *self, PyObject *newitem);
 
@@ -48,6 +69,7 @@ _PyList_AppendTakeRef(PyListObject *self, PyObject *newitem)
     Py_ssize_t len = PyList_GET_SIZE(self);
     Py_ssize_t allocated = self->allocated;
     assert((size_t)len + 1 < PY_SSIZE_T_MAX);
+    _PyList_MaintainTracking(self, newitem);
     if (allocated > len) {
         PyList_SET_ITEM(self, len, newitem);
         Py_SET_SIZE(self, len + 1);
@@ -56,6 +78,12 @@ _PyList_AppendTakeRef(PyListObject *self, PyObject *newitem)
     return _PyList_AppendTakeRefListResize(self, newitem);
 }
 
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t it_index;
+    PyListObject *it_seq; /* Set to NULL when iterator is exhausted */
+} _PyListIterObject;
+
 #ifdef __cplusplus
 }
 #endif
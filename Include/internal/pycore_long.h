@@ -43,10 +43,31 @@ static inline PyObject* _PyLong_FromUnsignedChar(unsigned char i)
     return Py_NewRef((PyObject *)&_PyLong_SMALL_INTS[_PY_NSMALLNEGINTS+i]);
 }
 
+/* A "compact" int is zero or has a single digit.  The specialized
+ * BINARY_OP forms operate directly on the values of compact ints. */
+static inline int
+_PyLong_IsCompact(PyLongObject *op)
+{
+    assert(PyLong_Check(op));
+    return ((size_t)Py_SIZE(op)) + 1U < 3U;
+}
+
+static inline Py_ssize_t
+_PyLong_CompactValue(PyLongObject *op)
+{
+    assert(_PyLong_IsCompact(op));
+    return Py_SIZE(op) * (Py_ssize_t)op->ob_digit[0];
+}
+
+/* Largest shift for which a compact int shifted left fits in a long long */
+#define _PyLong_MAX_COMPACT_LSHIFT (63 - PyLong_SHIFT)
+
 PyObject *_PyLong_Add(PyLongObject *left, PyLongObject *right);
 PyObject *_PyLong_Multiply(PyLongObject *left, PyLongObject *right);
 PyObject *_PyLong_Subtract(PyLongObject *left, PyLongObject *right);
 
+int _PyLong_AssignValue(PyObject **target, long value);
+
 /* Used by Python/mystrtoul.c, _PyBytes_FromHex(),
    _PyBytes_DecodeEscape(), etc. */
 PyAPI_DATA(unsigned char) _PyLong_DigitValue[256];
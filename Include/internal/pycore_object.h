@@ -14,9 +14,13 @@ extern "C" {
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
 #include "pycore_runtime.h"       // _PyRuntime
 
+/* Initial reference count of the statically allocated objects, large enough
+   for them to never be deallocated */
+#define _PyObject_IMMORTAL_REFCNT 999999999
+
 #define _PyObject_IMMORTAL_INIT(type) \
     { \
-        .ob_refcnt = 999999999, \
+        .ob_refcnt = _PyObject_IMMORTAL_REFCNT, \
         .ob_type = type, \
     }
 #define _PyVarObject_IMMORTAL_INIT(type, size) \
@@ -25,6 +29,35 @@ extern "C" {
         .ob_size = size, \
     }
 
+/* Bias added to the reference count of the objects shared by the
+   interpreters while subinterpreters run under their own GIL, so that they
+   are never deallocated even if some updates of their reference count are
+   lost (see _PyObject_SetSharedObjectsPinned()).  It is below the reference
+   count of the statically allocated objects, which are left unchanged. */
+#define _PyObject_PINNED_REFCNT ((Py_ssize_t)1 << 28)
+
+static inline int
+_PyObject_IsPinned(PyObject *op)
+{
+    return (Py_REFCNT(op) >= _PyObject_PINNED_REFCNT / 2
+            && Py_REFCNT(op) < _PyObject_PINNED_REFCNT * 2);
+}
+
+/* Add or remove the bias, at most once */
+static inline void
+_PyObject_SetPinned(PyObject *op, int pinned)
+{
+    if (pinned && Py_REFCNT(op) < _PyObject_PINNED_REFCNT / 2) {
+        Py_SET_REFCNT(op, Py_REFCNT(op) + _PyObject_PINNED_REFCNT);
+    }
+    else if (!pinned && _PyObject_IsPinned(op)) {
+        Py_SET_REFCNT(op, Py_REFCNT(op) - _PyObject_PINNED_REFCNT);
+    }
+}
+
+extern void _PyObject_SetSharedObjectsPinned(int pinned);
+extern void _PyType_SetStaticTypePinned(PyTypeObject *type, int pinned);
+
 PyAPI_FUNC(void) _Py_NO_RETURN _Py_FatalRefcountErrorFunc(
     const char *func,
     const char *message);
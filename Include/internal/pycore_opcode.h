@@ -18,6 +18,8 @@ extern const uint8_t _PyOpcode_Deopt[256];
 
 extern const uint8_t _PyOpcode_Original[256];
 
+extern const uint8_t _PyOpcode_SuperinstructionSecond[256];
+
 #ifdef NEED_OPCODE_TABLES
 static const uint32_t _PyOpcode_RelativeJump[8] = {
     0U,
@@ -44,11 +46,14 @@ const uint8_t _PyOpcode_Caches[256] = {
     [BINARY_SUBSCR] = 4,
     [STORE_SUBSCR] = 1,
     [UNPACK_SEQUENCE] = 1,
+    [FOR_ITER] = 1,
     [STORE_ATTR] = 4,
-    [LOAD_ATTR] = 4,
+    [LOAD_ATTR] = 9,
     [COMPARE_OP] = 2,
     [LOAD_GLOBAL] = 5,
+    [CONTAINS_OP] = 1,
     [BINARY_OP] = 1,
+    [SEND] = 1,
     [LOAD_METHOD] = 9,
     [CALL] = 4,
 };
@@ -62,11 +67,19 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [BINARY_OP_ADD_FLOAT] = BINARY_OP,
     [BINARY_OP_ADD_INT] = BINARY_OP,
     [BINARY_OP_ADD_UNICODE] = BINARY_OP,
+    [BINARY_OP_AND_INT] = BINARY_OP,
+    [BINARY_OP_FLOOR_DIVIDE_INT] = BINARY_OP,
     [BINARY_OP_INPLACE_ADD_UNICODE] = BINARY_OP,
+    [BINARY_OP_LSHIFT_INT] = BINARY_OP,
+    [BINARY_OP_MIXED_INT_FLOAT] = BINARY_OP,
     [BINARY_OP_MULTIPLY_FLOAT] = BINARY_OP,
     [BINARY_OP_MULTIPLY_INT] = BINARY_OP,
+    [BINARY_OP_OR_INT] = BINARY_OP,
+    [BINARY_OP_REMAINDER_INT] = BINARY_OP,
+    [BINARY_OP_RSHIFT_INT] = BINARY_OP,
     [BINARY_OP_SUBTRACT_FLOAT] = BINARY_OP,
     [BINARY_OP_SUBTRACT_INT] = BINARY_OP,
+    [BINARY_OP_XOR_INT] = BINARY_OP,
     [BINARY_SUBSCR] = BINARY_SUBSCR,
     [BINARY_SUBSCR_ADAPTIVE] = BINARY_SUBSCR,
     [BINARY_SUBSCR_DICT] = BINARY_SUBSCR,
@@ -83,6 +96,7 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [CACHE] = CACHE,
     [CALL] = CALL,
     [CALL_ADAPTIVE] = CALL,
+    [CALL_ALLOC_AND_ENTER_INIT] = CALL,
     [CALL_BOUND_METHOD_EXACT_ARGS] = CALL,
     [CALL_BUILTIN_CLASS] = CALL,
     [CALL_BUILTIN_FAST_WITH_KEYWORDS] = CALL,
@@ -109,6 +123,11 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [COMPARE_OP_INT_JUMP] = COMPARE_OP,
     [COMPARE_OP_STR_JUMP] = COMPARE_OP,
     [CONTAINS_OP] = CONTAINS_OP,
+    [CONTAINS_OP_ADAPTIVE] = CONTAINS_OP,
+    [CONTAINS_OP_DICT] = CONTAINS_OP,
+    [CONTAINS_OP_SET] = CONTAINS_OP,
+    [CONTAINS_OP_STR] = CONTAINS_OP,
+    [CONTAINS_OP_TUPLE] = CONTAINS_OP,
     [COPY] = COPY,
     [COPY_FREE_VARS] = COPY_FREE_VARS,
     [DELETE_ATTR] = DELETE_ATTR,
@@ -124,6 +143,11 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [EXTENDED_ARG_QUICK] = EXTENDED_ARG,
     [FORMAT_VALUE] = FORMAT_VALUE,
     [FOR_ITER] = FOR_ITER,
+    [FOR_ITER_ADAPTIVE] = FOR_ITER,
+    [FOR_ITER_GEN] = FOR_ITER,
+    [FOR_ITER_LIST] = FOR_ITER,
+    [FOR_ITER_RANGE] = FOR_ITER,
+    [FOR_ITER_TUPLE] = FOR_ITER,
     [GET_AITER] = GET_AITER,
     [GET_ANEXT] = GET_ANEXT,
     [GET_AWAITABLE] = GET_AWAITABLE,
@@ -135,6 +159,7 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [IMPORT_STAR] = IMPORT_STAR,
     [IS_OP] = IS_OP,
     [JUMP_BACKWARD] = JUMP_BACKWARD,
+    [JUMP_BACKWARD_EXECUTOR] = JUMP_BACKWARD,
     [JUMP_BACKWARD_NO_INTERRUPT] = JUMP_BACKWARD_NO_INTERRUPT,
     [JUMP_BACKWARD_QUICK] = JUMP_BACKWARD,
     [JUMP_FORWARD] = JUMP_FORWARD,
@@ -147,8 +172,12 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [LOAD_ASSERTION_ERROR] = LOAD_ASSERTION_ERROR,
     [LOAD_ATTR] = LOAD_ATTR,
     [LOAD_ATTR_ADAPTIVE] = LOAD_ATTR,
+    [LOAD_ATTR_CLASS] = LOAD_ATTR,
+    [LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN] = LOAD_ATTR,
     [LOAD_ATTR_INSTANCE_VALUE] = LOAD_ATTR,
+    [LOAD_ATTR_METACLASS] = LOAD_ATTR,
     [LOAD_ATTR_MODULE] = LOAD_ATTR,
+    [LOAD_ATTR_PROPERTY] = LOAD_ATTR,
     [LOAD_ATTR_SLOT] = LOAD_ATTR,
     [LOAD_ATTR_WITH_HINT] = LOAD_ATTR,
     [LOAD_BUILD_CLASS] = LOAD_BUILD_CLASS,
@@ -156,11 +185,14 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [LOAD_CLOSURE] = LOAD_CLOSURE,
     [LOAD_CONST] = LOAD_CONST,
     [LOAD_CONST__LOAD_FAST] = LOAD_CONST,
+    [LOAD_CONST__STORE_FAST] = LOAD_CONST,
     [LOAD_DEREF] = LOAD_DEREF,
     [LOAD_FAST] = LOAD_FAST,
     [LOAD_FAST_CHECK] = LOAD_FAST_CHECK,
     [LOAD_FAST__LOAD_CONST] = LOAD_FAST,
     [LOAD_FAST__LOAD_FAST] = LOAD_FAST,
+    [LOAD_FAST__POP_TOP] = LOAD_FAST,
+    [LOAD_FAST__STORE_FAST] = LOAD_FAST,
     [LOAD_GLOBAL] = LOAD_GLOBAL,
     [LOAD_GLOBAL_ADAPTIVE] = LOAD_GLOBAL,
     [LOAD_GLOBAL_BUILTIN] = LOAD_GLOBAL,
@@ -203,6 +235,8 @@ const uint8_t _PyOpcode_Deopt[256] = {
     [RETURN_GENERATOR] = RETURN_GENERATOR,
     [RETURN_VALUE] = RETURN_VALUE,
     [SEND] = SEND,
+    [SEND_ADAPTIVE] = SEND,
+    [SEND_GEN] = SEND,
     [SETUP_ANNOTATIONS] = SETUP_ANNOTATIONS,
     [SET_ADD] = SET_ADD,
     [SET_UPDATE] = SET_UPDATE,
@@ -245,11 +279,19 @@ const uint8_t _PyOpcode_Original[256] = {
     [BINARY_OP_ADD_FLOAT] = BINARY_OP,
     [BINARY_OP_ADD_INT] = BINARY_OP,
     [BINARY_OP_ADD_UNICODE] = BINARY_OP,
+    [BINARY_OP_AND_INT] = BINARY_OP,
+    [BINARY_OP_FLOOR_DIVIDE_INT] = BINARY_OP,
     [BINARY_OP_INPLACE_ADD_UNICODE] = BINARY_OP,
+    [BINARY_OP_LSHIFT_INT] = BINARY_OP,
+    [BINARY_OP_MIXED_INT_FLOAT] = BINARY_OP,
     [BINARY_OP_MULTIPLY_FLOAT] = BINARY_OP,
     [BINARY_OP_MULTIPLY_INT] = BINARY_OP,
+    [BINARY_OP_OR_INT] = BINARY_OP,
+    [BINARY_OP_REMAINDER_INT] = BINARY_OP,
+    [BINARY_OP_RSHIFT_INT] = BINARY_OP,
     [BINARY_OP_SUBTRACT_FLOAT] = BINARY_OP,
     [BINARY_OP_SUBTRACT_INT] = BINARY_OP,
+    [BINARY_OP_XOR_INT] = BINARY_OP,
     [BINARY_SUBSCR] = BINARY_SUBSCR,
     [BINARY_SUBSCR_ADAPTIVE] = BINARY_SUBSCR,
     [BINARY_SUBSCR_DICT] = BINARY_SUBSCR,
@@ -266,6 +308,7 @@ const uint8_t _PyOpcode_Original[256] = {
     [CACHE] = CACHE,
     [CALL] = CALL,
     [CALL_ADAPTIVE] = CALL,
+    [CALL_ALLOC_AND_ENTER_INIT] = CALL,
     [CALL_BOUND_METHOD_EXACT_ARGS] = CALL,
     [CALL_BUILTIN_CLASS] = CALL,
     [CALL_BUILTIN_FAST_WITH_KEYWORDS] = CALL,
@@ -292,6 +335,11 @@ const uint8_t _PyOpcode_Original[256] = {
     [COMPARE_OP_INT_JUMP] = COMPARE_OP,
     [COMPARE_OP_STR_JUMP] = COMPARE_OP,
     [CONTAINS_OP] = CONTAINS_OP,
+    [CONTAINS_OP_ADAPTIVE] = CONTAINS_OP,
+    [CONTAINS_OP_DICT] = CONTAINS_OP,
+    [CONTAINS_OP_SET] = CONTAINS_OP,
+    [CONTAINS_OP_STR] = CONTAINS_OP,
+    [CONTAINS_OP_TUPLE] = CONTAINS_OP,
     [COPY] = COPY,
     [COPY_FREE_VARS] = COPY_FREE_VARS,
     [DELETE_ATTR] = DELETE_ATTR,
@@ -307,6 +355,11 @@ const uint8_t _PyOpcode_Original[256] = {
     [EXTENDED_ARG_QUICK] = EXTENDED_ARG_QUICK,
     [FORMAT_VALUE] = FORMAT_VALUE,
     [FOR_ITER] = FOR_ITER,
+    [FOR_ITER_ADAPTIVE] = FOR_ITER,
+    [FOR_ITER_GEN] = FOR_ITER,
+    [FOR_ITER_LIST] = FOR_ITER,
+    [FOR_ITER_RANGE] = FOR_ITER,
+    [FOR_ITER_TUPLE] = FOR_ITER,
     [GET_AITER] = GET_AITER,
     [GET_ANEXT] = GET_ANEXT,
     [GET_AWAITABLE] = GET_AWAITABLE,
@@ -318,6 +371,7 @@ const uint8_t _PyOpcode_Original[256] = {
     [IMPORT_STAR] = IMPORT_STAR,
     [IS_OP] = IS_OP,
     [JUMP_BACKWARD] = JUMP_BACKWARD,
+    [JUMP_BACKWARD_EXECUTOR] = JUMP_BACKWARD,
     [JUMP_BACKWARD_NO_INTERRUPT] = JUMP_BACKWARD_NO_INTERRUPT,
     [JUMP_BACKWARD_QUICK] = JUMP_BACKWARD,
     [JUMP_FORWARD] = JUMP_FORWARD,
@@ -330,8 +384,12 @@ const uint8_t _PyOpcode_Original[256] = {
     [LOAD_ASSERTION_ERROR] = LOAD_ASSERTION_ERROR,
     [LOAD_ATTR] = LOAD_ATTR,
     [LOAD_ATTR_ADAPTIVE] = LOAD_ATTR,
+    [LOAD_ATTR_CLASS] = LOAD_ATTR,
+    [LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN] = LOAD_ATTR,
     [LOAD_ATTR_INSTANCE_VALUE] = LOAD_ATTR,
+    [LOAD_ATTR_METACLASS] = LOAD_ATTR,
     [LOAD_ATTR_MODULE] = LOAD_ATTR,
+    [LOAD_ATTR_PROPERTY] = LOAD_ATTR,
     [LOAD_ATTR_SLOT] = LOAD_ATTR,
     [LOAD_ATTR_WITH_HINT] = LOAD_ATTR,
     [LOAD_BUILD_CLASS] = LOAD_BUILD_CLASS,
@@ -339,11 +397,14 @@ const uint8_t _PyOpcode_Original[256] = {
     [LOAD_CLOSURE] = LOAD_CLOSURE,
     [LOAD_CONST] = LOAD_CONST,
     [LOAD_CONST__LOAD_FAST] = LOAD_CONST,
+    [LOAD_CONST__STORE_FAST] = LOAD_CONST,
     [LOAD_DEREF] = LOAD_DEREF,
     [LOAD_FAST] = LOAD_FAST,
     [LOAD_FAST_CHECK] = LOAD_FAST_CHECK,
     [LOAD_FAST__LOAD_CONST] = LOAD_FAST,
     [LOAD_FAST__LOAD_FAST] = LOAD_FAST,
+    [LOAD_FAST__POP_TOP] = LOAD_FAST,
+    [LOAD_FAST__STORE_FAST] = LOAD_FAST,
     [LOAD_GLOBAL] = LOAD_GLOBAL,
     [LOAD_GLOBAL_ADAPTIVE] = LOAD_GLOBAL,
     [LOAD_GLOBAL_BUILTIN] = LOAD_GLOBAL,
@@ -386,6 +447,8 @@ const uint8_t _PyOpcode_Original[256] = {
     [RETURN_GENERATOR] = RETURN_GENERATOR,
     [RETURN_VALUE] = RETURN_VALUE,
     [SEND] = SEND,
+    [SEND_ADAPTIVE] = SEND,
+    [SEND_GEN] = SEND,
     [SETUP_ANNOTATIONS] = SETUP_ANNOTATIONS,
     [SET_ADD] = SET_ADD,
     [SET_UPDATE] = SET_UPDATE,
@@ -418,8 +481,55 @@ const uint8_t _PyOpcode_Original[256] = {
     [WITH_EXCEPT_START] = WITH_EXCEPT_START,
     [YIELD_VALUE] = YIELD_VALUE,
 };
+
+const uint8_t _PyOpcode_SuperinstructionSecond[256] = {
+    [LOAD_CONST__LOAD_FAST] = LOAD_FAST,
+    [LOAD_CONST__STORE_FAST] = STORE_FAST,
+    [LOAD_FAST__LOAD_CONST] = LOAD_CONST,
+    [LOAD_FAST__LOAD_FAST] = LOAD_FAST,
+    [LOAD_FAST__POP_TOP] = POP_TOP,
+    [LOAD_FAST__STORE_FAST] = STORE_FAST,
+    [STORE_FAST__LOAD_FAST] = LOAD_FAST,
+    [STORE_FAST__STORE_FAST] = STORE_FAST,
+};
 #endif   // NEED_OPCODE_TABLES
 
+static inline int
+_PyOpcode_Superinstruction(int first, int second)
+{
+    switch (first) {
+        case LOAD_CONST:
+            switch (second) {
+                case LOAD_FAST:
+                    return LOAD_CONST__LOAD_FAST;
+                case STORE_FAST:
+                    return LOAD_CONST__STORE_FAST;
+            }
+            break;
+        case LOAD_FAST:
+            switch (second) {
+                case LOAD_CONST:
+                    return LOAD_FAST__LOAD_CONST;
+                case LOAD_FAST:
+                    return LOAD_FAST__LOAD_FAST;
+                case POP_TOP:
+                    return LOAD_FAST__POP_TOP;
+                case STORE_FAST:
+                    return LOAD_FAST__STORE_FAST;
+            }
+            break;
+        case STORE_FAST:
+            switch (second) {
+                case LOAD_FAST:
+                    return STORE_FAST__LOAD_FAST;
+                case STORE_FAST:
+                    return STORE_FAST__STORE_FAST;
+            }
+            break;
+    }
+    return 0;
+}
+
 #ifdef Py_DEBUG
 static const char *const _PyOpcode_OpName[256] = {
     [CACHE] = "CACHE",
@@ -429,86 +539,86 @@ static const char *const _PyOpcode_OpName[256] = {
     [BINARY_OP_ADD_FLOAT] = "BINARY_OP_ADD_FLOAT",
     [BINARY_OP_ADD_INT] = "BINARY_OP_ADD_INT",
     [BINARY_OP_ADD_UNICODE] = "BINARY_OP_ADD_UNICODE",
-    [BINARY_OP_INPLACE_ADD_UNICODE] = "BINARY_OP_INPLACE_ADD_UNICODE",
-    [BINARY_OP_MULTIPLY_FLOAT] = "BINARY_OP_MULTIPLY_FLOAT",
+    [BINARY_OP_AND_INT] = "BINARY_OP_AND_INT",
+    [BINARY_OP_FLOOR_DIVIDE_INT] = "BINARY_OP_FLOOR_DIVIDE_INT",
     [NOP] = "NOP",
     [UNARY_POSITIVE] = "UNARY_POSITIVE",
     [UNARY_NEGATIVE] = "UNARY_NEGATIVE",
     [UNARY_NOT] = "UNARY_NOT",
+    [BINARY_OP_INPLACE_ADD_UNICODE] = "BINARY_OP_INPLACE_ADD_UNICODE",
+    [BINARY_OP_LSHIFT_INT] = "BINARY_OP_LSHIFT_INT",
+    [UNARY_INVERT] = "UNARY_INVERT",
+    [BINARY_OP_MIXED_INT_FLOAT] = "BINARY_OP_MIXED_INT_FLOAT",
+    [BINARY_OP_MULTIPLY_FLOAT] = "BINARY_OP_MULTIPLY_FLOAT",
     [BINARY_OP_MULTIPLY_INT] = "BINARY_OP_MULTIPLY_INT",
+    [BINARY_OP_OR_INT] = "BINARY_OP_OR_INT",
+    [BINARY_OP_REMAINDER_INT] = "BINARY_OP_REMAINDER_INT",
+    [BINARY_OP_RSHIFT_INT] = "BINARY_OP_RSHIFT_INT",
     [BINARY_OP_SUBTRACT_FLOAT] = "BINARY_OP_SUBTRACT_FLOAT",
-    [UNARY_INVERT] = "UNARY_INVERT",
     [BINARY_OP_SUBTRACT_INT] = "BINARY_OP_SUBTRACT_INT",
+    [BINARY_OP_XOR_INT] = "BINARY_OP_XOR_INT",
+    [BINARY_SUBSCR] = "BINARY_SUBSCR",
     [BINARY_SUBSCR_ADAPTIVE] = "BINARY_SUBSCR_ADAPTIVE",
     [BINARY_SUBSCR_DICT] = "BINARY_SUBSCR_DICT",
     [BINARY_SUBSCR_GETITEM] = "BINARY_SUBSCR_GETITEM",
     [BINARY_SUBSCR_LIST_INT] = "BINARY_SUBSCR_LIST_INT",
+    [GET_LEN] = "GET_LEN",
+    [MATCH_MAPPING] = "MATCH_MAPPING",
+    [MATCH_SEQUENCE] = "MATCH_SEQUENCE",
+    [MATCH_KEYS] = "MATCH_KEYS",
     [BINARY_SUBSCR_TUPLE_INT] = "BINARY_SUBSCR_TUPLE_INT",
+    [PUSH_EXC_INFO] = "PUSH_EXC_INFO",
+    [CHECK_EXC_MATCH] = "CHECK_EXC_MATCH",
+    [CHECK_EG_MATCH] = "CHECK_EG_MATCH",
     [CALL_ADAPTIVE] = "CALL_ADAPTIVE",
+    [CALL_ALLOC_AND_ENTER_INIT] = "CALL_ALLOC_AND_ENTER_INIT",
     [CALL_PY_EXACT_ARGS] = "CALL_PY_EXACT_ARGS",
     [CALL_PY_WITH_DEFAULTS] = "CALL_PY_WITH_DEFAULTS",
-    [BINARY_SUBSCR] = "BINARY_SUBSCR",
     [CALL_BOUND_METHOD_EXACT_ARGS] = "CALL_BOUND_METHOD_EXACT_ARGS",
     [CALL_BUILTIN_CLASS] = "CALL_BUILTIN_CLASS",
     [CALL_BUILTIN_FAST_WITH_KEYWORDS] = "CALL_BUILTIN_FAST_WITH_KEYWORDS",
     [CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS] = "CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS",
-    [GET_LEN] = "GET_LEN",
-    [MATCH_MAPPING] = "MATCH_MAPPING",
-    [MATCH_SEQUENCE] = "MATCH_SEQUENCE",
-    [MATCH_KEYS] = "MATCH_KEYS",
     [CALL_NO_KW_BUILTIN_FAST] = "CALL_NO_KW_BUILTIN_FAST",
-    [PUSH_EXC_INFO] = "PUSH_EXC_INFO",
-    [CHECK_EXC_MATCH] = "CHECK_EXC_MATCH",
-    [CHECK_EG_MATCH] = "CHECK_EG_MATCH",
     [CALL_NO_KW_BUILTIN_O] = "CALL_NO_KW_BUILTIN_O",
     [CALL_NO_KW_ISINSTANCE] = "CALL_NO_KW_ISINSTANCE",
+    [WITH_EXCEPT_START] = "WITH_EXCEPT_START",
+    [GET_AITER] = "GET_AITER",
+    [GET_ANEXT] = "GET_ANEXT",
+    [BEFORE_ASYNC_WITH] = "BEFORE_ASYNC_WITH",
+    [BEFORE_WITH] = "BEFORE_WITH",
+    [END_ASYNC_FOR] = "END_ASYNC_FOR",
     [CALL_NO_KW_LEN] = "CALL_NO_KW_LEN",
     [CALL_NO_KW_LIST_APPEND] = "CALL_NO_KW_LIST_APPEND",
     [CALL_NO_KW_METHOD_DESCRIPTOR_FAST] = "CALL_NO_KW_METHOD_DESCRIPTOR_FAST",
     [CALL_NO_KW_METHOD_DESCRIPTOR_NOARGS] = "CALL_NO_KW_METHOD_DESCRIPTOR_NOARGS",
     [CALL_NO_KW_METHOD_DESCRIPTOR_O] = "CALL_NO_KW_METHOD_DESCRIPTOR_O",
+    [STORE_SUBSCR] = "STORE_SUBSCR",
+    [DELETE_SUBSCR] = "DELETE_SUBSCR",
     [CALL_NO_KW_STR_1] = "CALL_NO_KW_STR_1",
     [CALL_NO_KW_TUPLE_1] = "CALL_NO_KW_TUPLE_1",
     [CALL_NO_KW_TYPE_1] = "CALL_NO_KW_TYPE_1",
     [COMPARE_OP_ADAPTIVE] = "COMPARE_OP_ADAPTIVE",
-    [WITH_EXCEPT_START] = "WITH_EXCEPT_START",
-    [GET_AITER] = "GET_AITER",
-    [GET_ANEXT] = "GET_ANEXT",
-    [BEFORE_ASYNC_WITH] = "BEFORE_ASYNC_WITH",
-    [BEFORE_WITH] = "BEFORE_WITH",
-    [END_ASYNC_FOR] = "END_ASYNC_FOR",
     [COMPARE_OP_FLOAT_JUMP] = "COMPARE_OP_FLOAT_JUMP",
     [COMPARE_OP_INT_JUMP] = "COMPARE_OP_INT_JUMP",
-    [COMPARE_OP_STR_JUMP] = "COMPARE_OP_STR_JUMP",
-    [EXTENDED_ARG_QUICK] = "EXTENDED_ARG_QUICK",
-    [JUMP_BACKWARD_QUICK] = "JUMP_BACKWARD_QUICK",
-    [STORE_SUBSCR] = "STORE_SUBSCR",
-    [DELETE_SUBSCR] = "DELETE_SUBSCR",
-    [LOAD_ATTR_ADAPTIVE] = "LOAD_ATTR_ADAPTIVE",
-    [LOAD_ATTR_INSTANCE_VALUE] = "LOAD_ATTR_INSTANCE_VALUE",
-    [LOAD_ATTR_MODULE] = "LOAD_ATTR_MODULE",
-    [LOAD_ATTR_SLOT] = "LOAD_ATTR_SLOT",
-    [LOAD_ATTR_WITH_HINT] = "LOAD_ATTR_WITH_HINT",
-    [LOAD_CONST__LOAD_FAST] = "LOAD_CONST__LOAD_FAST",
     [GET_ITER] = "GET_ITER",
     [GET_YIELD_FROM_ITER] = "GET_YIELD_FROM_ITER",
     [PRINT_EXPR] = "PRINT_EXPR",
     [LOAD_BUILD_CLASS] = "LOAD_BUILD_CLASS",
-    [LOAD_FAST__LOAD_CONST] = "LOAD_FAST__LOAD_CONST",
-    [LOAD_FAST__LOAD_FAST] = "LOAD_FAST__LOAD_FAST",
+    [COMPARE_OP_STR_JUMP] = "COMPARE_OP_STR_JUMP",
+    [CONTAINS_OP_ADAPTIVE] = "CONTAINS_OP_ADAPTIVE",
     [LOAD_ASSERTION_ERROR] = "LOAD_ASSERTION_ERROR",
     [RETURN_GENERATOR] = "RETURN_GENERATOR",
-    [LOAD_GLOBAL_ADAPTIVE] = "LOAD_GLOBAL_ADAPTIVE",
-    [LOAD_GLOBAL_BUILTIN] = "LOAD_GLOBAL_BUILTIN",
-    [LOAD_GLOBAL_MODULE] = "LOAD_GLOBAL_MODULE",
-    [LOAD_METHOD_ADAPTIVE] = "LOAD_METHOD_ADAPTIVE",
-    [LOAD_METHOD_CLASS] = "LOAD_METHOD_CLASS",
-    [LOAD_METHOD_LAZY_DICT] = "LOAD_METHOD_LAZY_DICT",
+    [CONTAINS_OP_DICT] = "CONTAINS_OP_DICT",
+    [CONTAINS_OP_SET] = "CONTAINS_OP_SET",
+    [CONTAINS_OP_STR] = "CONTAINS_OP_STR",
+    [CONTAINS_OP_TUPLE] = "CONTAINS_OP_TUPLE",
+    [EXTENDED_ARG_QUICK] = "EXTENDED_ARG_QUICK",
+    [FOR_ITER_ADAPTIVE] = "FOR_ITER_ADAPTIVE",
     [LIST_TO_TUPLE] = "LIST_TO_TUPLE",
     [RETURN_VALUE] = "RETURN_VALUE",
     [IMPORT_STAR] = "IMPORT_STAR",
     [SETUP_ANNOTATIONS] = "SETUP_ANNOTATIONS",
-    [LOAD_METHOD_MODULE] = "LOAD_METHOD_MODULE",
+    [FOR_ITER_GEN] = "FOR_ITER_GEN",
     [ASYNC_GEN_WRAP] = "ASYNC_GEN_WRAP",
     [PREP_RERAISE_STAR] = "PREP_RERAISE_STAR",
     [POP_EXCEPT] = "POP_EXCEPT",
@@ -535,7 +645,7 @@ static const char *const _PyOpcode_OpName[256] = {
     [JUMP_FORWARD] = "JUMP_FORWARD",
     [JUMP_IF_FALSE_OR_POP] = "JUMP_IF_FALSE_OR_POP",
     [JUMP_IF_TRUE_OR_POP] = "JUMP_IF_TRUE_OR_POP",
-    [LOAD_METHOD_NO_DICT] = "LOAD_METHOD_NO_DICT",
+    [FOR_ITER_LIST] = "FOR_ITER_LIST",
     [POP_JUMP_FORWARD_IF_FALSE] = "POP_JUMP_FORWARD_IF_FALSE",
     [POP_JUMP_FORWARD_IF_TRUE] = "POP_JUMP_FORWARD_IF_TRUE",
     [LOAD_GLOBAL] = "LOAD_GLOBAL",
@@ -543,7 +653,7 @@ static const char *const _PyOpcode_OpName[256] = {
     [CONTAINS_OP] = "CONTAINS_OP",
     [RERAISE] = "RERAISE",
     [COPY] = "COPY",
-    [LOAD_METHOD_WITH_DICT] = "LOAD_METHOD_WITH_DICT",
+    [FOR_ITER_RANGE] = "FOR_ITER_RANGE",
     [BINARY_OP] = "BINARY_OP",
     [SEND] = "SEND",
     [LOAD_FAST] = "LOAD_FAST",
@@ -563,9 +673,9 @@ static const char *const _PyOpcode_OpName[256] = {
     [STORE_DEREF] = "STORE_DEREF",
     [DELETE_DEREF] = "DELETE_DEREF",
     [JUMP_BACKWARD] = "JUMP_BACKWARD",
-    [LOAD_METHOD_WITH_VALUES] = "LOAD_METHOD_WITH_VALUES",
+    [FOR_ITER_TUPLE] = "FOR_ITER_TUPLE",
     [CALL_FUNCTION_EX] = "CALL_FUNCTION_EX",
-    [RESUME_QUICK] = "RESUME_QUICK",
+    [JUMP_BACKWARD_EXECUTOR] = "JUMP_BACKWARD_EXECUTOR",
     [EXTENDED_ARG] = "EXTENDED_ARG",
     [LIST_APPEND] = "LIST_APPEND",
     [SET_ADD] = "SET_ADD",
@@ -575,62 +685,62 @@ static const char *const _PyOpcode_OpName[256] = {
     [YIELD_VALUE] = "YIELD_VALUE",
     [RESUME] = "RESUME",
     [MATCH_CLASS] = "MATCH_CLASS",
-    [STORE_ATTR_ADAPTIVE] = "STORE_ATTR_ADAPTIVE",
-    [STORE_ATTR_INSTANCE_VALUE] = "STORE_ATTR_INSTANCE_VALUE",
+    [JUMP_BACKWARD_QUICK] = "JUMP_BACKWARD_QUICK",
+    [LOAD_ATTR_ADAPTIVE] = "LOAD_ATTR_ADAPTIVE",
     [FORMAT_VALUE] = "FORMAT_VALUE",
     [BUILD_CONST_KEY_MAP] = "BUILD_CONST_KEY_MAP",
     [BUILD_STRING] = "BUILD_STRING",
-    [STORE_ATTR_SLOT] = "STORE_ATTR_SLOT",
-    [STORE_ATTR_WITH_HINT] = "STORE_ATTR_WITH_HINT",
+    [LOAD_ATTR_CLASS] = "LOAD_ATTR_CLASS",
+    [LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN] = "LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN",
     [LOAD_METHOD] = "LOAD_METHOD",
-    [STORE_FAST__LOAD_FAST] = "STORE_FAST__LOAD_FAST",
+    [LOAD_ATTR_INSTANCE_VALUE] = "LOAD_ATTR_INSTANCE_VALUE",
     [LIST_EXTEND] = "LIST_EXTEND",
     [SET_UPDATE] = "SET_UPDATE",
     [DICT_MERGE] = "DICT_MERGE",
     [DICT_UPDATE] = "DICT_UPDATE",
-    [STORE_FAST__STORE_FAST] = "STORE_FAST__STORE_FAST",
-    [STORE_SUBSCR_ADAPTIVE] = "STORE_SUBSCR_ADAPTIVE",
-    [STORE_SUBSCR_DICT] = "STORE_SUBSCR_DICT",
-    [STORE_SUBSCR_LIST_INT] = "STORE_SUBSCR_LIST_INT",
-    [UNPACK_SEQUENCE_ADAPTIVE] = "UNPACK_SEQUENCE_ADAPTIVE",
+    [LOAD_ATTR_METACLASS] = "LOAD_ATTR_METACLASS",
+    [LOAD_ATTR_MODULE] = "LOAD_ATTR_MODULE",
+    [LOAD_ATTR_PROPERTY] = "LOAD_ATTR_PROPERTY",
+    [LOAD_ATTR_SLOT] = "LOAD_ATTR_SLOT",
+    [LOAD_ATTR_WITH_HINT] = "LOAD_ATTR_WITH_HINT",
     [CALL] = "CALL",
     [KW_NAMES] = "KW_NAMES",
     [POP_JUMP_BACKWARD_IF_NOT_NONE] = "POP_JUMP_BACKWARD_IF_NOT_NONE",
     [POP_JUMP_BACKWARD_IF_NONE] = "POP_JUMP_BACKWARD_IF_NONE",
     [POP_JUMP_BACKWARD_IF_FALSE] = "POP_JUMP_BACKWARD_IF_FALSE",
     [POP_JUMP_BACKWARD_IF_TRUE] = "POP_JUMP_BACKWARD_IF_TRUE",
+    [LOAD_GLOBAL_ADAPTIVE] = "LOAD_GLOBAL_ADAPTIVE",
+    [LOAD_GLOBAL_BUILTIN] = "LOAD_GLOBAL_BUILTIN",
+    [LOAD_GLOBAL_MODULE] = "LOAD_GLOBAL_MODULE",
+    [LOAD_METHOD_ADAPTIVE] = "LOAD_METHOD_ADAPTIVE",
+    [LOAD_METHOD_CLASS] = "LOAD_METHOD_CLASS",
+    [LOAD_METHOD_LAZY_DICT] = "LOAD_METHOD_LAZY_DICT",
+    [LOAD_METHOD_MODULE] = "LOAD_METHOD_MODULE",
+    [LOAD_METHOD_NO_DICT] = "LOAD_METHOD_NO_DICT",
+    [LOAD_METHOD_WITH_DICT] = "LOAD_METHOD_WITH_DICT",
+    [LOAD_METHOD_WITH_VALUES] = "LOAD_METHOD_WITH_VALUES",
+    [RESUME_QUICK] = "RESUME_QUICK",
+    [SEND_ADAPTIVE] = "SEND_ADAPTIVE",
+    [SEND_GEN] = "SEND_GEN",
+    [STORE_ATTR_ADAPTIVE] = "STORE_ATTR_ADAPTIVE",
+    [STORE_ATTR_INSTANCE_VALUE] = "STORE_ATTR_INSTANCE_VALUE",
+    [STORE_ATTR_SLOT] = "STORE_ATTR_SLOT",
+    [STORE_ATTR_WITH_HINT] = "STORE_ATTR_WITH_HINT",
+    [STORE_SUBSCR_ADAPTIVE] = "STORE_SUBSCR_ADAPTIVE",
+    [STORE_SUBSCR_DICT] = "STORE_SUBSCR_DICT",
+    [STORE_SUBSCR_LIST_INT] = "STORE_SUBSCR_LIST_INT",
+    [UNPACK_SEQUENCE_ADAPTIVE] = "UNPACK_SEQUENCE_ADAPTIVE",
     [UNPACK_SEQUENCE_LIST] = "UNPACK_SEQUENCE_LIST",
     [UNPACK_SEQUENCE_TUPLE] = "UNPACK_SEQUENCE_TUPLE",
     [UNPACK_SEQUENCE_TWO_TUPLE] = "UNPACK_SEQUENCE_TWO_TUPLE",
-    [180] = "<180>",
-    [181] = "<181>",
-    [182] = "<182>",
-    [183] = "<183>",
-    [184] = "<184>",
-    [185] = "<185>",
-    [186] = "<186>",
-    [187] = "<187>",
-    [188] = "<188>",
-    [189] = "<189>",
-    [190] = "<190>",
-    [191] = "<191>",
-    [192] = "<192>",
-    [193] = "<193>",
-    [194] = "<194>",
-    [195] = "<195>",
-    [196] = "<196>",
-    [197] = "<197>",
-    [198] = "<198>",
-    [199] = "<199>",
-    [200] = "<200>",
-    [201] = "<201>",
-    [202] = "<202>",
-    [203] = "<203>",
-    [204] = "<204>",
-    [205] = "<205>",
-    [206] = "<206>",
-    [207] = "<207>",
-    [208] = "<208>",
+    [LOAD_CONST__LOAD_FAST] = "LOAD_CONST__LOAD_FAST",
+    [LOAD_CONST__STORE_FAST] = "LOAD_CONST__STORE_FAST",
+    [LOAD_FAST__LOAD_CONST] = "LOAD_FAST__LOAD_CONST",
+    [LOAD_FAST__LOAD_FAST] = "LOAD_FAST__LOAD_FAST",
+    [LOAD_FAST__POP_TOP] = "LOAD_FAST__POP_TOP",
+    [LOAD_FAST__STORE_FAST] = "LOAD_FAST__STORE_FAST",
+    [STORE_FAST__LOAD_FAST] = "STORE_FAST__LOAD_FAST",
+    [STORE_FAST__STORE_FAST] = "STORE_FAST__STORE_FAST",
     [209] = "<209>",
     [210] = "<210>",
     [211] = "<211>",
@@ -682,35 +792,6 @@ static const char *const _PyOpcode_OpName[256] = {
 #endif
 
 #define EXTRA_CASES \
-    case 180: \
-    case 181: \
-    case 182: \
-    case 183: \
-    case 184: \
-    case 185: \
-    case 186: \
-    case 187: \
-    case 188: \
-    case 189: \
-    case 190: \
-    case 191: \
-    case 192: \
-    case 193: \
-    case 194: \
-    case 195: \
-    case 196: \
-    case 197: \
-    case 198: \
-    case 199: \
-    case 200: \
-    case 201: \
-    case 202: \
-    case 203: \
-    case 204: \
-    case 205: \
-    case 206: \
-    case 207: \
-    case 208: \
     case 209: \
     case 210: \
     case 211: \
@@ -0,0 +1,72 @@
+#ifndef Py_INTERNAL_OPTIMIZER_H
+#define Py_INTERNAL_OPTIMIZER_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+#include "pycore_frame.h"         // _PyInterpreterFrame
+
+/* Loop optimizer: hot loops closed by a JUMP_BACKWARD are projected into a
+ * trace of micro-ops, optimized as a whole and run by an executor.
+ * See Python/optimizer.c. */
+
+typedef struct {
+    uint8_t opcode;
+    uint8_t type;       /* Type checked by guards, or where the operands of
+                           other uops come from (see Python/optimizer.c) */
+    uint16_t oparg;
+    uint16_t left;      /* Index of the local or constant used as operand, */
+    uint16_t right;     /* unless the operand is taken from the stack */
+    int32_t target;     /* Offset of the instruction this uop belongs to */
+    int32_t exit;       /* Offset to resume at when the uop leaves the trace,
+                           or index of the uop a branch jumps to */
+} _PyUOpInstruction;
+
+typedef struct {
+    int backedge;       /* Offset of the JUMP_BACKWARD owning the executor */
+    int deopts_left;    /* Guard failures tolerated before giving up */
+    int body;           /* Index of the first uop after the preamble */
+    int length;
+    void *jit_code;     /* Machine code for the trace, or NULL */
+    size_t jit_size;
+    _PyUOpInstruction trace[1];
+} _PyExecutor;
+
+struct _PyExecutorArray {
+    int size;
+    _PyExecutor *executors[1];
+};
+
+/* Guard failures after which an executor is discarded. */
+#define EXECUTOR_DEOPT_LIMIT 64
+
+extern void _PyOptimizer_BackEdge(_PyInterpreterFrame *frame,
+                                  _Py_CODEUNIT *backedge, int oparg,
+                                  PyObject **stack_pointer);
+extern int _PyExecutor_Execute(_PyExecutor *executor,
+                               _PyInterpreterFrame *frame,
+                               PyObject **stack_pointer);
+extern void _PyCode_InvalidateExecutors(PyCodeObject *code);
+extern void _PyCode_ClearExecutors(PyCodeObject *code);
+
+static inline _PyExecutor *
+_PyCode_GetExecutor(PyCodeObject *code, int backedge)
+{
+    struct _PyExecutorArray *array = code->_co_executors;
+    assert(array != NULL);
+    for (int i = 0; i < array->size; i++) {
+        if (array->executors[i]->backedge == backedge) {
+            return array->executors[i];
+        }
+    }
+    Py_UNREACHABLE();
+}
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !Py_INTERNAL_OPTIMIZER_H */
@@ -99,9 +99,77 @@ PyAPI_DATA(struct _PyTraceMalloc_Config) _Py_tracemalloc_config;
 void *_PyObject_VirtualAlloc(size_t size);
 void _PyObject_VirtualFree(void *, size_t size);
 
+/* Small blocks freed by an interpreter and kept for its next allocations of
+   the same size class, in front of the pools shared by all interpreters (see
+   Objects/obmalloc.c).  Each list is linked through the first word of the
+   blocks.  A limit of 0 disables the bin. */
+#define _PyMem_CACHE_BINS 64
+
+struct _Py_obmalloc_cache {
+    struct {
+        void *head;
+        int count;
+        int limit;
+    } bins[_PyMem_CACHE_BINS];
+};
+
+extern void _PyMem_InitCache(struct _Py_obmalloc_cache *cache);
+/* Disable the cache and give its blocks back to their pools */
+extern void _PyMem_ClearCache(struct _Py_obmalloc_cache *cache);
+
+/* Upper bound of the number of size classes of the small object allocator */
+#define _PyObject_MAX_SIZE_CLASSES 64
+
+/* Counters of the small object allocator, see sys._get_malloc_stats() */
+struct _PyObject_MallocStats {
+    size_t arenas_allocated;
+    size_t arenas_allocated_total;
+    size_t arenas_highwater;
+    size_t arenas_hugepages;
+    /* free pools whose pages are given back to the system */
+    size_t pools_released;
+    size_t pools_released_total;
+    size_t release_passes;
+    size_t bytes_released;
+
+    size_t arena_size;
+    size_t pool_size;
+    size_t pools_free;          /* including those not carved yet */
+    size_t bytes_allocated;     /* in blocks in use */
+    size_t bytes_available;     /* in free blocks of used pools */
+    size_t bytes_cached;        /* in the caches of the interpreters */
+    size_t bytes_pool_headers;
+    size_t bytes_quantization;
+    size_t bytes_arena_alignment;
+    size_t bytes_arena_map;     /* memory of the radix tree */
+    size_t arena_map_mid_nodes;
+    size_t arena_map_bot_nodes;
+    /* Size classes in use; blocks counts the cached blocks as in use */
+    size_t nsize_classes;
+    struct {
+        size_t block_size;
+        size_t pools;
+        size_t blocks;
+        size_t free_blocks;
+    } size_classes[_PyObject_MAX_SIZE_CLASSES];
+};
+
+/* Fill stats, return 0 if pymalloc is not used.  This visits the header of
+   every pool, but no block. */
+extern int _PyObject_GetMallocStats(struct _PyObject_MallocStats *stats);
+
+/* Give the pages of the free pools of pymalloc back to the system */
+extern Py_ssize_t _PyObject_ReleaseFreePools(void);
+
+extern void _PyObject_SetArenaHugePages(int enable);
+
 /* This function returns the number of allocated memory blocks, regardless of size */
 PyAPI_FUNC(Py_ssize_t) _Py_GetAllocatedBlocks(void);
 
+/* Make new small blocks come from pools not used so far, see gc.freeze().
+   Returns the number of pools which are no longer allocated from. */
+extern Py_ssize_t _PyObject_RetireUsedPools(void);
+
 /* Macros */
 #ifdef WITH_PYMALLOC
 // Export the symbol for the 3rd party guppy3 project
@@ -53,28 +53,45 @@ _Py_ThreadCanHandleSignals(PyInterpreterState *interp)
 }
 
 
-/* Only execute pending calls on the main thread. */
+/* Only execute the pending calls of the main interpreter on the main thread.
+   Subinterpreters with their own GIL usually run in other threads. */
 static inline int
-_Py_ThreadCanHandlePendingCalls(void)
+_Py_ThreadCanHandlePendingCalls(PyInterpreterState *interp)
 {
-    return _Py_IsMainThread();
+    return (_Py_IsMainThread() || !_Py_IsMainInterpreter(interp));
 }
 
 
 /* Variable and macro for in-line access to current thread
    and interpreter state */
 
+#ifdef HAVE_THREAD_LOCAL
+/* Current thread state of the thread, defined in Python/pystate.c.  Shared
+   extension modules cannot access it on all platforms, they call
+   _PyThreadState_UncheckedGet() instead. */
+extern _Py_thread_local PyThreadState *_Py_tss_tstate;
+#endif
+
 static inline PyThreadState*
 _PyRuntimeState_GetThreadState(_PyRuntimeState *runtime)
 {
+#if defined(HAVE_THREAD_LOCAL) && !defined(Py_BUILD_CORE_MODULE)
+    (void)runtime;
+    return _Py_tss_tstate;
+#elif defined(HAVE_THREAD_LOCAL)
+    (void)runtime;
+    return _PyThreadState_UncheckedGet();
+#else
     return (PyThreadState*)_Py_atomic_load_relaxed(&runtime->gilstate.tstate_current);
+#endif
 }
 
 /* Get the current Python thread state.
 
-   Efficient macro reading directly the 'gilstate.tstate_current' atomic
-   variable. The macro is unsafe: it does not check for error and it can
-   return NULL.
+   Efficient macro reading directly the thread-local variable of the
+   current thread state, or the 'gilstate.tstate_current' atomic variable
+   if the compiler has no thread-local storage.  The macro is unsafe: it
+   does not check for error and it can return NULL.
 
    The caller must hold the GIL.
 
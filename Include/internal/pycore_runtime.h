@@ -9,7 +9,6 @@ extern "C" {
 #endif
 
 #include "pycore_atomic.h"          /* _Py_atomic_address */
-#include "pycore_gil.h"             // struct _gil_runtime_state
 #include "pycore_global_objects.h"  // struct _Py_global_objects
 #include "pycore_interp.h"          // PyInterpreterState
 #include "pycore_unicodeobject.h"   // struct _Py_unicode_runtime_ids
@@ -23,7 +22,10 @@ struct _ceval_runtime_state {
        the main thread of the main interpreter can handle signals: see
        _Py_ThreadCanHandleSignals(). */
     _Py_atomic_int signals_pending;
-    struct _gil_runtime_state gil;
+    /* Set once a subinterpreter got a GIL of its own (see _PyEval_InitGIL()).
+       From then on several threads can run Python code at once, and the
+       state shared by the interpreters is protected by shared_locks. */
+    int own_gils;
 };
 
 /* GIL state */
@@ -33,7 +35,8 @@ struct _gilstate_runtime_state {
        If set to non-zero, PyGILState_Check() always return 1. */
     int check_enabled;
     /* Assuming the current thread holds the GIL, this is the
-       PyThreadState for the current thread. */
+       PyThreadState for the current thread.  Only used if the compiler has
+       no thread-local storage (see _PyThreadState_GET()). */
     _Py_atomic_address tstate_current;
     /* The single PyInterpreterState used by this process'
        GILState implementation
@@ -125,6 +128,15 @@ typedef struct pyruntimestate {
 
     struct _Py_unicode_runtime_ids unicode_ids;
 
+    /* Locks of the state shared by the interpreters, allocated and used
+       once ceval.own_gils is set. */
+    struct _Py_shared_locks {
+        /* pymalloc pools and arenas */
+        PyThread_type_lock obmalloc;
+        /* interned strings and subclasses of static types */
+        PyThread_type_lock objects;
+    } shared_locks;
+
     /* All the objects that are shared by the runtime's interpreters. */
     struct _Py_global_objects global_objects;
 
@@ -151,6 +163,28 @@ typedef struct pyruntimestate {
 
 PyAPI_DATA(_PyRuntimeState) _PyRuntime;
 
+/* Take the lock of the objects shared by the interpreters
+   (shared_locks.objects) if subinterpreters can run under their own GIL.
+   Return whether it was taken, to pass to _PyRuntimeState_UnlockObjects().
+   The lock must not be held while running Python code. */
+static inline int
+_PyRuntimeState_LockObjects(_PyRuntimeState *runtime)
+{
+    if (runtime->ceval.own_gils) {
+        PyThread_acquire_lock(runtime->shared_locks.objects, WAIT_LOCK);
+        return 1;
+    }
+    return 0;
+}
+
+static inline void
+_PyRuntimeState_UnlockObjects(_PyRuntimeState *runtime, int locked)
+{
+    if (locked) {
+        PyThread_release_lock(runtime->shared_locks.objects);
+    }
+}
+
 PyAPI_FUNC(PyStatus) _PyRuntimeState_Init(_PyRuntimeState *runtime);
 PyAPI_FUNC(void) _PyRuntimeState_Fini(_PyRuntimeState *runtime);
 
@@ -158,6 +192,15 @@ PyAPI_FUNC(void) _PyRuntimeState_Fini(_PyRuntimeState *runtime);
 extern PyStatus _PyRuntimeState_ReInitThreads(_PyRuntimeState *runtime);
 #endif
 
+/* Allocate the shared locks, pin the shared objects and set
+   ceval.own_gils: called before the first subinterpreter gets its own GIL,
+   while the caller holds the GIL of the main interpreter. */
+extern PyStatus _PyRuntimeState_EnableOwnGILs(_PyRuntimeState *runtime);
+
+/* Unpin the shared objects and reset ceval.own_gils: called when the main
+   interpreter is finalized, once no other interpreter runs. */
+extern void _PyRuntimeState_DisableOwnGILs(_PyRuntimeState *runtime);
+
 /* Initialize _PyRuntimeState.
    Return NULL on success, or return an error message on failure. */
 PyAPI_FUNC(PyStatus) _PyRuntime_Initialize(void);
@@ -9,6 +9,7 @@ extern "C" {
 #endif
 
 #include "tupleobject.h"   /* _PyTuple_CAST() */
+#include "pycore_freelist.h"      // struct _Py_freelist_info
 
 
 /* runtime lifecycle */
@@ -57,6 +58,8 @@ struct _Py_tuple_state {
        Each linked list is initially NULL. */
     PyTupleObject *free_list[PyTuple_NFREELISTS];
     int numfree[PyTuple_NFREELISTS];
+    /* Shared by all the sizes; the limit applies to each size */
+    struct _Py_freelist_info info;
 #else
     char _unused;  // Empty structs are not allowed.
 #endif
@@ -67,6 +70,13 @@ struct _Py_tuple_state {
 extern PyObject *_PyTuple_FromArray(PyObject *const *, Py_ssize_t);
 extern PyObject *_PyTuple_FromArraySteal(PyObject *const *, Py_ssize_t);
 
+
+typedef struct {
+    PyObject_HEAD
+    Py_ssize_t it_index;
+    PyTupleObject *it_seq; /* Set to NULL when iterator is exhausted */
+} _PyTupleIterObject;
+
 #ifdef __cplusplus
 }
 #endif
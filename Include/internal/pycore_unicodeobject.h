@@ -54,6 +54,7 @@ struct _Py_unicode_state {
 };
 
 extern void _PyUnicode_ClearInterned(PyInterpreterState *interp);
+extern void _PyUnicode_SetInternedPinned(int pinned);
 
 
 #ifdef __cplusplus
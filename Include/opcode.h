@@ -123,72 +123,101 @@ extern "C" {
 #define BINARY_OP_ADD_FLOAT                      4
 #define BINARY_OP_ADD_INT                        5
 #define BINARY_OP_ADD_UNICODE                    6
-#define BINARY_OP_INPLACE_ADD_UNICODE            7
-#define BINARY_OP_MULTIPLY_FLOAT                 8
-#define BINARY_OP_MULTIPLY_INT                  13
-#define BINARY_OP_SUBTRACT_FLOAT                14
-#define BINARY_OP_SUBTRACT_INT                  16
-#define BINARY_SUBSCR_ADAPTIVE                  17
-#define BINARY_SUBSCR_DICT                      18
-#define BINARY_SUBSCR_GETITEM                   19
-#define BINARY_SUBSCR_LIST_INT                  20
-#define BINARY_SUBSCR_TUPLE_INT                 21
-#define CALL_ADAPTIVE                           22
-#define CALL_PY_EXACT_ARGS                      23
-#define CALL_PY_WITH_DEFAULTS                   24
-#define CALL_BOUND_METHOD_EXACT_ARGS            26
-#define CALL_BUILTIN_CLASS                      27
-#define CALL_BUILTIN_FAST_WITH_KEYWORDS         28
-#define CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS  29
-#define CALL_NO_KW_BUILTIN_FAST                 34
-#define CALL_NO_KW_BUILTIN_O                    38
-#define CALL_NO_KW_ISINSTANCE                   39
-#define CALL_NO_KW_LEN                          40
-#define CALL_NO_KW_LIST_APPEND                  41
-#define CALL_NO_KW_METHOD_DESCRIPTOR_FAST       42
-#define CALL_NO_KW_METHOD_DESCRIPTOR_NOARGS     43
-#define CALL_NO_KW_METHOD_DESCRIPTOR_O          44
-#define CALL_NO_KW_STR_1                        45
-#define CALL_NO_KW_TUPLE_1                      46
-#define CALL_NO_KW_TYPE_1                       47
-#define COMPARE_OP_ADAPTIVE                     48
-#define COMPARE_OP_FLOAT_JUMP                   55
-#define COMPARE_OP_INT_JUMP                     56
-#define COMPARE_OP_STR_JUMP                     57
-#define EXTENDED_ARG_QUICK                      58
-#define JUMP_BACKWARD_QUICK                     59
-#define LOAD_ATTR_ADAPTIVE                      62
-#define LOAD_ATTR_INSTANCE_VALUE                63
-#define LOAD_ATTR_MODULE                        64
-#define LOAD_ATTR_SLOT                          65
-#define LOAD_ATTR_WITH_HINT                     66
-#define LOAD_CONST__LOAD_FAST                   67
-#define LOAD_FAST__LOAD_CONST                   72
-#define LOAD_FAST__LOAD_FAST                    73
-#define LOAD_GLOBAL_ADAPTIVE                    76
-#define LOAD_GLOBAL_BUILTIN                     77
-#define LOAD_GLOBAL_MODULE                      78
-#define LOAD_METHOD_ADAPTIVE                    79
-#define LOAD_METHOD_CLASS                       80
-#define LOAD_METHOD_LAZY_DICT                   81
-#define LOAD_METHOD_MODULE                      86
-#define LOAD_METHOD_NO_DICT                    113
-#define LOAD_METHOD_WITH_DICT                  121
-#define LOAD_METHOD_WITH_VALUES                141
-#define RESUME_QUICK                           143
-#define STORE_ATTR_ADAPTIVE                    153
-#define STORE_ATTR_INSTANCE_VALUE              154
-#define STORE_ATTR_SLOT                        158
-#define STORE_ATTR_WITH_HINT                   159
-#define STORE_FAST__LOAD_FAST                  161
-#define STORE_FAST__STORE_FAST                 166
-#define STORE_SUBSCR_ADAPTIVE                  167
-#define STORE_SUBSCR_DICT                      168
-#define STORE_SUBSCR_LIST_INT                  169
-#define UNPACK_SEQUENCE_ADAPTIVE               170
-#define UNPACK_SEQUENCE_LIST                   177
-#define UNPACK_SEQUENCE_TUPLE                  178
-#define UNPACK_SEQUENCE_TWO_TUPLE              179
+#define BINARY_OP_AND_INT                        7
+#define BINARY_OP_FLOOR_DIVIDE_INT               8
+#define BINARY_OP_INPLACE_ADD_UNICODE           13
+#define BINARY_OP_LSHIFT_INT                    14
+#define BINARY_OP_MIXED_INT_FLOAT               16
+#define BINARY_OP_MULTIPLY_FLOAT                17
+#define BINARY_OP_MULTIPLY_INT                  18
+#define BINARY_OP_OR_INT                        19
+#define BINARY_OP_REMAINDER_INT                 20
+#define BINARY_OP_RSHIFT_INT                    21
+#define BINARY_OP_SUBTRACT_FLOAT                22
+#define BINARY_OP_SUBTRACT_INT                  23
+#define BINARY_OP_XOR_INT                       24
+#define BINARY_SUBSCR_ADAPTIVE                  26
+#define BINARY_SUBSCR_DICT                      27
+#define BINARY_SUBSCR_GETITEM                   28
+#define BINARY_SUBSCR_LIST_INT                  29
+#define BINARY_SUBSCR_TUPLE_INT                 34
+#define CALL_ADAPTIVE                           38
+#define CALL_ALLOC_AND_ENTER_INIT               39
+#define CALL_PY_EXACT_ARGS                      40
+#define CALL_PY_WITH_DEFAULTS                   41
+#define CALL_BOUND_METHOD_EXACT_ARGS            42
+#define CALL_BUILTIN_CLASS                      43
+#define CALL_BUILTIN_FAST_WITH_KEYWORDS         44
+#define CALL_METHOD_DESCRIPTOR_FAST_WITH_KEYWORDS  45
+#define CALL_NO_KW_BUILTIN_FAST                 46
+#define CALL_NO_KW_BUILTIN_O                    47
+#define CALL_NO_KW_ISINSTANCE                   48
+#define CALL_NO_KW_LEN                          55
+#define CALL_NO_KW_LIST_APPEND                  56
+#define CALL_NO_KW_METHOD_DESCRIPTOR_FAST       57
+#define CALL_NO_KW_METHOD_DESCRIPTOR_NOARGS     58
+#define CALL_NO_KW_METHOD_DESCRIPTOR_O          59
+#define CALL_NO_KW_STR_1                        62
+#define CALL_NO_KW_TUPLE_1                      63
+#define CALL_NO_KW_TYPE_1                       64
+#define COMPARE_OP_ADAPTIVE                     65
+#define COMPARE_OP_FLOAT_JUMP                   66
+#define COMPARE_OP_INT_JUMP                     67
+#define COMPARE_OP_STR_JUMP                     72
+#define CONTAINS_OP_ADAPTIVE                    73
+#define CONTAINS_OP_DICT                        76
+#define CONTAINS_OP_SET                         77
+#define CONTAINS_OP_STR                         78
+#define CONTAINS_OP_TUPLE                       79
+#define EXTENDED_ARG_QUICK                      80
+#define FOR_ITER_ADAPTIVE                       81
+#define FOR_ITER_GEN                            86
+#define FOR_ITER_LIST                          113
+#define FOR_ITER_RANGE                         121
+#define FOR_ITER_TUPLE                         141
+#define JUMP_BACKWARD_EXECUTOR                 143
+#define JUMP_BACKWARD_QUICK                    153
+#define LOAD_ATTR_ADAPTIVE                     154
+#define LOAD_ATTR_CLASS                        158
+#define LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN      159
+#define LOAD_ATTR_INSTANCE_VALUE               161
+#define LOAD_ATTR_METACLASS                    166
+#define LOAD_ATTR_MODULE                       167
+#define LOAD_ATTR_PROPERTY                     168
+#define LOAD_ATTR_SLOT                         169
+#define LOAD_ATTR_WITH_HINT                    170
+#define LOAD_GLOBAL_ADAPTIVE                   177
+#define LOAD_GLOBAL_BUILTIN                    178
+#define LOAD_GLOBAL_MODULE                     179
+#define LOAD_METHOD_ADAPTIVE                   180
+#define LOAD_METHOD_CLASS                      181
+#define LOAD_METHOD_LAZY_DICT                  182
+#define LOAD_METHOD_MODULE                     183
+#define LOAD_METHOD_NO_DICT                    184
+#define LOAD_METHOD_WITH_DICT                  185
+#define LOAD_METHOD_WITH_VALUES                186
+#define RESUME_QUICK                           187
+#define SEND_ADAPTIVE                          188
+#define SEND_GEN                               189
+#define STORE_ATTR_ADAPTIVE                    190
+#define STORE_ATTR_INSTANCE_VALUE              191
+#define STORE_ATTR_SLOT                        192
+#define STORE_ATTR_WITH_HINT                   193
+#define STORE_SUBSCR_ADAPTIVE                  194
+#define STORE_SUBSCR_DICT                      195
+#define STORE_SUBSCR_LIST_INT                  196
+#define UNPACK_SEQUENCE_ADAPTIVE               197
+#define UNPACK_SEQUENCE_LIST                   198
+#define UNPACK_SEQUENCE_TUPLE                  199
+#define UNPACK_SEQUENCE_TWO_TUPLE              200
+#define LOAD_CONST__LOAD_FAST                  201
+#define LOAD_CONST__STORE_FAST                 202
+#define LOAD_FAST__LOAD_CONST                  203
+#define LOAD_FAST__LOAD_FAST                   204
+#define LOAD_FAST__POP_TOP                     205
+#define LOAD_FAST__STORE_FAST                  206
+#define STORE_FAST__LOAD_FAST                  207
+#define STORE_FAST__STORE_FAST                 208
 #define DO_TRACING                             255
 
 #define HAS_CONST(op) (false\
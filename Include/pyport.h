@@ -762,4 +762,26 @@ extern char * _getpty(int *, int, mode_t, int);
 #  endif
 #endif
 
+
+/* Storage class of the variables of the core which have one value per
+   thread, like the current thread state.  HAVE_THREAD_LOCAL is not defined
+   if the compiler doesn't support one. */
+#ifdef Py_BUILD_CORE
+#  ifdef HAVE_THREAD_LOCAL
+#    error "HAVE_THREAD_LOCAL is already defined"
+#  endif
+#  define HAVE_THREAD_LOCAL 1
+#  ifdef thread_local
+#    define _Py_thread_local thread_local
+#  elif __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+#    define _Py_thread_local _Thread_local
+#  elif defined(_MSC_VER)
+#    define _Py_thread_local __declspec(thread)
+#  elif defined(__GNUC__)
+#    define _Py_thread_local __thread
+#  else
+#    undef HAVE_THREAD_LOCAL
+#  endif
+#endif
+
 #endif /* Py_PYPORT_H */
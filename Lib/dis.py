@@ -471,6 +471,7 @@ def _get_instructions_bytes(code, varname_from_oparg=None,
             elif deop in hasjrel:
                 signed_arg = -arg if _is_backward_jump(deop) else arg
                 argval = offset + 2 + signed_arg*2
+                argval += 2 * _inline_cache_entries[deop]
                 argrepr = "to " + repr(argval)
             elif deop in haslocal or deop in hasfree:
                 argval, argrepr = _get_name_info(arg, varname_from_oparg)
@@ -612,11 +613,13 @@ def findlabels(code):
     labels = []
     for offset, op, arg in _unpack_opargs(code):
         if arg is not None:
-            if op in hasjrel:
-                if _is_backward_jump(op):
+            deop = _deoptop(op)
+            if deop in hasjrel:
+                if _is_backward_jump(deop):
                     arg = -arg
                 label = offset + 2 + arg*2
-            elif op in hasjabs:
+                label += 2 * _inline_cache_entries[deop]
+            elif deop in hasjabs:
                 label = arg*2
             else:
                 continue
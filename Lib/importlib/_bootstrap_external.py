@@ -408,6 +408,12 @@ def _write_atomic(path, data, mode=0o666):
 #     Python 3.12a1 3501 (YIELD_VALUE oparg == stack_depth)
 #     Python 3.12a1 3502 (LOAD_FAST_CHECK, no NULL-check in LOAD_FAST)
 #     Python 3.12a1 3503 (Shrink LOAD_METHOD cache)
+#     Python 3.12a1 3504 (Add inline cache to FOR_ITER)
+#     Python 3.12a1 3505 (Widen LOAD_ATTR cache to hold a descriptor)
+#     Python 3.12a1 3506 (Add CALL_ALLOC_AND_ENTER_INIT, renumbering EXTENDED_ARG_QUICK)
+#     Python 3.12a1 3507 (Add inline cache to SEND)
+#     Python 3.12a1 3508 (Add inline cache to CONTAINS_OP)
+#     Python 3.12a1 3509 (Add BINARY_OP specializations, renumbering quickened opcodes)
 
 #     Python 3.13 will start with 3550
 
@@ -421,7 +427,7 @@ def _write_atomic(path, data, mode=0o666):
 # Whenever MAGIC_NUMBER is changed, the ranges in the magic_values array
 # in PC/launcher.c must also be updated.
 
-MAGIC_NUMBER = (3503).to_bytes(2, 'little') + b'\r\n'
+MAGIC_NUMBER = (3509).to_bytes(2, 'little') + b'\r\n'
 
 _RAW_MAGIC_NUMBER = int.from_bytes(MAGIC_NUMBER, 'little')  # For import.c
 
@@ -238,11 +238,19 @@ def jabs_op(name, op):
         "BINARY_OP_ADD_FLOAT",
         "BINARY_OP_ADD_INT",
         "BINARY_OP_ADD_UNICODE",
+        "BINARY_OP_AND_INT",
+        "BINARY_OP_FLOOR_DIVIDE_INT",
         "BINARY_OP_INPLACE_ADD_UNICODE",
+        "BINARY_OP_LSHIFT_INT",
+        "BINARY_OP_MIXED_INT_FLOAT",
         "BINARY_OP_MULTIPLY_FLOAT",
         "BINARY_OP_MULTIPLY_INT",
+        "BINARY_OP_OR_INT",
+        "BINARY_OP_REMAINDER_INT",
+        "BINARY_OP_RSHIFT_INT",
         "BINARY_OP_SUBTRACT_FLOAT",
         "BINARY_OP_SUBTRACT_INT",
+        "BINARY_OP_XOR_INT",
     ],
     "BINARY_SUBSCR": [
         "BINARY_SUBSCR_ADAPTIVE",
@@ -253,6 +261,7 @@ def jabs_op(name, op):
     ],
     "CALL": [
         "CALL_ADAPTIVE",
+        "CALL_ALLOC_AND_ENTER_INIT",
         "CALL_PY_EXACT_ARGS",
         "CALL_PY_WITH_DEFAULTS",
         "CALL_BOUND_METHOD_EXACT_ARGS",
@@ -277,26 +286,38 @@ def jabs_op(name, op):
         "COMPARE_OP_INT_JUMP",
         "COMPARE_OP_STR_JUMP",
     ],
+    "CONTAINS_OP": [
+        "CONTAINS_OP_ADAPTIVE",
+        "CONTAINS_OP_DICT",
+        "CONTAINS_OP_SET",
+        "CONTAINS_OP_STR",
+        "CONTAINS_OP_TUPLE",
+    ],
     "EXTENDED_ARG": [
         "EXTENDED_ARG_QUICK",
     ],
+    "FOR_ITER": [
+        "FOR_ITER_ADAPTIVE",
+        "FOR_ITER_GEN",
+        "FOR_ITER_LIST",
+        "FOR_ITER_RANGE",
+        "FOR_ITER_TUPLE",
+    ],
     "JUMP_BACKWARD": [
+        "JUMP_BACKWARD_EXECUTOR",
         "JUMP_BACKWARD_QUICK",
     ],
     "LOAD_ATTR": [
         "LOAD_ATTR_ADAPTIVE",
+        "LOAD_ATTR_CLASS",
+        "LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN",
         "LOAD_ATTR_INSTANCE_VALUE",
+        "LOAD_ATTR_METACLASS",
         "LOAD_ATTR_MODULE",
+        "LOAD_ATTR_PROPERTY",
         "LOAD_ATTR_SLOT",
         "LOAD_ATTR_WITH_HINT",
     ],
-    "LOAD_CONST": [
-        "LOAD_CONST__LOAD_FAST",
-    ],
-    "LOAD_FAST": [
-        "LOAD_FAST__LOAD_CONST",
-        "LOAD_FAST__LOAD_FAST",
-    ],
     "LOAD_GLOBAL": [
         "LOAD_GLOBAL_ADAPTIVE",
         "LOAD_GLOBAL_BUILTIN",
@@ -314,16 +335,16 @@ def jabs_op(name, op):
     "RESUME": [
         "RESUME_QUICK",
     ],
+    "SEND": [
+        "SEND_ADAPTIVE",
+        "SEND_GEN",
+    ],
     "STORE_ATTR": [
         "STORE_ATTR_ADAPTIVE",
         "STORE_ATTR_INSTANCE_VALUE",
         "STORE_ATTR_SLOT",
         "STORE_ATTR_WITH_HINT",
     ],
-    "STORE_FAST": [
-        "STORE_FAST__LOAD_FAST",
-        "STORE_FAST__STORE_FAST",
-    ],
     "STORE_SUBSCR": [
         "STORE_SUBSCR_ADAPTIVE",
         "STORE_SUBSCR_DICT",
@@ -336,6 +357,23 @@ def jabs_op(name, op):
         "UNPACK_SEQUENCE_TWO_TUPLE",
     ],
 }
+
+# Pairs of instructions fused into a single superinstruction, named
+# "FIRST__SECOND".  Maintained by Tools/scripts/generate_superinstructions.py
+# from profiled pair counts; run it after editing this list by hand.
+_superinstructions = [
+    ('LOAD_CONST', 'LOAD_FAST'),
+    ('LOAD_CONST', 'STORE_FAST'),
+    ('LOAD_FAST', 'LOAD_CONST'),
+    ('LOAD_FAST', 'LOAD_FAST'),
+    ('LOAD_FAST', 'POP_TOP'),
+    ('LOAD_FAST', 'STORE_FAST'),
+    ('STORE_FAST', 'LOAD_FAST'),
+    ('STORE_FAST', 'STORE_FAST'),
+]
+for _first, _second in _superinstructions:
+    _specializations.setdefault(_first, []).append(f"{_first}__{_second}")
+
 _specialized_instructions = [
     opcode for family in _specializations.values() for opcode in family
 ]
@@ -373,7 +411,8 @@ def jabs_op(name, op):
     "LOAD_ATTR": {
         "counter": 1,
         "version": 2,
-        "index": 1,
+        "keys_version": 2,
+        "descr": 4,
     },
     "STORE_ATTR": {
         "counter": 1,
@@ -394,6 +433,15 @@ def jabs_op(name, op):
     "STORE_SUBSCR": {
         "counter": 1,
     },
+    "FOR_ITER": {
+        "counter": 1,
+    },
+    "SEND": {
+        "counter": 1,
+    },
+    "CONTAINS_OP": {
+        "counter": 1,
+    },
 }
 
 _inline_cache_entries = [
@@ -66,6 +66,7 @@ def test_set_invalid(self):
             'show_ref_count',
             'dump_refs',
             'malloc_stats',
+            'malloc_hugepages',
             'parse_argv',
             'site_import',
             'bytes_warning',
@@ -106,6 +107,7 @@ def test_set_invalid(self):
             # 'pythonpath_env'
             # 'home'
             # 'pycache_prefix'
+            # 'freelist_limits'
             # 'run_command'
             # 'run_module'
             # 'run_filename'
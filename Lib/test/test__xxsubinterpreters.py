@@ -1068,6 +1068,85 @@ def f():
         self.assertEqual(retcode, 0)
 
 
+class OwnGILTests(TestBase):
+
+    # Isolated subinterpreters run under their own GIL.
+
+    def run_in_threads(self, ids, script):
+        results = {}
+        def run(id):
+            results[id] = _run_output(id, script)
+        threads = [threading.Thread(target=run, args=(id,)) for id in ids]
+        for t in threads:
+            t.start()
+        for t in threads:
+            t.join()
+        return [results[id] for id in ids]
+
+    def test_run_in_parallel(self):
+        ids = [interpreters.create() for _ in range(4)]
+        # Also create classes and intern strings: the subclasses of the
+        # static types and the interned strings are shared.
+        script = dedent("""
+            import sys
+            total = 0
+            for i in range(20_000):
+                total += i * i
+            for i in range(200):
+                cls = type(f'C{i}', (object,), {'x': sys.intern(f'attr{i}')})
+                assert cls().x == f'attr{i}'
+            print(total)
+            """)
+        expected = str(sum(i * i for i in range(20_000)))
+        for _ in range(3):
+            outputs = self.run_in_threads(ids, script)
+            self.assertEqual([out.strip() for out in outputs],
+                             [expected] * len(ids))
+
+    def test_run_while_main_runs(self):
+        id = interpreters.create()
+        done = threading.Event()
+        def run():
+            _run_output(id, dedent("""
+                total = 0
+                for i in range(50_000):
+                    total += i
+                print(total)
+                """))
+            done.set()
+        t = threading.Thread(target=run)
+        t.start()
+        # The main interpreter keeps running Python code meanwhile
+        count = 0
+        while not done.is_set():
+            count += 1
+        t.join()
+        self.assertGreater(count, 0)
+
+    def test_switch_interval(self):
+        id = interpreters.create()
+        interval = sys.getswitchinterval()
+        out = _run_output(id, dedent("""
+            import sys
+            sys.setswitchinterval(0.5)
+            print(sys.getswitchinterval())
+            """))
+        self.assertEqual(float(out), 0.5)
+        self.assertEqual(sys.getswitchinterval(), interval)
+
+    def test_not_isolated_shares_gil(self):
+        id = interpreters.create(isolated=False)
+        interval = sys.getswitchinterval()
+        try:
+            _run_output(id, dedent("""
+                import sys
+                sys.setswitchinterval(0.5)
+                """))
+            self.assertEqual(sys.getswitchinterval(), 0.5)
+        finally:
+            sys.setswitchinterval(interval)
+
+
 ##################################
 # channel tests
 
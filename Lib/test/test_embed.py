@@ -440,9 +440,12 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
         'tracemalloc': 0,
         'import_time': 0,
         'code_debug_ranges': 1,
+        'jit': 0,
         'show_ref_count': 0,
         'dump_refs': 0,
         'malloc_stats': 0,
+        'malloc_hugepages': 0,
+        'freelist_limits': None,
 
         'filesystem_encoding': GET_DEFAULT_CONFIG,
         'filesystem_errors': GET_DEFAULT_CONFIG,
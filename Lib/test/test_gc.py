@@ -8,6 +8,7 @@
 from test.support import threading_helper
 
 import gc
+import heapq
 import sys
 import sysconfig
 import textwrap
@@ -648,12 +649,48 @@ class UserIntSlots(int):
         self.assertTrue(gc.is_tracked(UserClass))
         self.assertTrue(gc.is_tracked(UserClass()))
         self.assertTrue(gc.is_tracked(UserInt()))
-        self.assertTrue(gc.is_tracked([]))
+        self.assertTrue(gc.is_tracked(list()))
+        self.assertTrue(gc.is_tracked([[]]))
         self.assertTrue(gc.is_tracked(set()))
         self.assertTrue(gc.is_tracked(UserClassSlots()))
         self.assertTrue(gc.is_tracked(UserFloatSlots()))
         self.assertTrue(gc.is_tracked(UserIntSlots()))
 
+    def test_list_display_tracking(self):
+        # List displays of atomic items are created untracked, and tracked
+        # again when an item which may be tracked is stored into them.
+        self.assertFalse(gc.is_tracked([]))
+        self.assertFalse(gc.is_tracked([1, "a", (2, 3.0)]))
+        self.assertTrue(gc.is_tracked([1, {}]))
+        self.assertTrue(gc.is_tracked([(1, [])]))
+
+        class A:
+            pass
+
+        def setitem(x):
+            x[0] = x
+        def setslice(x):
+            x[1:] = [x]
+        def setstep(x):
+            x[::2] = [x]
+        def heapreplace(x):
+            del x[1:]
+            heapq.heapreplace(x, x)
+
+        for mutate in (lambda x: x.append(x), lambda x: x.insert(0, x),
+                       lambda x: x.extend([x]), lambda x: x.extend(iter([x])),
+                       setitem, setslice, setstep, heapreplace):
+            x = [1, 2]
+            self.assertFalse(gc.is_tracked(x))
+            mutate(x)
+            self.assertTrue(gc.is_tracked(x))
+            # The cycle through x must be collectable
+            x.append(A())
+            wr = weakref.ref(x[-1])
+            del x
+            gc.collect()
+            self.assertIsNone(wr())
+
     def test_is_finalized(self):
         # Objects not tracked by the always gc return false
         self.assertFalse(gc.is_finalized(3))
@@ -829,11 +866,24 @@ def test_get_stats(self):
         self.assertEqual(len(stats), 3)
         for st in stats:
             self.assertIsInstance(st, dict)
-            self.assertEqual(set(st),
-                             {"collected", "collections", "uncollectable"})
+            self.assertGreaterEqual(set(st),
+                                    {"collected", "collections", "uncollectable",
+                                     "time", "survival", "threshold",
+                                     "threshold_raised", "threshold_lowered"})
             self.assertGreaterEqual(st["collected"], 0)
             self.assertGreaterEqual(st["collections"], 0)
             self.assertGreaterEqual(st["uncollectable"], 0)
+            self.assertGreaterEqual(st["time"], 0)
+            self.assertTrue(0 <= st["survival"] <= 1)
+        self.assertEqual(tuple(st["threshold"] for st in stats),
+                         gc.get_threshold())
+        self.assertGreaterEqual(set(stats[2]),
+                                {"increments", "increment_time",
+                                 "max_increment_time"})
+        self.assertGreaterEqual(stats[2]["increments"], 0)
+        self.assertGreaterEqual(stats[2]["max_increment_time"], 0)
+        self.assertGreaterEqual(stats[2]["increment_time"],
+                                stats[2]["max_increment_time"])
         # Check that collection counts are incremented correctly
         if gc.isenabled():
             self.addCleanup(gc.enable)
@@ -856,6 +906,26 @@ def test_freeze(self):
         gc.unfreeze()
         self.assertEqual(gc.get_freeze_count(), 0)
 
+    @cpython_only
+    @requires_subprocess()
+    def test_freeze_isolate(self):
+        # Objects allocated after freeze(isolate=True) do not fill the holes
+        # left next to the frozen objects.
+        if not import_module("_testcapi").WITH_PYMALLOC:
+            self.skipTest("need pymalloc")
+        code = textwrap.dedent("""
+            import gc
+            old = [bytes(40) for i in range(10000)]
+            del old[::2]
+            gc.freeze(isolate=True)
+            pages = {id(b) // 4096 for b in old}
+            new = [bytes(40) for i in range(10000)]
+            assert not any(id(b) // 4096 in pages for b in new)
+            gc.unfreeze()
+            assert gc.get_freeze_count() == 0
+        """)
+        assert_python_ok("-c", code, PYTHONMALLOC="pymalloc")
+
     def test_get_objects(self):
         gc.collect()
         l = []
@@ -1184,8 +1254,11 @@ def test_collect(self):
         for v in self.visit:
             info = v[2]
             self.assertTrue("generation" in info)
+            self.assertTrue("incremental" in info)
             self.assertTrue("collected" in info)
             self.assertTrue("uncollectable" in info)
+            self.assertTrue("threshold" in info)
+            self.assertTrue("overhead" in info)
 
     def test_collect_generation(self):
         self.preclean()
@@ -1243,7 +1316,7 @@ def test_refcount_errors(self):
         code = textwrap.dedent('''
             from test.support import gc_collect, SuppressCrashReport
 
-            a = [1, 2, 3]
+            a = list((1, 2, 3))
             b = [a]
 
             # Avoid coredump when Py_FatalError() calls abort()
@@ -1430,6 +1503,276 @@ def __del__(self):
             self.assertEqual(x, None)
 
 
+class GCIncrementalTests(unittest.TestCase):
+    def setUp(self):
+        self.enabled = gc.isenabled()
+        self.threshold = gc.get_threshold()
+        self.incremental = gc.get_incremental()
+        gc.disable()
+        gc.set_incremental(0)
+        gc.collect()
+
+    def tearDown(self):
+        gc.set_incremental(self.incremental)
+        gc.set_threshold(*self.threshold)
+        gc.unfreeze()
+        if self.enabled:
+            gc.enable()
+        gc.collect()
+
+    def test_set_incremental(self):
+        self.assertEqual(gc.get_incremental(), 0)
+        gc.set_incremental(500)
+        self.assertEqual(gc.get_incremental(), 500)
+        gc.set_incremental(0)
+        self.assertEqual(gc.get_incremental(), 0)
+        self.assertRaises(ValueError, gc.set_incremental, -1)
+
+    @cpython_only
+    def test_incremental_collection(self):
+        # Garbage cycles in the oldest generation are collected by
+        # increments instead of a full collection.
+        class A:
+            def __init__(self):
+                self.me = self
+        # Keep the other objects out of the way
+        gc.freeze()
+        gc.collect()
+        holder = [A() for i in range(1000)]
+        wrs = [weakref.ref(a) for a in holder]
+        gc.collect(1)  # move them to the oldest generation
+        del holder
+
+        infos = []
+        def callback(phase, info):
+            if phase == "stop":
+                infos.append(info)
+        gc.callbacks.append(callback)
+        self.addCleanup(gc.callbacks.remove, callback)
+        increments = gc.get_stats()[2]["increments"]
+        gc.set_incremental(1000)
+        gc.set_threshold(100, 1, 1)
+        gc.enable()
+        for i in range(100_000):
+            x = []
+            x.append(x)  # not freed until a collection
+            if not any(wr() for wr in wrs[::100]):
+                break
+        gc.disable()
+        self.assertTrue(all(wr() is None for wr in wrs))
+        self.assertGreater(gc.get_stats()[2]["increments"], increments)
+        self.assertFalse(any(info["generation"] == 2
+                             and not info["incremental"] for info in infos))
+        self.assertGreaterEqual(sum(info["collected"] for info in infos
+                                    if info["incremental"]),
+                                len(wrs))
+
+    @cpython_only
+    def test_full_collection_during_pass(self):
+        # Objects waiting for an increment are still in the oldest
+        # generation, and a full collection ends the pass.
+        gc.freeze()
+        gc.collect()
+        objects = [list() for i in range(5000)]
+        gc.collect(1)
+        gc.set_incremental(1000)
+        gc.set_threshold(100, 1, 1)
+        gc.enable()
+        increments = gc.get_stats()[2]["increments"]
+        while gc.get_stats()[2]["increments"] < increments + 2:
+            x = []
+            x.append(x)
+        gc.disable()
+        old = gc.get_objects(generation=2)
+        self.assertTrue(all(any(obj is o for o in old) for obj in objects[::100]))
+        self.assertTrue(all(gc.is_tracked(obj) for obj in objects))
+        gc.collect()
+        self.assertEqual(len(gc.get_objects(generation=2)),
+                         len(gc.get_objects()))
+
+
+class GCAdaptiveTests(unittest.TestCase):
+    def setUp(self):
+        self.enabled = gc.isenabled()
+        self.threshold = gc.get_threshold()
+        self.adaptive = gc.get_adaptive()
+        gc.disable()
+        gc.set_adaptive(0)
+        gc.collect()
+
+    def tearDown(self):
+        gc.set_adaptive(self.adaptive)
+        gc.set_threshold(*self.threshold)
+        if self.enabled:
+            gc.enable()
+        gc.collect()
+
+    def test_set_adaptive(self):
+        self.assertEqual(gc.get_adaptive(), 0.0)
+        gc.set_adaptive(2.5)
+        self.assertEqual(gc.get_adaptive(), 2.5)
+        gc.set_adaptive(0)
+        self.assertEqual(gc.get_adaptive(), 0.0)
+        self.assertRaises(ValueError, gc.set_adaptive, -1)
+        self.assertRaises(ValueError, gc.set_adaptive, 101)
+        self.assertRaises(ValueError, gc.set_adaptive, float("nan"))
+
+    @cpython_only
+    def test_adapted_thresholds(self):
+        # When the collections take more than the target and promote most of
+        # their objects, the threshold is raised; it is lowered back when the
+        # collections find garbage.
+        infos = []
+        def callback(phase, info):
+            if phase == "stop" and info["generation"] == 0:
+                infos.append(info)
+        gc.callbacks.append(callback)
+        self.addCleanup(gc.callbacks.remove, callback)
+        gc.set_threshold(100, 10, 10)
+        gc.set_adaptive(0.001)
+        gc.enable()
+        objects = []
+        for i in range(20000):
+            objects.append([])
+            if gc.get_threshold()[0] > 100:
+                break
+        gc.disable()
+        self.assertGreater(gc.get_threshold()[0], 100)
+        self.assertLessEqual(gc.get_threshold()[0], 6400)
+        self.assertGreater(gc.get_stats()[0]["threshold_raised"], 0)
+        self.assertEqual(infos[-1]["threshold"], gc.get_threshold()[0])
+        self.assertGreater(infos[-1]["overhead"], 0)
+
+        gc.enable()
+        for i in range(100000):
+            x = []
+            x.append(x)
+            if gc.get_threshold()[0] == 100:
+                break
+        gc.disable()
+        self.assertEqual(gc.get_threshold()[0], 100)
+        self.assertGreater(gc.get_stats()[0]["threshold_lowered"], 0)
+
+        gc.set_threshold(200, 10, 10)
+        self.assertEqual(gc.get_threshold(), (200, 10, 10))
+        gc.set_adaptive(0)
+        self.assertEqual(gc.get_threshold(), (200, 10, 10))
+
+
+class GCParallelTests(unittest.TestCase):
+    def setUp(self):
+        self.enabled = gc.isenabled()
+        self.parallel = gc.get_parallel()
+        gc.disable()
+        gc.set_parallel(1)
+
+    def tearDown(self):
+        gc.set_parallel(self.parallel)
+        if self.enabled:
+            gc.enable()
+
+    def test_set_parallel(self):
+        self.assertEqual(gc.get_parallel(), 1)
+        gc.set_parallel(4)
+        self.assertEqual(gc.get_parallel(), 4)
+        gc.set_parallel(1)
+        self.assertEqual(gc.get_parallel(), 1)
+        self.assertRaises(ValueError, gc.set_parallel, 0)
+
+    @threading_helper.requires_working_threading()
+    def test_parallel_collection(self):
+        # A collection large enough to run in parallel finds the same garbage
+        # and keeps the live objects.
+        live = [list() for i in range(100000)]
+        for a, b in zip(live, live[1:]):
+            a.append(b)
+        gc.collect()
+        collected = []
+        for nthreads in (4, 1):
+            gc.set_parallel(nthreads)
+            refs = []
+            for i in range(50000):
+                a = []
+                b = [a]
+                a.append(b)
+                refs.append(weakref.ref(C1055820(i)))
+            del a, b
+            collected.append(gc.collect())
+            self.assertTrue(all(ref() is None for ref in refs))
+            self.assertTrue(all(gc.is_tracked(obj) for obj in live))
+            self.assertTrue(all(a[0] is b for a, b in zip(live, live[1:])))
+        self.assertGreaterEqual(collected[0], 150000)
+        self.assertEqual(collected[0], collected[1])
+
+
+class GCProfileTests(unittest.TestCase):
+    def setUp(self):
+        self.enabled = gc.isenabled()
+        gc.disable()
+        self.infos = []
+        gc.callbacks.append(self.callback)
+
+    def tearDown(self):
+        gc.callbacks.remove(self.callback)
+        gc.set_profile(False)
+        if self.enabled:
+            gc.enable()
+
+    def callback(self, phase, info):
+        if phase == "stop":
+            self.infos.append(info)
+
+    def test_profile(self):
+        class A:
+            def __init__(self):
+                self.loop = self
+        class B:
+            def __del__(self):
+                pass
+        gc.collect()
+        self.assertIsNone(gc.get_profile())
+        self.assertNotIn("profile", self.infos[-1])
+
+        gc.set_profile(True)
+        self.assertIsNone(gc.get_profile())
+        objects = [A() for i in range(100)]
+        b = B()
+        b.loop = b
+        wr = weakref.ref(objects[0])
+        del objects, b
+        gc.collect(1)
+        profile = gc.get_profile()
+        self.assertIs(self.infos[-1]["profile"], profile)
+        self.assertEqual(profile["generation"], 1)
+        self.assertFalse(profile["incremental"])
+        self.assertGreaterEqual(profile["examined"], 101)
+        self.assertGreater(profile["promoted"], 0)
+        self.assertLessEqual(profile["promoted"],
+                             profile["examined"] - self.infos[-1]["collected"])
+        self.assertGreater(profile["time"], 0)
+        self.assertGreater(profile["weakref_time"], 0)
+        self.assertGreater(profile["finalizer_time"], 0)
+        self.assertIsNone(wr())
+        types = profile["types"]
+        self.assertEqual(types[f"{A.__module__}.{A.__qualname__}"]["objects"],
+                         100)
+        self.assertEqual(types[f"{B.__module__}.{B.__qualname__}"]["objects"],
+                         1)
+        self.assertEqual(sum(t["objects"] for t in types.values()),
+                         profile["examined"])
+        self.assertTrue(all(t["traverse_time"] >= 0 for t in types.values()))
+
+        gc.collect()
+        self.assertEqual(gc.get_profile()["generation"], 2)
+        self.assertEqual(gc.get_profile()["promoted"], 0)
+        self.assertIn("list", gc.get_profile()["types"])
+
+        gc.set_profile(False)
+        self.assertIsNone(gc.get_profile())
+        gc.collect()
+        self.assertNotIn("profile", self.infos[-1])
+
+
 class PythonFinalizationTests(unittest.TestCase):
     def test_ast_fini(self):
         # bpo-44184: Regression test for subtype_dealloc() when deallocating
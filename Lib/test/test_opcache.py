@@ -1,4 +1,9 @@
+import dis
+import operator
+import sys
 import unittest
+from test import support
+from test.support import script_helper
 
 class TestLoadAttrCache(unittest.TestCase):
     def test_descriptor_added_after_optimization(self):
@@ -21,3 +26,860 @@ def f(o):
         Descriptor.__set__ = lambda *args: None
 
         self.assertEqual(f(o), 2)
+
+    def test_property_getter_replaced(self):
+        class C:
+            @property
+            def x(self):
+                return 1
+
+        def f(o):
+            return o.x
+
+        o = C()
+        for _ in range(100):
+            self.assertEqual(f(o), 1)
+
+        C.x = property(lambda self: 2)
+        self.assertEqual(f(o), 2)
+        C.x.fget.__code__ = (lambda self: 3).__code__
+        self.assertEqual(f(o), 3)
+        del C.x
+        o.x = 4
+        self.assertEqual(f(o), 4)
+
+    def test_property_getter_raises(self):
+        class C:
+            @property
+            def x(self):
+                raise KeyError("x")
+
+        def f(o):
+            return o.x
+
+        o = C()
+        for _ in range(100):
+            try:
+                f(o)
+            except KeyError as e:
+                tb = e.__traceback__
+            else:
+                self.fail("KeyError not raised")
+            names = []
+            while tb is not None:
+                names.append(tb.tb_frame.f_code.co_name)
+                tb = tb.tb_next
+            self.assertEqual(names[-2:], ["f", "x"])
+
+    def test_class_attribute_modified(self):
+        class C:
+            x = 1
+
+        class D(C):
+            pass
+
+        def f(cls):
+            return cls.x
+
+        for _ in range(100):
+            self.assertEqual(f(D), 1)
+
+        C.x = 2
+        self.assertEqual(f(D), 2)
+        D.x = 3
+        self.assertEqual(f(D), 3)
+        self.assertEqual(f(C), 2)
+
+    def test_metaclass_attribute_modified(self):
+        class Meta(type):
+            x = 1
+
+        class C(metaclass=Meta):
+            pass
+
+        def f(cls):
+            return cls.x
+
+        for _ in range(100):
+            self.assertEqual(f(C), 1)
+
+        Meta.x = 2
+        self.assertEqual(f(C), 2)
+        C.x = 3
+        self.assertEqual(f(C), 3)
+        Meta.x = property(lambda cls: 4)
+        self.assertEqual(f(C), 4)
+
+    def test_metaclass_changed(self):
+        class Meta1(type):
+            x = 1
+
+        class Meta2(type):
+            x = 2
+
+        class C(metaclass=Meta1):
+            pass
+
+        def f(cls):
+            return cls.x
+
+        for _ in range(100):
+            self.assertEqual(f(C), 1)
+
+        C.__class__ = Meta2
+        self.assertEqual(f(C), 2)
+
+    def test_getattribute_overridden(self):
+        class C:
+            def __getattribute__(self, name):
+                return name
+
+        def f(o):
+            return o.spam
+
+        o = C()
+        for _ in range(100):
+            self.assertEqual(f(o), "spam")
+
+        C.__getattribute__ = lambda self, name: name.upper()
+        self.assertEqual(f(o), "SPAM")
+        del C.__getattribute__
+        C.__getattr__ = lambda self, name: name * 2
+        self.assertEqual(f(o), "spamspam")
+
+
+class TestForIterCache(unittest.TestCase):
+    def test_list_mutated_during_iteration(self):
+        def f(seq):
+            out = []
+            for x in seq:
+                if x < 3:
+                    seq.append(x + 10)
+                out.append(x)
+            return out
+
+        for _ in range(100):
+            self.assertEqual(f([0, 1, 2, 3]), [0, 1, 2, 3, 10, 11, 12])
+
+    def test_range_loop_variable(self):
+        def f(start, stop, step):
+            saved = []
+            last = None
+            for i in range(start, stop, step):
+                saved.append(i)
+                last = i
+            return saved, last
+
+        for _ in range(100):
+            for args in [(0, 10, 1), (300, 310, 1), (10, -10, -3),
+                         (2**30, 2**30 + 5, 2), (0, 0, 1)]:
+                expected = list(range(*args))
+                last = expected[-1] if expected else None
+                self.assertEqual(f(*args), (expected, last))
+
+    def test_range_loop_variable_not_shared(self):
+        def f():
+            total = 0
+            for i in range(1000, 1100):
+                total += i
+            return total, i
+
+        for _ in range(100):
+            self.assertEqual(f(), (sum(range(1000, 1100)), 1099))
+
+    def test_iterator_type_changes(self):
+        def f(it):
+            return [x for x in it]
+
+        for _ in range(100):
+            self.assertEqual(f(iter([1, 2])), [1, 2])
+        self.assertEqual(f(iter((3, 4))), [3, 4])
+        self.assertEqual(f(iter(range(2))), [0, 1])
+        self.assertEqual(f(x for x in "ab"), ["a", "b"])
+        self.assertEqual(f(iter({5: 6})), [5])
+
+
+class TestForIterGenerator(unittest.TestCase):
+    def test_return_value_discarded(self):
+        def gen(n):
+            yield from range(n)
+            return "done"
+
+        def f(n):
+            return [x for x in gen(n)]
+
+        for n in range(100):
+            self.assertEqual(f(n), list(range(n)))
+
+    def test_stop_iteration_becomes_runtime_error(self):
+        def gen():
+            yield 1
+            raise StopIteration
+
+        def f():
+            for _ in gen():
+                pass
+
+        for _ in range(100):
+            with self.assertRaisesRegex(RuntimeError,
+                                        "generator raised StopIteration"):
+                f()
+
+    def test_exception_propagates_and_finishes_generator(self):
+        def gen():
+            try:
+                yield 1
+                1/0
+            finally:
+                log.append("finally")
+
+        def f(g):
+            for _ in g:
+                pass
+
+        for _ in range(100):
+            log = []
+            g = gen()
+            try:
+                f(g)
+            except ZeroDivisionError as e:
+                tb = e.__traceback__
+            else:
+                self.fail("ZeroDivisionError not raised")
+            self.assertEqual(log, ["finally"])
+            self.assertIsNone(g.gi_frame)
+            self.assertEqual(list(g), [])
+            names = []
+            while tb is not None:
+                names.append(tb.tb_frame.f_code.co_name)
+                tb = tb.tb_next
+            self.assertEqual(names[-2:], ["f", "gen"])
+
+    def test_exception_state(self):
+        def gen():
+            yield sys.exception()
+            try:
+                raise KeyError
+            except KeyError:
+                yield sys.exception()
+            yield sys.exception()
+
+        def f():
+            results = []
+            try:
+                raise ValueError
+            except ValueError:
+                for x in gen():
+                    results.append((type(x), type(sys.exception())))
+            results.append(sys.exception())
+            return results
+
+        for _ in range(100):
+            self.assertEqual(f(), [(ValueError, ValueError),
+                                   (KeyError, ValueError),
+                                   (ValueError, ValueError),
+                                   None])
+
+    def test_generator_state_while_running(self):
+        def gen():
+            yield g.gi_running
+            yield g.gi_frame.f_back.f_code.co_name
+
+        def f():
+            return list(g)
+
+        for _ in range(100):
+            g = gen()
+            self.assertEqual(f(), [True, "f"])
+            self.assertFalse(g.gi_running)
+            with self.assertRaises(StopIteration):
+                next(g)
+
+    def test_generator_reentrant_iteration(self):
+        def gen():
+            yield 1
+            next(g)
+
+        def f():
+            for _ in g:
+                pass
+
+        for _ in range(100):
+            g = gen()
+            with self.assertRaisesRegex(ValueError, "already executing"):
+                f()
+
+    def test_nested_generators(self):
+        def inner(n):
+            for i in range(n):
+                yield i
+
+        def outer(n):
+            for i in inner(n):
+                yield i * 2
+
+        def f(n):
+            return [x for x in outer(n)]
+
+        for _ in range(100):
+            self.assertEqual(f(5), [0, 2, 4, 6, 8])
+
+    def test_deep_recursion(self):
+        def gen(n):
+            if n:
+                for x in gen(n - 1):
+                    yield x
+            else:
+                yield n
+
+        for _ in range(10):
+            self.assertEqual(list(gen(50)), [0])
+        with self.assertRaises(RecursionError):
+            list(gen(100_000))
+
+
+class TestCallClassCache(unittest.TestCase):
+    def test_init_arguments(self):
+        class C:
+            def __init__(self, a, b):
+                self.a = a
+                self.b = b
+
+        def f(a, b):
+            return C(a, b)
+
+        for i in range(100):
+            c = f(i, -i)
+            self.assertIs(type(c), C)
+            self.assertEqual((c.a, c.b), (i, -i))
+
+    def test_init_returns_non_none(self):
+        class C:
+            def __init__(self, x):
+                self.x = x
+                return x
+
+        def f(x):
+            return C(x)
+
+        for _ in range(100):
+            self.assertEqual(f(None).x, None)
+        with self.assertRaisesRegex(TypeError, "should return None"):
+            f(1)
+        self.assertEqual(f(None).x, None)
+
+    def test_init_raises(self):
+        class C:
+            def __init__(self, x):
+                if x:
+                    raise KeyError(x)
+
+        def f(x):
+            return C(x)
+
+        for _ in range(100):
+            f(0)
+        try:
+            f(1)
+        except KeyError as e:
+            tb = e.__traceback__
+        else:
+            self.fail("KeyError not raised")
+        names = []
+        while tb is not None:
+            names.append(tb.tb_frame.f_code.co_name)
+            tb = tb.tb_next
+        self.assertEqual(names[-2:], ["f", "__init__"])
+
+    def test_init_replaced(self):
+        class C:
+            def __init__(self):
+                self.x = 1
+
+        def f():
+            return C()
+
+        for _ in range(100):
+            self.assertEqual(f().x, 1)
+
+        def __init__(self):
+            self.x = 2
+        C.__init__ = __init__
+        self.assertEqual(f().x, 2)
+        C.__init__.__code__ = (lambda self: setattr(self, "x", 3)).__code__
+        self.assertEqual(f().x, 3)
+
+    def test_new_added(self):
+        class C:
+            def __init__(self):
+                self.x = 1
+
+        def f():
+            return C()
+
+        for _ in range(100):
+            self.assertEqual(f().x, 1)
+
+        C.__new__ = lambda cls: 42
+        self.assertEqual(f(), 42)
+
+    def test_abstract_class(self):
+        import abc
+
+        class C(abc.ABC):
+            def __init__(self):
+                pass
+
+        def f():
+            return C()
+
+        for _ in range(100):
+            f()
+        C.m = abc.abstractmethod(lambda self: None)
+        C.__abstractmethods__ = frozenset({"m"})
+        with self.assertRaises(TypeError):
+            f()
+
+    def test_deep_recursion(self):
+        class C:
+            def __init__(self, n):
+                self.child = C(n - 1) if n else None
+
+        def depth(c):
+            n = 0
+            while c is not None:
+                c = c.child
+                n += 1
+            return n
+
+        for _ in range(10):
+            self.assertEqual(depth(C(50)), 51)
+        with self.assertRaises(RecursionError):
+            C(100_000)
+
+
+class TestSendGenerator(unittest.TestCase):
+    def test_return_value(self):
+        def inner(n):
+            x = yield n
+            return x * 2
+
+        def outer(n):
+            result = yield from inner(n)
+            yield result
+
+        for i in range(100):
+            g = outer(i)
+            self.assertEqual(next(g), i)
+            self.assertEqual(g.send(i + 1), 2 * (i + 1))
+
+    def test_stop_iteration_becomes_runtime_error(self):
+        def inner():
+            yield
+            raise StopIteration
+
+        def outer():
+            yield from inner()
+
+        for _ in range(100):
+            g = outer()
+            next(g)
+            with self.assertRaisesRegex(RuntimeError,
+                                        "generator raised StopIteration"):
+                next(g)
+
+    def test_exception_propagates(self):
+        def inner(n):
+            yield
+            if n:
+                raise KeyError(n)
+            return n
+
+        def outer(n):
+            try:
+                return (yield from inner(n))
+            except KeyError:
+                return -1
+
+        for i in range(100):
+            g = outer(i % 2)
+            next(g)
+            with self.assertRaises(StopIteration) as cm:
+                next(g)
+            self.assertEqual(cm.exception.value, -(i % 2))
+
+    def test_send_to_created_generator(self):
+        def inner():
+            yield 1
+
+        def outer(g):
+            yield from g
+
+        for _ in range(100):
+            self.assertEqual(list(outer(inner())), [1])
+
+    def test_delegate_running_and_frame(self):
+        def inner():
+            yield g.gi_running, i.gi_running
+            yield i.gi_frame.f_back.f_code.co_name
+
+        def outer():
+            yield from i
+
+        for _ in range(100):
+            i = inner()
+            g = outer()
+            self.assertEqual(list(g), [(True, True), "outer"])
+            self.assertFalse(i.gi_running)
+
+    def test_throw_and_close(self):
+        def inner(log):
+            try:
+                yield 1
+                yield 2
+            finally:
+                log.append("inner")
+
+        def outer(log):
+            try:
+                yield from inner(log)
+            finally:
+                log.append("outer")
+
+        for _ in range(100):
+            log = []
+            g = outer(log)
+            self.assertEqual(next(g), 1)
+            self.assertEqual(next(g), 2)
+            g.close()
+            self.assertEqual(log, ["inner", "outer"])
+        g = outer(log := [])
+        next(g)
+        with self.assertRaises(KeyError):
+            g.throw(KeyError)
+        self.assertEqual(log, ["inner", "outer"])
+
+    def test_await_chain(self):
+        class Awaitable:
+            def __await__(self):
+                return (yield "suspend")
+
+        async def leaf(n):
+            return await Awaitable() + n
+
+        async def chain(n, depth):
+            if depth:
+                return await chain(n, depth - 1)
+            return await leaf(n)
+
+        for i in range(100):
+            coro = chain(i, 20)
+            self.assertEqual(coro.send(None), "suspend")
+            with self.assertRaises(StopIteration) as cm:
+                coro.send(1)
+            self.assertEqual(cm.exception.value, i + 1)
+
+    def test_coroutine_reused(self):
+        async def inner():
+            return 1
+
+        async def outer(c):
+            return await c
+
+        for _ in range(100):
+            with self.assertRaises(StopIteration):
+                outer(inner()).send(None)
+        c = inner()
+        with self.assertRaises(StopIteration):
+            outer(c).send(None)
+        with self.assertRaisesRegex(RuntimeError, "already awaited"):
+            outer(c).send(None)
+
+    def test_deep_recursion(self):
+        def gen(n):
+            if n:
+                return (yield from gen(n - 1))
+            yield n
+            return n
+
+        for _ in range(10):
+            self.assertEqual(list(gen(50)), [0])
+        with self.assertRaises(RecursionError):
+            list(gen(100_000))
+
+
+class TestContainsOpCache(unittest.TestCase):
+    def test_dict_and_set(self):
+        def f(x, c):
+            return x in c, x not in c
+
+        for container in ({"a": 1, 2: 3}, {"a", 2}, frozenset({"a", 2})):
+            for _ in range(100):
+                self.assertEqual(f("a", container), (True, False))
+                self.assertEqual(f(2, container), (True, False))
+                self.assertEqual(f("b", container), (False, True))
+
+    def test_unhashable_key(self):
+        def f(x, c):
+            return x in c
+
+        for _ in range(100):
+            self.assertTrue(f(frozenset({1}), {frozenset({1})}))
+        self.assertTrue(f({1}, {frozenset({1})}))
+        with self.assertRaises(TypeError):
+            f([], {1})
+        with self.assertRaises(TypeError):
+            f([], {1: 2})
+
+    def test_str(self):
+        def f(x, c):
+            return x in c
+
+        for _ in range(100):
+            self.assertTrue(f("bc", "abcd"))
+            self.assertFalse(f("x", "abcd"))
+            self.assertTrue(f("", "abcd"))
+        with self.assertRaises(TypeError):
+            f(1, "abcd")
+
+    def test_tuple(self):
+        class Eq:
+            def __eq__(self, other):
+                calls.append(other)
+                return other == 3
+
+        def f(x):
+            return x in (1, "two", 3.0)
+
+        for _ in range(100):
+            self.assertTrue(f(1))
+            self.assertTrue(f("two"))
+            self.assertTrue(f(3))
+            self.assertFalse(f(4))
+        calls = []
+        self.assertTrue(f(Eq()))
+        self.assertEqual(calls, [1, "two", 3.0])
+
+    def test_nan_identity(self):
+        nan = float("nan")
+
+        def f(x, t):
+            return x in t
+
+        for _ in range(100):
+            self.assertTrue(f(nan, (nan,)))
+            self.assertFalse(f(float("nan"), (nan,)))
+
+    def test_container_type_changes(self):
+        def f(x, c):
+            return x in c
+
+        containers = [{1: 2}, {1}, (1,), "1", [1], range(2),
+                      tuple(range(1, 100)), {1: 2}.keys()]
+        for _ in range(100):
+            for c in containers:
+                self.assertIs(f("1" if isinstance(c, str) else 1, c), True)
+
+
+class TestBinaryOpCache(unittest.TestCase):
+    def check_int_ops(self, ops, lhs_values, rhs_values):
+        # The reference results come from the operator module, which does
+        # not go through the specialized instructions.
+        for op, reference in ops:
+            for _ in range(100):
+                op(3, 2)
+            for a in lhs_values:
+                for b in rhs_values:
+                    try:
+                        expected = reference(a, b)
+                    except (ZeroDivisionError, ValueError) as e:
+                        with self.assertRaises(type(e)):
+                            op(a, b)
+                    else:
+                        self.assertEqual(op(a, b), expected, (op, a, b))
+
+    def test_compact_int_ops(self):
+        values = [0, 1, -1, 7, -7, 2**29, -2**29, 2**30 - 1, -2**30 + 1]
+        ops = [
+            (lambda a, b: a & b, operator.and_),
+            (lambda a, b: a | b, operator.or_),
+            (lambda a, b: a ^ b, operator.xor),
+            (lambda a, b: a // b, operator.floordiv),
+            (lambda a, b: a % b, operator.mod),
+        ]
+        self.check_int_ops(ops, values, values)
+
+    def test_shifts(self):
+        values = [0, 1, -1, 5, -5, 2**30 - 1, -2**30 + 1]
+        counts = [-1, 0, 1, 17, 30, 32, 33, 62, 63, 64, 100]
+        ops = [
+            (lambda a, b: a << b, operator.lshift),
+            (lambda a, b: a >> b, operator.rshift),
+        ]
+        self.check_int_ops(ops, values, counts)
+
+    def test_divisor_zero(self):
+        def f(a, b):
+            return a // b, a % b
+
+        for _ in range(100):
+            self.assertEqual(f(7, -2), (-4, -1))
+        with self.assertRaises(ZeroDivisionError):
+            f(7, 0)
+        self.assertEqual(f(-7, 2), (-4, 1))
+
+    def test_big_ints(self):
+        def f(a, b):
+            return a & b, a | b, a // b, a % b, a << 2, a >> 2
+
+        for _ in range(100):
+            self.assertEqual(f(13, 5), (5, 13, 2, 3, 52, 3))
+        big = 2**100 + 13
+        self.assertEqual(f(big, 5),
+                         (big & 5, big | 5, big // 5, big % 5,
+                          big << 2, big >> 2))
+
+    def test_mixed_int_float(self):
+        def f(a, b):
+            return a + b, a - b, a * b
+
+        for _ in range(100):
+            self.assertEqual(f(1, 0.5), (1.5, 0.5, 0.5))
+            self.assertEqual(f(0.5, 1), (1.5, -0.5, 0.5))
+        self.assertEqual(f(2**30 - 1, 0.5),
+                         (2**30 - 0.5, 2**30 - 1.5, (2**30 - 1) / 2))
+        self.assertEqual(f(2**60, 1.0),
+                         (2.0**60, 2.0**60, 2.0**60))
+        self.assertEqual(f(1.5, 0.5), (2.0, 1.0, 0.75))
+        self.assertEqual(f(3, 2), (5, 1, 6))
+        self.assertIs(type(f(3, 2)[0]), int)
+
+
+class TestLoopOptimizer(unittest.TestCase):
+    def assertOptimized(self, func):
+        opnames = {instr.opname
+                   for instr in dis.get_instructions(func, adaptive=True)}
+        self.assertIn("JUMP_BACKWARD_EXECUTOR", opnames)
+
+    def test_int_and_float_loops(self):
+        def ints(n):
+            total = 0
+            for i in range(n):
+                total = total + i * 3 - 1
+            return total
+
+        def floats(n):
+            x = 0.5
+            for i in range(n):
+                x = x * 0.5 + 1.25 - 0.25
+            return x
+
+        def compare(items):
+            small = 0
+            for item in items:
+                if item < 10:
+                    small = small + 1
+            return small
+
+        for _ in range(3):
+            self.assertEqual(ints(1000), sum(i * 3 - 1 for i in range(1000)))
+            self.assertEqual(floats(1000), 2.0)
+            self.assertEqual(compare(list(range(100)) * 10), 100)
+        self.assertOptimized(ints)
+        self.assertOptimized(floats)
+        self.assertOptimized(compare)
+
+    def test_type_changes_in_loop(self):
+        def f(n, switch, value):
+            total = 0
+            for i in range(n):
+                if i == switch:
+                    total = value
+                total = total + i
+            return total
+
+        for _ in range(3):
+            self.assertEqual(f(1000, -1, 0), sum(range(1000)))
+        self.assertEqual(f(1000, 500, 0.5), sum(range(500, 1000)) + 0.5)
+        self.assertEqual(f(1000, 500, 2**100), 2**100 + sum(range(500, 1000)))
+        for _ in range(3):
+            self.assertEqual(f(1000, -1, 0), sum(range(1000)))
+
+    def test_deopt_in_compare(self):
+        def f(items, limit):
+            big = 0.0
+            for item in items:
+                if item > limit:
+                    big = big + item
+            return big
+
+        items = [i / 100 for i in range(100)] * 10
+        expected = f(items, 0.5)
+        for _ in range(3):
+            self.assertEqual(f(items, 0.5), expected)
+        self.assertOptimized(f)
+        # NaN is compared by the interpreter
+        nan = float("nan")
+        self.assertEqual(f(items + [nan] + items, 0.5), 2 * expected)
+        self.assertEqual(f(items, nan), 0.0)
+
+    def test_error_in_loop(self):
+        def f(items):
+            total = 0
+            for i in range(len(items) + 1):
+                total = total + items[i]
+            return total
+
+        for _ in range(3):
+            try:
+                f([1, 2, 3] * 100)
+            except IndexError as e:
+                tb = e.__traceback__.tb_next
+                self.assertEqual(tb.tb_lineno, f.__code__.co_firstlineno + 3)
+            else:
+                self.fail("IndexError not raised")
+
+    def test_long_loop_body(self):
+        # The back edge needs an EXTENDED_ARG
+        body = "".join(f"        x = x + {i}\n" for i in range(100))
+        ns = {}
+        exec(f"def f(n):\n    x = 0\n    for i in range(n):\n{body}"
+             f"    return x\n", ns)
+        f = ns["f"]
+        for _ in range(3):
+            self.assertEqual(f(100), 100 * sum(range(100)))
+
+    def test_trace_hot_loop(self):
+        def f(n):
+            total = 0
+            for i in range(n):
+                total = total + i
+            return total
+
+        self.assertEqual(f(1000), sum(range(1000)))
+        lines = []
+        def tracer(frame, event, arg):
+            if frame.f_code is f.__code__ and event == "line":
+                lines.append(frame.f_lineno - f.__code__.co_firstlineno)
+            return tracer
+        old_trace = sys.gettrace()
+        sys.settrace(tracer)
+        try:
+            self.assertEqual(f(3), 3)
+        finally:
+            sys.settrace(old_trace)
+        self.assertEqual(lines, [1, 2, 3, 2, 3, 2, 3, 2, 4])
+
+
+@support.requires_subprocess()
+class TestLoopOptimizerJIT(unittest.TestCase):
+    def test_loop_optimizer_with_jit(self):
+        # Machine code is only generated on some platforms, elsewhere -X jit
+        # leaves the optimized loops to the interpreter.
+        script_helper.assert_python_ok(
+            "-X", "jit", "-m", "unittest",
+            "test.test_opcache.TestLoopOptimizer")
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -913,12 +913,126 @@ def test_debugmallocstats(self):
                 self.assertIn(b"free PyDictObjects", err)
             if with_pymalloc:
                 self.assertIn(b'Small block threshold', err)
+                self.assertIn(b'# bytes in interpreter caches', err)
             if not with_freelists and not with_pymalloc:
                 self.assertFalse(err)
 
         # The function has no parameter
         self.assertRaises(TypeError, sys._debugmallocstats, True)
 
+    def test_get_malloc_stats(self):
+        stats = sys._get_malloc_stats()
+        self.assertIsInstance(stats, dict)
+        freelists = stats.pop('freelists')
+        for name, value in freelists.items():
+            self.assertEqual(sorted(value),
+                             ['hits', 'limit', 'misses', 'numfree'])
+            for n in value.values():
+                self.assertGreaterEqual(n, 0)
+        if not stats:
+            return
+        fragmentation = stats.pop('fragmentation')
+        self.assertGreaterEqual(fragmentation, 0.0)
+        self.assertLess(fragmentation, 1.0)
+        size_classes = stats.pop('size_classes')
+        for value in stats.values():
+            self.assertIsInstance(value, int)
+            self.assertGreaterEqual(value, 0)
+        self.assertGreater(stats['arenas_allocated'], 0)
+        self.assertLessEqual(stats['arenas_allocated'],
+                             stats['arenas_highwater'])
+        self.assertLessEqual(stats['pools_released'],
+                             stats['pools_released_total'])
+
+        # The pools account for all the memory of the arenas
+        pools = 0
+        for size, (npools, blocks, free_blocks) in size_classes.items():
+            self.assertEqual(size % 8, 0)
+            self.assertLessEqual(size, 512)
+            self.assertGreater(npools, 0)
+            pools += npools
+        total = (stats['bytes_allocated'] + stats['bytes_available']
+                 + stats['bytes_cached'] + stats['bytes_pool_headers']
+                 + stats['bytes_quantization']
+                 + stats['bytes_arena_alignment']
+                 + stats['pools_free'] * stats['pool_size'])
+        self.assertEqual(total,
+                         stats['arenas_allocated'] * stats['arena_size'])
+        self.assertLessEqual(pools + stats['pools_free'],
+                             stats['arenas_allocated']
+                             * (stats['arena_size'] // stats['pool_size']))
+
+    def test_set_freelist_limit(self):
+        freelists = sys._get_malloc_stats()['freelists']
+        if 'dict' not in freelists:
+            self.skipTest('needs the dict free list')
+        old_limit = freelists['dict']['limit']
+        self.addCleanup(sys._set_freelist_limit, 'dict', old_limit)
+
+        sys._set_freelist_limit('dict', 500)
+        dicts = [{} for _ in range(1000)]
+        del dicts
+        before = sys._get_malloc_stats()['freelists']['dict']
+        self.assertEqual(before['limit'], 500)
+        self.assertGreaterEqual(before['numfree'], 400)
+        dicts = [{} for _ in range(400)]
+        after = sys._get_malloc_stats()['freelists']['dict']
+        self.assertGreaterEqual(after['hits'] - before['hits'], 400)
+        del dicts
+
+        # Lowering the limit frees the objects above it
+        sys._set_freelist_limit('dict', 10)
+        after = sys._get_malloc_stats()['freelists']['dict']
+        self.assertEqual(after['limit'], 10)
+        self.assertLessEqual(after['numfree'], 10)
+
+        self.assertRaises(ValueError, sys._set_freelist_limit, 'dict', -1)
+        self.assertRaises(ValueError, sys._set_freelist_limit, 'spam', 1)
+
+    def test_freelist_limits_option(self):
+        code = ("import sys; f = sys._get_malloc_stats()['freelists']; "
+                "print(f.get('list', {}).get('limit'), "
+                "f.get('float', {}).get('limit'))")
+        rc, out, err = assert_python_ok(
+            '-X', 'freelist_limits=list=1234,float=0', '-c', code)
+        if out.strip() != b'None None':
+            self.assertEqual(out.strip(), b'1234 0')
+        rc, out, err = assert_python_ok(
+            '-c', code, PYTHONFREELISTLIMITS='list=7')
+        if out.strip() != b'None None':
+            self.assertEqual(out.strip().split()[0], b'7')
+        for spec in ('spam=1', 'list', 'list=-1', 'list=1,', 'list=x'):
+            with self.subTest(spec=spec):
+                rc, out, err = assert_python_failure(
+                    '-X', f'freelist_limits={spec}', '-c', 'pass')
+                self.assertIn(b'invalid free list limits', err)
+
+    @unittest.skipUnless(sys.platform == "linux", "needs madvise()")
+    @unittest.skipUnless(support.with_pymalloc(), "needs pymalloc")
+    def test_release_free_pools(self):
+        # A full collection gives back the pages of the pools freed in
+        # arenas which are still used, unless the arenas use huge pages.
+        code = textwrap.dedent("""
+            import gc, sys
+            data = [str(i) * 3 for i in range(300000)]
+            keep = data[::2000]
+            del data
+            before = sys._get_malloc_stats()
+            gc.collect()
+            after = sys._get_malloc_stats()
+            print(before['pools_released_total'],
+                  after['pools_released_total'], after['bytes_released'])
+        """)
+        env = {'PYTHONMALLOC': 'pymalloc'}
+        out = assert_python_ok('-c', code, **env)[1].split()
+        before, after, released = map(int, out)
+        self.assertGreater(after, before)
+        self.assertGreater(released, 0)
+
+        out = assert_python_ok('-X', 'malloc_hugepages', '-c', code,
+                               **env)[1].split()
+        self.assertEqual(list(map(int, out)), [0, 0, 0])
+
     @unittest.skipUnless(hasattr(sys, "getallocatedblocks"),
                          "sys.getallocatedblocks unavailable on this build")
     def test_getallocatedblocks(self):
@@ -1332,13 +1446,13 @@ def inner():
         # code
         def check_code_size(a, expected_size):
             self.assertGreaterEqual(sys.getsizeof(a), expected_size)
-        check_code_size(get_cell().__code__, size('6i13P'))
-        check_code_size(get_cell.__code__, size('6i13P'))
+        check_code_size(get_cell().__code__, size('7i14P'))
+        check_code_size(get_cell.__code__, size('7i14P'))
         def get_cell2(x):
             def inner():
                 return x
             return inner
-        check_code_size(get_cell2.__code__, size('6i13P') + calcsize('n'))
+        check_code_size(get_cell2.__code__, size('7i14P') + calcsize('n'))
         # complex
         check(complex(0,1), size('2d'))
         # method_descriptor (descriptor object)
@@ -1518,7 +1632,7 @@ def delx(self): del self.__x
                   '10P'                 # PySequenceMethods
                   '2P'                  # PyBufferProcs
                   '6P'
-                  '1P'                  # Specializer cache
+                  '2P'                  # Specializer cache
                   )
         class newstyleclass(object): pass
         # Separate block for PyDictKeysObject with 8 keys and 5 entries
@@ -1589,7 +1703,7 @@ class D(dict):
         check(D(x=[]), {'x': []}, '3P')
         class L(list):
             __slots__ = 'a', 'b', 'c'
-        check(L(), [], '3P')
+        check(L(), list(), '3P')
         class S(set):
             __slots__ = 'a', 'b', 'c'
         check(S(), set(), '3P')
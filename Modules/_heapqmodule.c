@@ -11,7 +11,7 @@ annotated by François Pinard, and converted to C by Raymond Hettinger.
 #endif
 
 #include "Python.h"
-#include "pycore_list.h"          // _PyList_ITEMS()
+#include "pycore_list.h"          // _PyList_ITEMS(), _PyList_MaintainTracking()
 
 #include "clinic/_heapqmodule.c.h"
 
@@ -198,6 +198,7 @@ heapreplace_internal(PyObject *heap, PyObject *item, int siftup_func(PyListObjec
 
     returnitem = PyList_GET_ITEM(heap, 0);
     Py_INCREF(item);
+    _PyList_MaintainTracking((PyListObject *)heap, item);
     PyList_SET_ITEM(heap, 0, item);
     if (siftup_func((PyListObject *)heap, 0)) {
         Py_DECREF(returnitem);
@@ -275,6 +276,7 @@ _heapq_heappushpop_impl(PyObject *module, PyObject *heap, PyObject *item)
 
     returnitem = PyList_GET_ITEM(heap, 0);
     Py_INCREF(item);
+    _PyList_MaintainTracking((PyListObject *)heap, item);
     PyList_SET_ITEM(heap, 0, item);
     if (siftup((PyListObject *)heap, 0)) {
         Py_DECREF(returnitem);
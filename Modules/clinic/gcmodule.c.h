@@ -220,6 +220,263 @@ gc_get_count(PyObject *module, PyObject *Py_UNUSED(ignored))
     return gc_get_count_impl(module);
 }
 
+PyDoc_STRVAR(gc_set_incremental__doc__,
+"set_incremental($module, budget, /)\n"
+"--\n"
+"\n"
+"Set the time budget of incremental collections, in microseconds.\n"
+"\n"
+"If budget is positive, the collections of the oldest generation are made of\n"
+"increments interleaved with the program, each taking about budget\n"
+"microseconds.  Zero disables incremental collection.");
+
+#define GC_SET_INCREMENTAL_METHODDEF    \
+    {"set_incremental", (PyCFunction)gc_set_incremental, METH_O, gc_set_incremental__doc__},
+
+static PyObject *
+gc_set_incremental_impl(PyObject *module, Py_ssize_t budget);
+
+static PyObject *
+gc_set_incremental(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t budget;
+
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(arg);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        budget = ival;
+    }
+    return_value = gc_set_incremental_impl(module, budget);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_incremental__doc__,
+"get_incremental($module, /)\n"
+"--\n"
+"\n"
+"Return the time budget of incremental collections, in microseconds.\n"
+"\n"
+"Zero means that incremental collection is disabled.");
+
+#define GC_GET_INCREMENTAL_METHODDEF    \
+    {"get_incremental", (PyCFunction)gc_get_incremental, METH_NOARGS, gc_get_incremental__doc__},
+
+static Py_ssize_t
+gc_get_incremental_impl(PyObject *module);
+
+static PyObject *
+gc_get_incremental(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = gc_get_incremental_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_set_adaptive__doc__,
+"set_adaptive($module, max_overhead, /)\n"
+"--\n"
+"\n"
+"Adapt the collection thresholds to keep the collection overhead low.\n"
+"\n"
+"max_overhead is the highest percentage of the time to spend collecting.\n"
+"While collections take more than that, the thresholds of the generations\n"
+"whose collections mostly promote their objects are raised, up to 64 times\n"
+"the thresholds set by set_threshold(); they are lowered back when the\n"
+"overhead drops.  Zero disables the policy and restores the thresholds.");
+
+#define GC_SET_ADAPTIVE_METHODDEF    \
+    {"set_adaptive", (PyCFunction)gc_set_adaptive, METH_O, gc_set_adaptive__doc__},
+
+static PyObject *
+gc_set_adaptive_impl(PyObject *module, double max_overhead);
+
+static PyObject *
+gc_set_adaptive(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    double max_overhead;
+
+    if (PyFloat_CheckExact(arg)) {
+        max_overhead = PyFloat_AS_DOUBLE(arg);
+    }
+    else
+    {
+        max_overhead = PyFloat_AsDouble(arg);
+        if (max_overhead == -1.0 && PyErr_Occurred()) {
+            goto exit;
+        }
+    }
+    return_value = gc_set_adaptive_impl(module, max_overhead);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_adaptive__doc__,
+"get_adaptive($module, /)\n"
+"--\n"
+"\n"
+"Return the highest percentage of the time to spend collecting.\n"
+"\n"
+"Zero means that the collection thresholds are not adapted.");
+
+#define GC_GET_ADAPTIVE_METHODDEF    \
+    {"get_adaptive", (PyCFunction)gc_get_adaptive, METH_NOARGS, gc_get_adaptive__doc__},
+
+static double
+gc_get_adaptive_impl(PyObject *module);
+
+static PyObject *
+gc_get_adaptive(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    double _return_value;
+
+    _return_value = gc_get_adaptive_impl(module);
+    if ((_return_value == -1.0) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyFloat_FromDouble(_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_set_parallel__doc__,
+"set_parallel($module, nthreads, /)\n"
+"--\n"
+"\n"
+"Set the number of threads used by large collections.\n"
+"\n"
+"The internal references of the objects of collections larger than about\n"
+"65000 objects are subtracted by nthreads threads, including the collecting\n"
+"one.  The other phases of the collection stay sequential.  1 disables\n"
+"parallel collection.");
+
+#define GC_SET_PARALLEL_METHODDEF    \
+    {"set_parallel", (PyCFunction)gc_set_parallel, METH_O, gc_set_parallel__doc__},
+
+static PyObject *
+gc_set_parallel_impl(PyObject *module, int nthreads);
+
+static PyObject *
+gc_set_parallel(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int nthreads;
+
+    nthreads = _PyLong_AsInt(arg);
+    if (nthreads == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = gc_set_parallel_impl(module, nthreads);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_parallel__doc__,
+"get_parallel($module, /)\n"
+"--\n"
+"\n"
+"Return the number of threads used by large collections.");
+
+#define GC_GET_PARALLEL_METHODDEF    \
+    {"get_parallel", (PyCFunction)gc_get_parallel, METH_NOARGS, gc_get_parallel__doc__},
+
+static int
+gc_get_parallel_impl(PyObject *module);
+
+static PyObject *
+gc_get_parallel(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = gc_get_parallel_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_set_profile__doc__,
+"set_profile($module, enabled, /)\n"
+"--\n"
+"\n"
+"Enable or disable the profiling of collections.\n"
+"\n"
+"When profiling is enabled, get_profile() returns the profile of the last\n"
+"collection, also passed to the callbacks as the \"profile\" item of their info.");
+
+#define GC_SET_PROFILE_METHODDEF    \
+    {"set_profile", (PyCFunction)gc_set_profile, METH_O, gc_set_profile__doc__},
+
+static PyObject *
+gc_set_profile_impl(PyObject *module, int enabled);
+
+static PyObject *
+gc_set_profile(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int enabled;
+
+    enabled = PyObject_IsTrue(arg);
+    if (enabled < 0) {
+        goto exit;
+    }
+    return_value = gc_set_profile_impl(module, enabled);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_profile__doc__,
+"get_profile($module, /)\n"
+"--\n"
+"\n"
+"Return the profile of the last collection as a dict.\n"
+"\n"
+"The dict contains the generation collected, whether the collection was\n"
+"incremental, the numbers of objects examined and promoted to an older\n"
+"generation, the times spent in the collection, handling weak references and\n"
+"handling finalizers, and, in \"types\", the number of objects of each type and\n"
+"the time spent traversing them.  Return None if no collection was profiled\n"
+"since profiling was enabled.");
+
+#define GC_GET_PROFILE_METHODDEF    \
+    {"get_profile", (PyCFunction)gc_get_profile, METH_NOARGS, gc_get_profile__doc__},
+
+static PyObject *
+gc_get_profile_impl(PyObject *module);
+
+static PyObject *
+gc_get_profile(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return gc_get_profile_impl(module);
+}
+
 PyDoc_STRVAR(gc_get_objects__doc__,
 "get_objects($module, /, generation=None)\n"
 "--\n"
@@ -304,25 +561,51 @@ PyDoc_STRVAR(gc_is_finalized__doc__,
     {"is_finalized", (PyCFunction)gc_is_finalized, METH_O, gc_is_finalized__doc__},
 
 PyDoc_STRVAR(gc_freeze__doc__,
-"freeze($module, /)\n"
+"freeze($module, /, *, isolate=False)\n"
 "--\n"
 "\n"
 "Freeze all current tracked objects and ignore them for future collections.\n"
 "\n"
 "This can be used before a POSIX fork() call to make the gc copy-on-write friendly.\n"
 "Note: collection before a POSIX fork() call may free pages for future allocation\n"
-"which can cause copy-on-write.");
+"which can cause copy-on-write.\n"
+"\n"
+"If isolate is true, the memory left free next to the objects allocated so far\n"
+"is not reused for new objects, so that the objects allocated after a fork()\n"
+"do not share pages with the frozen ones.");
 
 #define GC_FREEZE_METHODDEF    \
-    {"freeze", (PyCFunction)gc_freeze, METH_NOARGS, gc_freeze__doc__},
+    {"freeze", _PyCFunction_CAST(gc_freeze), METH_FASTCALL|METH_KEYWORDS, gc_freeze__doc__},
 
 static PyObject *
-gc_freeze_impl(PyObject *module);
+gc_freeze_impl(PyObject *module, int isolate);
 
 static PyObject *
-gc_freeze(PyObject *module, PyObject *Py_UNUSED(ignored))
+gc_freeze(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
-    return gc_freeze_impl(module);
+    PyObject *return_value = NULL;
+    static const char * const _keywords[] = {"isolate", NULL};
+    static _PyArg_Parser _parser = {NULL, _keywords, "freeze", 0};
+    PyObject *argsbuf[1];
+    Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
+    int isolate = 0;
+
+    args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 0, 0, argsbuf);
+    if (!args) {
+        goto exit;
+    }
+    if (!noptargs) {
+        goto skip_optional_kwonly;
+    }
+    isolate = PyObject_IsTrue(args[0]);
+    if (isolate < 0) {
+        goto exit;
+    }
+skip_optional_kwonly:
+    return_value = gc_freeze_impl(module, isolate);
+
+exit:
+    return return_value;
 }
 
 PyDoc_STRVAR(gc_unfreeze__doc__,
@@ -372,4 +655,4 @@ gc_get_freeze_count(PyObject *module, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=71f7136d6e3f2323 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=bec4e7630f97d8cf input=a9049054013a1b77]*/
@@ -25,10 +25,12 @@
 
 #include "Python.h"
 #include "pycore_context.h"
+#include "pycore_hashtable.h"     // _Py_hashtable_t
 #include "pycore_initconfig.h"
 #include "pycore_interp.h"      // PyInterpreterState.gc
 #include "pycore_object.h"
 #include "pycore_pyerrors.h"
+#include "pycore_pymem.h"       // _PyObject_RetireUsedPools()
 #include "pycore_pystate.h"     // _PyThreadState_GET()
 #include "pydtrace.h"
 
@@ -116,6 +118,27 @@ gc_decref(PyGC_Head *g)
     g->_gc_prev -= 1 << _PyGC_PREV_SHIFT;
 }
 
+// The pending bit is set for the objects in the pending list of an
+// incremental collection, and only for them.  It is always clear if the
+// platform has no room for it (see pycore_gc.h).
+static inline int
+gc_is_pending(PyGC_Head *g)
+{
+    return (g->_gc_prev & _PyGC_PREV_MASK_PENDING) != 0;
+}
+
+static inline void
+gc_set_pending(PyGC_Head *g)
+{
+    g->_gc_prev |= _PyGC_PREV_MASK_PENDING;
+}
+
+static inline void
+gc_clear_pending(PyGC_Head *g)
+{
+    g->_gc_prev &= ~_PyGC_PREV_MASK_PENDING;
+}
+
 /* set for debugging information */
 #define DEBUG_STATS             (1<<0) /* print collection statistics */
 #define DEBUG_COLLECTABLE       (1<<1) /* print collectable objects */
@@ -126,6 +149,16 @@ gc_decref(PyGC_Head *g)
                 DEBUG_SAVEALL
 
 #define GEN_HEAD(gcstate, n) (&(gcstate)->generations[n].head)
+#define PENDING_HEAD(gcstate) (&(gcstate)->incremental.pending)
+
+/* Phases of an incremental pass */
+#define INCREMENTAL_IDLE        0   /* no pass in progress */
+#define INCREMENTAL_ARMING      1   /* moving objects to the pending list */
+#define INCREMENTAL_SCANNING    2   /* collecting slices of the pending list */
+
+/* Bounds of the work of an increment, see take_pending() */
+#define INCREMENTAL_MIN_SLICE   1000
+#define INCREMENTAL_MAX_SLICE   (1 << 24)
 
 
 static GCState *
@@ -139,18 +172,20 @@ get_gc_state(void)
 void
 _PyGC_InitState(GCState *gcstate)
 {
-#define INIT_HEAD(GEN) \
+#define INIT_HEAD(HEAD) \
     do { \
-        GEN.head._gc_next = (uintptr_t)&GEN.head; \
-        GEN.head._gc_prev = (uintptr_t)&GEN.head; \
+        HEAD._gc_next = (uintptr_t)&HEAD; \
+        HEAD._gc_prev = (uintptr_t)&HEAD; \
     } while (0)
 
     for (int i = 0; i < NUM_GENERATIONS; i++) {
         assert(gcstate->generations[i].count == 0);
-        INIT_HEAD(gcstate->generations[i]);
+        INIT_HEAD(gcstate->generations[i].head);
     };
     gcstate->generation0 = GEN_HEAD(gcstate, 0);
-    INIT_HEAD(gcstate->permanent_generation);
+    INIT_HEAD(gcstate->permanent_generation.head);
+    INIT_HEAD(gcstate->incremental.pending);
+    gcstate->parallel = 1;
 
 #undef INIT_HEAD
 }
@@ -181,9 +216,11 @@ _gc_prev values
 
 Between collections, _gc_prev is used for doubly linked list.
 
-Lowest two bits of _gc_prev are used for flags.
+Lowest bits of _gc_prev are used for flags.
 PREV_MASK_COLLECTING is used only while collecting and cleared before GC ends
-or _PyObject_GC_UNTRACK() is called.
+or _PyObject_GC_UNTRACK() is called.  _PyGC_PREV_MASK_PENDING is set between
+collections for the objects in the pending list of an incremental collection,
+and cleared when they leave it or _PyObject_GC_UNTRACK() is called.
 
 During a collection, _gc_prev is temporary used for gc_refs, and the gc list
 is singly linked until _gc_prev is restored.
@@ -412,14 +449,52 @@ validate_list(PyGC_Head *head, enum flagstates flags)
 /*** end of list stuff ***/
 
 
+/* The lists of large collections are split into chunks of this many objects,
+ * which the threads of a parallel collection take in turn. */
+#define CHUNK_SIZE 4096
+/* Collections with fewer objects are not worth starting threads */
+#define PARALLEL_MIN_SIZE (16 * CHUNK_SIZE)
+
+/* The first objects of the chunks of a list */
+struct gc_chunks {
+    PyGC_Head **starts;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+    int failed;
+};
+
+static void
+gc_chunks_add(struct gc_chunks *chunks, PyGC_Head *gc)
+{
+    if (chunks->size == chunks->allocated) {
+        Py_ssize_t allocated = Py_MAX(64, 2 * chunks->allocated);
+        PyGC_Head **starts = PyMem_RawRealloc(
+            chunks->starts, allocated * sizeof(PyGC_Head *));
+        if (starts == NULL) {
+            chunks->failed = 1;
+            return;
+        }
+        chunks->starts = starts;
+        chunks->allocated = allocated;
+    }
+    chunks->starts[chunks->size++] = gc;
+}
+
 /* Set all gc_refs = ob_refcnt.  After this, gc_refs is > 0 and
  * PREV_MASK_COLLECTING bit is set for all objects in containers.
+ * If chunks is not NULL, also split containers into chunks.
+ * Return the number of objects in containers.
  */
-static void
-update_refs(PyGC_Head *containers)
+static Py_ssize_t
+update_refs(PyGC_Head *containers, struct gc_chunks *chunks)
 {
+    Py_ssize_t n = 0;
     PyGC_Head *gc = GC_NEXT(containers);
     for (; gc != containers; gc = GC_NEXT(gc)) {
+        if (chunks != NULL && n % CHUNK_SIZE == 0 && !chunks->failed) {
+            gc_chunks_add(chunks, gc);
+        }
+        n++;
         gc_reset_refs(gc, Py_REFCNT(FROM_GC(gc)));
         /* Python's cyclic gc should never see an incoming refcount
          * of 0:  if something decref'ed to 0, it should have been
@@ -441,6 +516,7 @@ update_refs(PyGC_Head *containers)
          */
         _PyObject_ASSERT(FROM_GC(gc), gc_get_refs(gc) != 0);
     }
+    return n;
 }
 
 /* A traversal callback for subtract_refs. */
@@ -481,6 +557,192 @@ subtract_refs(PyGC_Head *containers)
     }
 }
 
+/* The profile of the objects of a type in a collection */
+struct gc_type_profile {
+    Py_ssize_t objects;
+    _PyTime_t traverse_time;
+    /* The name of the type, which may be freed by the collection */
+    char name[1];
+};
+
+/* Return the profile of the objects of type tp, or NULL on memory error. */
+static struct gc_type_profile *
+get_type_profile(_Py_hashtable_t *types, PyTypeObject *tp)
+{
+    struct gc_type_profile *profile = _Py_hashtable_get(types, tp);
+    if (profile != NULL) {
+        return profile;
+    }
+    const char *name = tp->tp_name;
+    const char *module = NULL;
+    if (tp->tp_flags & Py_TPFLAGS_HEAPTYPE) {
+        /* The name of static types includes the module */
+        PyHeapTypeObject *et = (PyHeapTypeObject *)tp;
+        if (et->ht_qualname != NULL
+            && (name = PyUnicode_AsUTF8(et->ht_qualname)) == NULL)
+        {
+            name = tp->tp_name;
+        }
+        PyObject *mod = NULL;
+        if (tp->tp_dict != NULL) {
+            mod = PyDict_GetItemWithError(tp->tp_dict, &_Py_ID(__module__));
+        }
+        if (mod != NULL && PyUnicode_Check(mod)) {
+            module = PyUnicode_AsUTF8(mod);
+        }
+        if (module != NULL && strcmp(module, "builtins") == 0) {
+            module = NULL;
+        }
+        PyErr_Clear();
+    }
+    size_t size = strlen(name) + 1;
+    if (module != NULL) {
+        size += strlen(module) + 1;
+    }
+    profile = PyMem_Malloc(sizeof(struct gc_type_profile) + size);
+    if (profile == NULL) {
+        return NULL;
+    }
+    profile->objects = 0;
+    profile->traverse_time = 0;
+    if (module != NULL) {
+        PyOS_snprintf(profile->name, size, "%s.%s", module, name);
+    }
+    else {
+        memcpy(profile->name, name, size);
+    }
+    if (_Py_hashtable_set(types, tp, profile) < 0) {
+        PyMem_Free(profile);
+        return NULL;
+    }
+    return profile;
+}
+
+/* Like subtract_refs(), also counting the objects of each type and the time
+ * spent traversing them in types. */
+static void
+subtract_refs_profiled(PyGC_Head *containers, _Py_hashtable_t *types)
+{
+    PyTypeObject *last = NULL;
+    struct gc_type_profile *profile = NULL;
+    PyGC_Head *gc = GC_NEXT(containers);
+    for (; gc != containers; gc = GC_NEXT(gc)) {
+        PyObject *op = FROM_GC(gc);
+        PyTypeObject *tp = Py_TYPE(op);
+        if (tp != last) {
+            profile = get_type_profile(types, tp);
+            last = tp;
+        }
+        _PyTime_t t = _PyTime_GetPerfCounter();
+        (void) tp->tp_traverse(op,
+                               (visitproc)visit_decref,
+                               op);
+        if (profile != NULL) {
+            profile->objects++;
+            profile->traverse_time += _PyTime_GetPerfCounter() - t;
+        }
+    }
+}
+
+#ifdef HAVE_BUILTIN_ATOMIC
+/* Parallel collection: the threads subtract the references of different
+ * objects, but they may subtract from the same ones, so the gc_refs are
+ * updated with atomic operations.  The other threads are blocked on the GIL
+ * and tp_traverse only reads the objects, so nothing else changes them. */
+
+/* A traversal callback for subtract_refs_parallel(). */
+static int
+visit_decref_atomic(PyObject *op, void *parent)
+{
+    _PyObject_ASSERT(_PyObject_CAST(parent), !_PyObject_IsFreed(op));
+
+    if (_PyObject_IS_GC(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        uintptr_t prev = __atomic_load_n(&gc->_gc_prev, __ATOMIC_RELAXED);
+        if (prev & PREV_MASK_COLLECTING) {
+            __atomic_fetch_sub(&gc->_gc_prev, (uintptr_t)1 << _PyGC_PREV_SHIFT,
+                               __ATOMIC_RELAXED);
+        }
+    }
+    return 0;
+}
+
+struct subtract_job {
+    struct gc_chunks *chunks;
+    PyGC_Head *containers;
+    /* Index of the next chunk to take */
+    Py_ssize_t next;
+    /* Number of threads still running */
+    int running;
+    /* Released by the last helper thread to finish, if it is the last */
+    PyThread_type_lock done;
+};
+
+static void
+subtract_chunks(struct subtract_job *job)
+{
+    struct gc_chunks *chunks = job->chunks;
+    for (;;) {
+        Py_ssize_t i = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED);
+        if (i >= chunks->size) {
+            break;
+        }
+        PyGC_Head *end = job->containers;
+        if (i + 1 < chunks->size) {
+            end = chunks->starts[i + 1];
+        }
+        for (PyGC_Head *gc = chunks->starts[i]; gc != end; gc = GC_NEXT(gc)) {
+            PyObject *op = FROM_GC(gc);
+            (void) Py_TYPE(op)->tp_traverse(op, visit_decref_atomic, op);
+        }
+    }
+}
+
+static void
+subtract_helper(void *arg)
+{
+    struct subtract_job *job = (struct subtract_job *)arg;
+    subtract_chunks(job);
+    if (__atomic_sub_fetch(&job->running, 1, __ATOMIC_ACQ_REL) == 0) {
+        PyThread_release_lock(job->done);
+    }
+}
+
+/* Like subtract_refs(), with nthreads threads (counting this one) taking
+ * the chunks of containers in turn.  Return -1, having done nothing, if
+ * the threads cannot be set up. */
+static int
+subtract_refs_parallel(PyGC_Head *containers, struct gc_chunks *chunks,
+                       int nthreads)
+{
+    struct subtract_job job = {chunks, containers, 0, 0, NULL};
+    job.done = PyThread_allocate_lock();
+    if (job.done == NULL) {
+        return -1;
+    }
+    PyThread_acquire_lock(job.done, WAIT_LOCK);
+    int helpers = (int)Py_MIN(nthreads - 1, chunks->size - 1);
+    job.running = helpers + 1;
+    for (int i = 0; i < helpers; i++) {
+        if (PyThread_start_new_thread(subtract_helper, &job)
+            == PYTHREAD_INVALID_THREAD_ID)
+        {
+            /* This thread does the work of the missing helpers */
+            __atomic_sub_fetch(&job.running, helpers - i, __ATOMIC_ACQ_REL);
+            break;
+        }
+    }
+    subtract_chunks(&job);
+    if (__atomic_sub_fetch(&job.running, 1, __ATOMIC_ACQ_REL) != 0) {
+        PyThread_acquire_lock(job.done, WAIT_LOCK);
+    }
+    PyThread_free_lock(job.done);
+    return 0;
+}
+#else
+#define subtract_refs_parallel(containers, chunks, nthreads) (-1)
+#endif  /* HAVE_BUILTIN_ATOMIC */
+
 /* A traversal callback for move_unreachable. */
 static int
 visit_reachable(PyObject *op, PyGC_Head *reachable)
@@ -1030,6 +1292,7 @@ delete_garbage(PyThreadState *tstate, GCState *gcstate,
  * All free lists are cleared during the collection of the highest generation.
  * Allocated items in the free list may keep a pymalloc arena occupied.
  * Clearing the free lists may give back memory to the OS earlier.
+ * The pages of the pymalloc pools left free are then released as well.
  */
 static void
 clear_freelists(PyInterpreterState *interp)
@@ -1040,6 +1303,7 @@ clear_freelists(PyInterpreterState *interp)
     _PyDict_ClearFreeList(interp);
     _PyAsyncGen_ClearFreeLists(interp);
     _PyContext_ClearFreeList(interp);
+    _PyObject_ReleaseFreePools();
 }
 
 // Show stats for objects in each generations
@@ -1050,9 +1314,11 @@ show_stats_each_generations(GCState *gcstate)
     size_t pos = 0;
 
     for (int i = 0; i < NUM_GENERATIONS && pos < sizeof(buf); i++) {
-        pos += PyOS_snprintf(buf+pos, sizeof(buf)-pos,
-                             " %zd",
-                             gc_list_size(GEN_HEAD(gcstate, i)));
+        Py_ssize_t size = gc_list_size(GEN_HEAD(gcstate, i));
+        if (i == NUM_GENERATIONS-1) {
+            size += gc_list_size(PENDING_HEAD(gcstate));
+        }
+        pos += PyOS_snprintf(buf+pos, sizeof(buf)-pos, " %zd", size);
     }
 
     PySys_FormatStderr(
@@ -1087,17 +1353,34 @@ IMPORTANT: This function leaves 'unreachable' with the NEXT_MASK_UNREACHABLE
 flag set but it does not clear it to skip unnecessary iteration. Before the
 flag is cleared (for example, by using 'clear_unreachable_mask' function or
 by a call to 'move_legacy_finalizers'), the 'unreachable' list is not a normal
-list and we can not use most gc_list_* functions for it. */
-static inline void
-deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
+list and we can not use most gc_list_* functions for it.
+
+Step 2 is split across nthreads threads if "base" is large enough.  If
+types is not NULL, it is profiled instead (see struct gc_profile_state).
+
+Return the number of objects initially in "base". */
+static inline Py_ssize_t
+deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable, int nthreads,
+                   _Py_hashtable_t *types) {
     validate_list(base, collecting_clear_unreachable_clear);
     /* Using ob_refcnt and gc_refs, calculate which objects in the
      * container set are reachable from outside the set (i.e., have a
      * refcount greater than 0 when all the references within the
      * set are taken into account).
      */
-    update_refs(base);  // gc_prev is used for gc_refs
-    subtract_refs(base);
+    struct gc_chunks chunks = {NULL, 0, 0, 0};
+    // gc_prev is used for gc_refs
+    int parallel = (nthreads > 1 && types == NULL);
+    Py_ssize_t n = update_refs(base, parallel ? &chunks : NULL);
+    if (types != NULL) {
+        subtract_refs_profiled(base, types);
+    }
+    else if (!parallel || chunks.failed || n < PARALLEL_MIN_SIZE
+             || subtract_refs_parallel(base, &chunks, nthreads) < 0)
+    {
+        subtract_refs(base);
+    }
+    PyMem_RawFree(chunks.starts);
 
     /* Leave everything reachable from outside base in base, and move
      * everything else (in base) to unreachable.
@@ -1138,6 +1421,7 @@ deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
     move_unreachable(base, unreachable);  // gc_prev is pointer again
     validate_list(base, collecting_clear_unreachable_clear);
     validate_list(unreachable, collecting_set_unreachable_set);
+    return n;
 }
 
 /* Handle objects that may have resurrected after a call to 'finalize_garbage', moving
@@ -1165,81 +1449,245 @@ handle_resurrected_objects(PyGC_Head *unreachable, PyGC_Head* still_unreachable,
     // have the PREV_MARK_COLLECTING set, but the objects are going to be
     // removed so we can skip the expense of clearing the flag.
     PyGC_Head* resurrected = unreachable;
-    deduce_unreachable(resurrected, still_unreachable);
+    deduce_unreachable(resurrected, still_unreachable, 1, NULL);
     clear_unreachable_mask(still_unreachable);
 
     // Move the resurrected objects to the old generation for future collection.
     gc_list_merge(resurrected, old_generation);
 }
 
-/* This is the main function.  Read this to understand how the
- * collection process works. */
-static Py_ssize_t
-gc_collect_main(PyThreadState *tstate, int generation,
-                Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
-                int nofail)
+/* Abandon the incremental pass in progress, if any: the pending objects go
+ * back to the oldest generation. */
+static void
+incremental_reset(GCState *gcstate)
 {
-    int i;
-    Py_ssize_t m = 0; /* # objects collected */
-    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
-    PyGC_Head *young; /* the generation we are examining */
-    PyGC_Head *old; /* next older generation */
-    PyGC_Head unreachable; /* non-problematic unreachable trash */
-    PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
-    PyGC_Head *gc;
-    _PyTime_t t1 = 0;   /* initialize to prevent a compiler warning */
-    GCState *gcstate = &tstate->interp->gc;
-
-    // gc_collect_main() must not be called before _PyGC_Init
-    // or after _PyGC_Fini()
-    assert(gcstate->garbage != NULL);
-    assert(!_PyErr_Occurred(tstate));
+    struct gc_incremental_state *inc = &gcstate->incremental;
+    PyGC_Head *pending = PENDING_HEAD(gcstate);
+    for (PyGC_Head *gc = GC_NEXT(pending); gc != pending; gc = GC_NEXT(gc)) {
+        gc_clear_pending(gc);
+    }
+    gc_list_merge(pending, GEN_HEAD(gcstate, NUM_GENERATIONS-1));
+    inc->phase = INCREMENTAL_IDLE;
+    inc->survivors = 0;
+}
 
-    if (gcstate->debug & DEBUG_STATS) {
-        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
-        show_stats_each_generations(gcstate);
-        t1 = _PyTime_GetPerfCounter();
+/* Move up to 'count' objects from the oldest generation to the pending list.
+ * Return true if the oldest generation is left empty. */
+static int
+arm_pending(GCState *gcstate, Py_ssize_t count)
+{
+    PyGC_Head *old = GEN_HEAD(gcstate, NUM_GENERATIONS-1);
+    PyGC_Head *pending = PENDING_HEAD(gcstate);
+    for (; count > 0 && !gc_list_is_empty(old); count--) {
+        PyGC_Head *gc = GC_NEXT(old);
+        gc_list_move(gc, pending);
+        gc_set_pending(gc);
     }
+    return gc_list_is_empty(old);
+}
 
-    if (PyDTrace_GC_START_ENABLED())
-        PyDTrace_GC_START(generation);
+struct pending_closure {
+    PyGC_Head *increment;
+    Py_ssize_t work;  /* number of objects and references examined */
+    Py_ssize_t slice;
+};
 
-    /* update collection and allocation counters */
-    if (generation+1 < NUM_GENERATIONS)
-        gcstate->generations[generation+1].count += 1;
-    for (i = 0; i <= generation; i++)
-        gcstate->generations[i].count = 0;
+/* A traversal callback for take_pending.  It stops the traversal of large
+ * containers when the slice is used up. */
+static int
+visit_pending(PyObject *op, struct pending_closure *closure)
+{
+    closure->work++;
+    if (_PyObject_IS_GC(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        if (gc_is_pending(gc)) {
+            gc_clear_pending(gc);
+            gc_list_move(gc, closure->increment);
+        }
+    }
+    return closure->work >= closure->slice;
+}
 
-    /* merge younger generations with one we are currently collecting */
-    for (i = 0; i < generation; i++) {
-        gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+/* Move objects from the pending list to 'increment', each followed by the
+ * pending objects it refers to, directly or not, until the slice of work is
+ * used up.  The work is the number of objects and references examined,
+ * which is also what the collection of the increment costs, so the objects
+ * which were pulled but not examined yet go back to the pending list.
+ * Return false if the pending list ran out first. */
+static int
+take_pending(GCState *gcstate, PyGC_Head *increment)
+{
+    PyGC_Head *pending = PENDING_HEAD(gcstate);
+    struct pending_closure closure = {increment, 0,
+                                      gcstate->incremental.slice};
+    /* The pulled objects are appended, so that this loop reaches them too */
+    PyGC_Head *gc = GC_PREV(increment);
+    while (closure.work < closure.slice) {
+        if (GC_NEXT(gc) == increment) {
+            if (gc_list_is_empty(pending)) {
+                return 0;
+            }
+            PyGC_Head *next = GC_NEXT(pending);
+            gc_clear_pending(next);
+            gc_list_move(next, increment);
+        }
+        gc = GC_NEXT(gc);
+        PyObject *op = FROM_GC(gc);
+        closure.work++;
+        (void) Py_TYPE(op)->tp_traverse(op, (visitproc)visit_pending,
+                                        &closure);
     }
+    PyGC_Head unexamined;
+    gc_list_init(&unexamined);
+    while (GC_NEXT(gc) != increment) {
+        PyGC_Head *next = GC_NEXT(gc);
+        gc_list_move(next, &unexamined);
+        gc_set_pending(next);
+    }
+    /* Put them first, to be taken by the next increment */
+    gc_list_merge(pending, &unexamined);
+    gc_list_merge(&unexamined, pending);
+    return 1;
+}
 
-    /* handy references */
-    young = GEN_HEAD(gcstate, generation);
-    if (generation < NUM_GENERATIONS-1)
-        old = GEN_HEAD(gcstate, generation+1);
-    else
-        old = young;
-    validate_list(old, collecting_clear_unreachable_clear);
+/* Adjust the slice so that the next increment takes about the budget */
+static void
+tune_slice(struct gc_incremental_state *inc, int used_up, _PyTime_t elapsed)
+{
+    double us = (double)_PyTime_AsMicroseconds(elapsed, _PyTime_ROUND_CEILING);
+    double slice = (double)inc->slice;
+    if (us > inc->budget) {
+        slice = slice * inc->budget / us;
+    }
+    else if (2 * us < inc->budget && used_up) {
+        slice = slice * 2;
+    }
+    inc->slice = (Py_ssize_t)Py_MAX(INCREMENTAL_MIN_SLICE,
+                                    Py_MIN(slice, INCREMENTAL_MAX_SLICE));
+}
 
-    deduce_unreachable(young, &unreachable);
+/* Start profiling a collection if profiling is enabled */
+static void
+profile_start(GCState *gcstate, int generation, int incremental)
+{
+    struct gc_profile_state *profile = &gcstate->profile;
+    if (profile->types == NULL) {
+        return;
+    }
+    _Py_hashtable_clear(profile->types);
+    profile->active = 1;
+    profile->generation = generation;
+    profile->incremental = incremental;
+    profile->weakref_time = 0;
+    profile->finalizer_time = 0;
+}
 
-    untrack_tuples(young);
-    /* Move reachable objects to next generation. */
-    if (young != old) {
-        if (generation == NUM_GENERATIONS - 2) {
-            gcstate->long_lived_pending += gc_list_size(young);
+static int
+add_type_profile(_Py_hashtable_t *ht, const void *key, const void *value,
+                 void *user_data)
+{
+    const struct gc_type_profile *type_profile = value;
+    PyObject *types = (PyObject *)user_data;
+    Py_ssize_t objects = type_profile->objects;
+    double traverse_time = _PyTime_AsSecondsDouble(type_profile->traverse_time);
+
+    PyObject *name = PyUnicode_DecodeUTF8(type_profile->name,
+                                          strlen(type_profile->name),
+                                          "replace");
+    if (name == NULL) {
+        return -1;
+    }
+    /* Distinct types may have the same name */
+    PyObject *prev = PyDict_GetItemWithError(types, name);
+    if (prev != NULL) {
+        PyObject *prev_objects = PyDict_GetItemString(prev, "objects");
+        PyObject *prev_time = PyDict_GetItemString(prev, "traverse_time");
+        assert(prev_objects != NULL && prev_time != NULL);
+        objects += PyLong_AsSsize_t(prev_objects);
+        traverse_time += PyFloat_AsDouble(prev_time);
+    }
+    else if (PyErr_Occurred()) {
+        Py_DECREF(name);
+        return -1;
+    }
+    PyObject *dict = Py_BuildValue("{snsd}",
+                                   "objects", objects,
+                                   "traverse_time", traverse_time);
+    if (dict == NULL) {
+        Py_DECREF(name);
+        return -1;
+    }
+    int res = PyDict_SetItem(types, name, dict);
+    Py_DECREF(name);
+    Py_DECREF(dict);
+    return res;
+}
+
+/* Finish profiling the collection: store the profile in a dict.  This runs
+ * while gcstate->collecting is set, so the table cannot change. */
+static void
+profile_finish(GCState *gcstate, Py_ssize_t examined, Py_ssize_t promoted,
+               _PyTime_t time)
+{
+    struct gc_profile_state *profile = &gcstate->profile;
+    if (!profile->active) {
+        return;
+    }
+    profile->active = 0;
+    PyObject *result = NULL;
+    PyObject *types = PyDict_New();
+    if (types != NULL) {
+        if (_Py_hashtable_foreach(profile->types, add_type_profile,
+                                  types) < 0) {
+            Py_CLEAR(types);
         }
-        gc_list_merge(young, old);
     }
-    else {
-        /* We only un-track dicts in full collections, to avoid quadratic
-           dict build-up. See issue #14775. */
-        untrack_dicts(young);
-        gcstate->long_lived_pending = 0;
-        gcstate->long_lived_total = gc_list_size(young);
+    if (types != NULL) {
+        result = Py_BuildValue(
+            "{sisOsnsnsdsdsdsN}",
+            "generation", profile->generation,
+            "incremental", profile->incremental ? Py_True : Py_False,
+            "examined", examined,
+            "promoted", promoted,
+            "time", _PyTime_AsSecondsDouble(time),
+            "weakref_time", _PyTime_AsSecondsDouble(profile->weakref_time),
+            "finalizer_time", _PyTime_AsSecondsDouble(profile->finalizer_time),
+            "types", types);
+    }
+    if (result == NULL) {
+        _PyErr_WriteUnraisableMsg("while profiling garbage collection", NULL);
     }
+    Py_XSETREF(profile->last, result);
+}
+
+/* The time, if the collection is profiled */
+static inline _PyTime_t
+profile_clock(GCState *gcstate)
+{
+    return gcstate->profile.active ? _PyTime_GetPerfCounter() : 0;
+}
+
+/* The table of the per-type profile, if the collection is profiled */
+static inline _Py_hashtable_t *
+profile_types(GCState *gcstate)
+{
+    return gcstate->profile.active ? gcstate->profile.types : NULL;
+}
+
+/* Delete the objects in 'unreachable', as left by deduce_unreachable(), and
+ * move those which turn out to be still alive to 'old'.  The numbers of
+ * collected and uncollectable objects are added to *n_collected and
+ * *n_uncollectable.
+ */
+static void
+delete_unreachable(PyThreadState *tstate, GCState *gcstate,
+                   PyGC_Head *unreachable, PyGC_Head *old,
+                   Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable)
+{
+    PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
+    PyGC_Head *gc;
+    struct gc_profile_state *profile = &gcstate->profile;
+    _PyTime_t t = profile_clock(gcstate);
 
     /* All objects in unreachable are trash, but objects reachable from
      * legacy finalizers (e.g. tp_del) can't safely be deleted.
@@ -1247,7 +1695,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
     gc_list_init(&finalizers);
     // NEXT_MASK_UNREACHABLE is cleared here.
     // After move_legacy_finalizers(), unreachable is normal list.
-    move_legacy_finalizers(&unreachable, &finalizers);
+    move_legacy_finalizers(unreachable, &finalizers);
     /* finalizers contains the unreachable objects with a legacy finalizer;
      * unreachable objects reachable *from* those are also uncollectable,
      * and we move those into the finalizers list too.
@@ -1255,92 +1703,389 @@ gc_collect_main(PyThreadState *tstate, int generation,
     move_legacy_finalizer_reachable(&finalizers);
 
     validate_list(&finalizers, collecting_clear_unreachable_clear);
-    validate_list(&unreachable, collecting_set_unreachable_clear);
+    validate_list(unreachable, collecting_set_unreachable_clear);
 
     /* Print debugging information. */
     if (gcstate->debug & DEBUG_COLLECTABLE) {
-        for (gc = GC_NEXT(&unreachable); gc != &unreachable; gc = GC_NEXT(gc)) {
+        for (gc = GC_NEXT(unreachable); gc != unreachable; gc = GC_NEXT(gc)) {
             debug_cycle("collectable", FROM_GC(gc));
         }
     }
 
+    _PyTime_t t2 = profile_clock(gcstate);
+    profile->finalizer_time += t2 - t;
+
     /* Clear weakrefs and invoke callbacks as necessary. */
-    m += handle_weakrefs(&unreachable, old);
+    *n_collected += handle_weakrefs(unreachable, old);
 
     validate_list(old, collecting_clear_unreachable_clear);
-    validate_list(&unreachable, collecting_set_unreachable_clear);
+    validate_list(unreachable, collecting_set_unreachable_clear);
+    t = profile_clock(gcstate);
+    profile->weakref_time += t - t2;
 
     /* Call tp_finalize on objects which have one. */
-    finalize_garbage(tstate, &unreachable);
+    finalize_garbage(tstate, unreachable);
 
     /* Handle any objects that may have resurrected after the call
      * to 'finalize_garbage' and continue the collection with the
      * objects that are still unreachable */
     PyGC_Head final_unreachable;
-    handle_resurrected_objects(&unreachable, &final_unreachable, old);
+    handle_resurrected_objects(unreachable, &final_unreachable, old);
+    t2 = profile_clock(gcstate);
+    profile->finalizer_time += t2 - t;
 
     /* Call tp_clear on objects in the final_unreachable set.  This will cause
     * the reference cycles to be broken.  It may also cause some objects
     * in finalizers to be freed.
     */
-    m += gc_list_size(&final_unreachable);
+    *n_collected += gc_list_size(&final_unreachable);
     delete_garbage(tstate, gcstate, &final_unreachable, old);
 
     /* Collect statistics on uncollectable objects found and print
      * debugging information. */
     for (gc = GC_NEXT(&finalizers); gc != &finalizers; gc = GC_NEXT(gc)) {
-        n++;
+        (*n_uncollectable)++;
         if (gcstate->debug & DEBUG_UNCOLLECTABLE)
             debug_cycle("uncollectable", FROM_GC(gc));
     }
-    if (gcstate->debug & DEBUG_STATS) {
-        double d = _PyTime_AsSecondsDouble(_PyTime_GetPerfCounter() - t1);
-        PySys_WriteStderr(
-            "gc: done, %zd unreachable, %zd uncollectable, %.4fs elapsed\n",
-            n+m, n, d);
-    }
 
     /* Append instances in the uncollectable set to a Python
      * reachable list of garbage.  The programmer has to deal with
      * this if they insist on creating this type of structure.
      */
+    t = profile_clock(gcstate);
     handle_legacy_finalizers(tstate, gcstate, &finalizers, old);
     validate_list(old, collecting_clear_unreachable_clear);
+    profile->finalizer_time += profile_clock(gcstate) - t;
+}
 
-    /* Clear free list only during the collection of the highest
-     * generation */
-    if (generation == NUM_GENERATIONS-1) {
-        clear_freelists(tstate->interp);
+/* The overhead is measured over a window of about this many seconds */
+#define ADAPTIVE_WINDOW _PyTime_FromSeconds(1)
+/* Adapted thresholds stay below this multiple of the user's ones */
+#define ADAPTIVE_MAX_FACTOR 64
+/* Survival ratios above which collections are mostly wasted, and below which
+   they are worth running more often */
+#define ADAPTIVE_HIGH_SURVIVAL 0.5
+#define ADAPTIVE_LOW_SURVIVAL 0.1
+
+/* Return the recent fraction of the time spent collecting */
+static double
+gc_overhead(struct gc_adaptive_state *adaptive)
+{
+    if (adaptive->total_time <= 0) {
+        return 0.0;
     }
+    return (double)adaptive->gc_time / (double)adaptive->total_time;
+}
 
-    if (_PyErr_Occurred(tstate)) {
-        if (nofail) {
-            _PyErr_Clear(tstate);
+/* Account for a collection which ran from start to end, examining
+   'examined' objects of which 'survivors' survived. */
+static void
+update_time_stats(GCState *gcstate, int generation,
+                  _PyTime_t start, _PyTime_t end,
+                  Py_ssize_t examined, Py_ssize_t survivors)
+{
+    struct gc_adaptive_state *adaptive = &gcstate->adaptive;
+    struct gc_generation_stats *stats = &gcstate->generation_stats[generation];
+    if (examined > 0) {
+        double survival = (double)survivors / examined;
+        if (stats->time == 0) {
+            stats->survival = survival;
         }
         else {
-            _PyErr_WriteUnraisableMsg("in garbage collection", NULL);
+            stats->survival = 0.75 * stats->survival + 0.25 * survival;
         }
     }
+    stats->time += end - start;
 
-    /* Update stats */
-    if (n_collected) {
-        *n_collected = m;
+    _PyTime_t elapsed = end - start;
+    if (adaptive->last_end != 0) {
+        elapsed = end - adaptive->last_end;
     }
-    if (n_uncollectable) {
-        *n_uncollectable = n;
+    adaptive->last_end = end;
+    adaptive->gc_time += end - start;
+    adaptive->total_time += elapsed;
+    /* Forget the past progressively */
+    while (adaptive->total_time > ADAPTIVE_WINDOW) {
+        adaptive->gc_time /= 2;
+        adaptive->total_time /= 2;
     }
+}
 
+/* Raise or lower the threshold of a generation after its collection, see
+   struct gc_adaptive_state. */
+static void
+adapt_threshold(GCState *gcstate, int generation)
+{
+    struct gc_adaptive_state *adaptive = &gcstate->adaptive;
     struct gc_generation_stats *stats = &gcstate->generation_stats[generation];
-    stats->collections++;
-    stats->collected += m;
-    stats->uncollectable += n;
-
-    if (PyDTrace_GC_DONE_ENABLED()) {
-        PyDTrace_GC_DONE(n + m);
+    int *threshold = &gcstate->generations[generation].threshold;
+    int base = adaptive->base_threshold[generation];
+    if (adaptive->target <= 0 || base <= 0) {
+        return;
     }
-
-    assert(!_PyErr_Occurred(tstate));
-    return n + m;
+    double overhead = gc_overhead(adaptive);
+    if (overhead > adaptive->target
+        && stats->survival >= ADAPTIVE_HIGH_SURVIVAL)
+    {
+        int64_t max = (int64_t)base * ADAPTIVE_MAX_FACTOR;
+        if (*threshold <= INT_MAX / 2 && 2 * (int64_t)*threshold <= max) {
+            *threshold *= 2;
+            stats->raised++;
+        }
+    }
+    else if ((2 * overhead < adaptive->target
+              || stats->survival < ADAPTIVE_LOW_SURVIVAL)
+             && *threshold > base)
+    {
+        *threshold = Py_MAX(*threshold / 2, base);
+        stats->lowered++;
+    }
+}
+
+/* This is the main function.  Read this to understand how the
+ * collection process works. */
+static Py_ssize_t
+gc_collect_main(PyThreadState *tstate, int generation,
+                Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
+                int nofail)
+{
+    int i;
+    Py_ssize_t m = 0; /* # objects collected */
+    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
+    PyGC_Head *young; /* the generation we are examining */
+    PyGC_Head *old; /* next older generation */
+    PyGC_Head unreachable; /* non-problematic unreachable trash */
+    GCState *gcstate = &tstate->interp->gc;
+
+    // gc_collect_main() must not be called before _PyGC_Init
+    // or after _PyGC_Fini()
+    assert(gcstate->garbage != NULL);
+    assert(!_PyErr_Occurred(tstate));
+
+    if (gcstate->debug & DEBUG_STATS) {
+        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
+        show_stats_each_generations(gcstate);
+    }
+    _PyTime_t t1 = _PyTime_GetPerfCounter();
+    profile_start(gcstate, generation, 0);
+
+    if (PyDTrace_GC_START_ENABLED())
+        PyDTrace_GC_START(generation);
+
+    /* update collection and allocation counters */
+    if (generation+1 < NUM_GENERATIONS)
+        gcstate->generations[generation+1].count += 1;
+    for (i = 0; i <= generation; i++)
+        gcstate->generations[i].count = 0;
+
+    /* merge younger generations with one we are currently collecting */
+    for (i = 0; i < generation; i++) {
+        gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+    }
+    if (generation == NUM_GENERATIONS-1) {
+        /* A full collection supersedes the incremental pass */
+        incremental_reset(gcstate);
+    }
+
+    /* handy references */
+    young = GEN_HEAD(gcstate, generation);
+    if (generation < NUM_GENERATIONS-1)
+        old = GEN_HEAD(gcstate, generation+1);
+    else
+        old = young;
+    validate_list(old, collecting_clear_unreachable_clear);
+
+    Py_ssize_t examined = deduce_unreachable(young, &unreachable,
+                                             gcstate->parallel,
+                                             profile_types(gcstate));
+
+    untrack_tuples(young);
+    Py_ssize_t survivors = gc_list_size(young);
+    Py_ssize_t promoted = 0;
+    /* Move reachable objects to next generation. */
+    if (young != old) {
+        promoted = survivors;
+        if (generation == NUM_GENERATIONS - 2) {
+            gcstate->long_lived_pending += survivors;
+        }
+        gc_list_merge(young, old);
+    }
+    else {
+        /* We only un-track dicts in full collections, to avoid quadratic
+           dict build-up. See issue #14775. */
+        untrack_dicts(young);
+        gcstate->long_lived_pending = 0;
+        gcstate->long_lived_total = gc_list_size(young);
+        gcstate->incremental.full_survivors = gcstate->long_lived_total;
+        gcstate->incremental.full_due = 0;
+    }
+
+    delete_unreachable(tstate, gcstate, &unreachable, old, &m, &n);
+
+    /* Clear free list only during the collection of the highest
+     * generation */
+    if (generation == NUM_GENERATIONS-1) {
+        clear_freelists(tstate->interp);
+    }
+
+    _PyTime_t t2 = _PyTime_GetPerfCounter();
+    if (gcstate->debug & DEBUG_STATS) {
+        double d = _PyTime_AsSecondsDouble(t2 - t1);
+        PySys_WriteStderr(
+            "gc: done, %zd unreachable, %zd uncollectable, %.4fs elapsed\n",
+            n+m, n, d);
+    }
+
+    if (_PyErr_Occurred(tstate)) {
+        if (nofail) {
+            _PyErr_Clear(tstate);
+        }
+        else {
+            _PyErr_WriteUnraisableMsg("in garbage collection", NULL);
+        }
+    }
+
+    /* Update stats */
+    if (n_collected) {
+        *n_collected = m;
+    }
+    if (n_uncollectable) {
+        *n_uncollectable = n;
+    }
+
+    struct gc_generation_stats *stats = &gcstate->generation_stats[generation];
+    stats->collections++;
+    stats->collected += m;
+    stats->uncollectable += n;
+    update_time_stats(gcstate, generation, t1, t2, examined, survivors);
+    adapt_threshold(gcstate, generation);
+    profile_finish(gcstate, examined, promoted, t2 - t1);
+
+    if (PyDTrace_GC_DONE_ENABLED()) {
+        PyDTrace_GC_DONE(n + m);
+    }
+
+    assert(!_PyErr_Occurred(tstate));
+    return n + m;
+}
+
+/* Collect the young generations together with an increment of the oldest
+ * one, see struct gc_incremental_state.  Like gc_collect_main(), but the
+ * collection statistics only count a generation 2 collection when the pass
+ * ends. */
+static Py_ssize_t
+gc_collect_increment(PyThreadState *tstate,
+                     Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable)
+{
+    Py_ssize_t m = 0; /* # objects collected */
+    Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
+    PyGC_Head increment; /* the objects we are examining */
+    PyGC_Head unreachable; /* non-problematic unreachable trash */
+    GCState *gcstate = &tstate->interp->gc;
+    struct gc_incremental_state *inc = &gcstate->incremental;
+    PyGC_Head *old = GEN_HEAD(gcstate, NUM_GENERATIONS-1);
+    _PyTime_t t1 = _PyTime_GetPerfCounter();
+
+    assert(gcstate->garbage != NULL);
+    assert(!_PyErr_Occurred(tstate));
+    assert(inc->budget > 0);
+
+    if (gcstate->debug & DEBUG_STATS) {
+        PySys_WriteStderr("gc: collecting an increment of generation %d...\n",
+                          NUM_GENERATIONS-1);
+        show_stats_each_generations(gcstate);
+    }
+
+    if (PyDTrace_GC_START_ENABLED())
+        PyDTrace_GC_START(NUM_GENERATIONS-1);
+    profile_start(gcstate, NUM_GENERATIONS-1, 1);
+
+    if (inc->phase == INCREMENTAL_IDLE) {
+        inc->phase = INCREMENTAL_ARMING;
+        inc->survivors = 0;
+    }
+
+    /* update collection and allocation counters */
+    gcstate->generations[NUM_GENERATIONS-1].count += 1;
+    gc_list_init(&increment);
+    for (int i = 0; i < NUM_GENERATIONS-1; i++) {
+        gcstate->generations[i].count = 0;
+        gc_list_merge(GEN_HEAD(gcstate, i), &increment);
+    }
+    Py_ssize_t young = gc_list_size(&increment);
+    int scanning = (inc->phase == INCREMENTAL_SCANNING);
+    int used_up = 0;
+    if (scanning) {
+        used_up = take_pending(gcstate, &increment);
+    }
+
+    Py_ssize_t examined = deduce_unreachable(&increment, &unreachable, 1,
+                                             profile_types(gcstate));
+    untrack_tuples(&increment);
+    Py_ssize_t survivors = gc_list_size(&increment);
+    if (scanning) {
+        inc->survivors += survivors;
+    }
+    gc_list_merge(&increment, old);
+
+    delete_unreachable(tstate, gcstate, &unreachable, old, &m, &n);
+
+    if (!scanning) {
+        /* Arm faster than the young generations are promoted, so that the
+           oldest generation is eventually empty */
+        if (arm_pending(gcstate, Py_MAX(inc->slice, 2 * young))) {
+            inc->phase = INCREMENTAL_SCANNING;
+        }
+    }
+    else if (gc_list_is_empty(PENDING_HEAD(gcstate))) {
+        /* The pass is over: it counts as a collection of the oldest
+           generation */
+        inc->phase = INCREMENTAL_IDLE;
+        gcstate->generations[NUM_GENERATIONS-1].count = 0;
+        gcstate->long_lived_pending = 0;
+        gcstate->long_lived_total = inc->survivors;
+        if (inc->survivors > 2 * inc->full_survivors) {
+            inc->full_due = 1;
+        }
+        gcstate->generation_stats[NUM_GENERATIONS-1].collections++;
+        clear_freelists(tstate->interp);
+    }
+
+    _PyTime_t t2 = _PyTime_GetPerfCounter();
+    _PyTime_t elapsed = t2 - t1;
+    update_time_stats(gcstate, NUM_GENERATIONS-1, t1, t2, examined, survivors);
+    profile_finish(gcstate, examined, survivors, elapsed);
+    if (scanning) {
+        tune_slice(inc, used_up, elapsed);
+    }
+    inc->increments++;
+    inc->total_time += elapsed;
+    inc->max_time = Py_MAX(inc->max_time, elapsed);
+    if (gcstate->debug & DEBUG_STATS) {
+        PySys_WriteStderr(
+            "gc: done, %zd unreachable, %zd uncollectable, %.4fs elapsed\n",
+            n+m, n, _PyTime_AsSecondsDouble(elapsed));
+    }
+
+    if (_PyErr_Occurred(tstate)) {
+        _PyErr_WriteUnraisableMsg("in garbage collection", NULL);
+    }
+
+    /* Update stats */
+    *n_collected = m;
+    *n_uncollectable = n;
+    struct gc_generation_stats *stats =
+        &gcstate->generation_stats[NUM_GENERATIONS-1];
+    stats->collected += m;
+    stats->uncollectable += n;
+
+    if (PyDTrace_GC_DONE_ENABLED()) {
+        PyDTrace_GC_DONE(n + m);
+    }
+
+    assert(!_PyErr_Occurred(tstate));
+    return n + m;
 }
 
 /* Invoke progress callbacks to notify clients that garbage collection
@@ -1348,7 +2093,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
  */
 static void
 invoke_gc_callback(PyThreadState *tstate, const char *phase,
-                   int generation, Py_ssize_t collected,
+                   int generation, int incremental, Py_ssize_t collected,
                    Py_ssize_t uncollectable)
 {
     assert(!_PyErr_Occurred(tstate));
@@ -1363,14 +2108,26 @@ invoke_gc_callback(PyThreadState *tstate, const char *phase,
     assert(PyList_CheckExact(gcstate->callbacks));
     PyObject *info = NULL;
     if (PyList_GET_SIZE(gcstate->callbacks) != 0) {
-        info = Py_BuildValue("{sisnsn}",
+        info = Py_BuildValue("{sisOsnsnsisd}",
             "generation", generation,
+            "incremental", incremental ? Py_True : Py_False,
             "collected", collected,
-            "uncollectable", uncollectable);
+            "uncollectable", uncollectable,
+            "threshold", gcstate->generations[generation].threshold,
+            "overhead", gc_overhead(&gcstate->adaptive));
         if (info == NULL) {
             PyErr_WriteUnraisable(NULL);
             return;
         }
+        if (strcmp(phase, "stop") == 0 && gcstate->profile.types != NULL
+            && gcstate->profile.last != NULL
+            && PyDict_SetItemString(info, "profile",
+                                    gcstate->profile.last) < 0)
+        {
+            Py_DECREF(info);
+            PyErr_WriteUnraisable(NULL);
+            return;
+        }
     }
     for (Py_ssize_t i=0; i<PyList_GET_SIZE(gcstate->callbacks); i++) {
         PyObject *r, *cb = PyList_GET_ITEM(gcstate->callbacks, i);
@@ -1396,9 +2153,24 @@ gc_collect_with_callback(PyThreadState *tstate, int generation)
 {
     assert(!_PyErr_Occurred(tstate));
     Py_ssize_t result, collected, uncollectable;
-    invoke_gc_callback(tstate, "start", generation, 0, 0);
+    invoke_gc_callback(tstate, "start", generation, 0, 0, 0);
     result = gc_collect_main(tstate, generation, &collected, &uncollectable, 0);
-    invoke_gc_callback(tstate, "stop", generation, collected, uncollectable);
+    invoke_gc_callback(tstate, "stop", generation, 0,
+                       collected, uncollectable);
+    assert(!_PyErr_Occurred(tstate));
+    return result;
+}
+
+/* Perform an incremental collection and invoke progress callbacks. */
+static Py_ssize_t
+gc_collect_increment_with_callback(PyThreadState *tstate)
+{
+    assert(!_PyErr_Occurred(tstate));
+    Py_ssize_t result, collected, uncollectable;
+    invoke_gc_callback(tstate, "start", NUM_GENERATIONS-1, 1, 0, 0);
+    result = gc_collect_increment(tstate, &collected, &uncollectable);
+    invoke_gc_callback(tstate, "stop", NUM_GENERATIONS-1, 1,
+                       collected, uncollectable);
     assert(!_PyErr_Occurred(tstate));
     return result;
 }
@@ -1449,9 +2221,21 @@ gc_collect_generations(PyThreadState *tstate)
                June 2008. His original analysis and proposal can be found at:
                http://mail.python.org/pipermail/python-dev/2008-June/080579.html
             */
+            struct gc_incremental_state *inc = &gcstate->incremental;
             if (i == NUM_GENERATIONS - 1
+                && !inc->full_due
                 && gcstate->long_lived_pending < gcstate->long_lived_total / 4)
                 continue;
+            /* In incremental mode, the collections which would be full are
+               replaced by increments, and so are the collections of the
+               middle generation while a pass is in progress. */
+            if (inc->budget > 0 && i > 0 && !inc->full_due
+                && (i == NUM_GENERATIONS - 1
+                    || inc->phase != INCREMENTAL_IDLE))
+            {
+                n = gc_collect_increment_with_callback(tstate);
+                break;
+            }
             n = gc_collect_with_callback(tstate, i);
             break;
         }
@@ -1601,6 +2385,10 @@ gc_set_threshold(PyObject *self, PyObject *args)
         /* generations higher than 2 get the same threshold */
         gcstate->generations[i].threshold = gcstate->generations[2].threshold;
     }
+    /* The adaptive policy starts again from the new thresholds */
+    for (int i = 0; i < NUM_GENERATIONS; i++) {
+        gcstate->adaptive.base_threshold[i] = gcstate->generations[i].threshold;
+    }
     Py_RETURN_NONE;
 }
 
@@ -1638,6 +2426,216 @@ gc_get_count_impl(PyObject *module)
                          gcstate->generations[2].count);
 }
 
+/*[clinic input]
+gc.set_incremental
+
+    budget: Py_ssize_t
+    /
+
+Set the time budget of incremental collections, in microseconds.
+
+If budget is positive, the collections of the oldest generation are made of
+increments interleaved with the program, each taking about budget
+microseconds.  Zero disables incremental collection.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_incremental_impl(PyObject *module, Py_ssize_t budget)
+/*[clinic end generated code: output=eb3596ce342d7b32 input=72716b352dc5ba87]*/
+{
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError, "budget must be non-negative");
+        return NULL;
+    }
+    GCState *gcstate = get_gc_state();
+    struct gc_incremental_state *inc = &gcstate->incremental;
+    if (budget == 0) {
+        incremental_reset(gcstate);
+    }
+    else if (inc->slice == 0) {
+        inc->slice = INCREMENTAL_MIN_SLICE;
+    }
+    inc->budget = budget;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_incremental -> Py_ssize_t
+
+Return the time budget of incremental collections, in microseconds.
+
+Zero means that incremental collection is disabled.
+[clinic start generated code]*/
+
+static Py_ssize_t
+gc_get_incremental_impl(PyObject *module)
+/*[clinic end generated code: output=5028249752fdc310 input=b3ec0333bd4b1518]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->incremental.budget;
+}
+
+/*[clinic input]
+gc.set_adaptive
+
+    max_overhead: double
+    /
+
+Adapt the collection thresholds to keep the collection overhead low.
+
+max_overhead is the highest percentage of the time to spend collecting.
+While collections take more than that, the thresholds of the generations
+whose collections mostly promote their objects are raised, up to 64 times
+the thresholds set by set_threshold(); they are lowered back when the
+overhead drops.  Zero disables the policy and restores the thresholds.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_adaptive_impl(PyObject *module, double max_overhead)
+/*[clinic end generated code: output=dd084fb6187cbae0 input=ebcce9fa2f7467d7]*/
+{
+    if (!(max_overhead >= 0.0 && max_overhead <= 100.0)) {
+        PyErr_SetString(PyExc_ValueError,
+                        "max_overhead must be between 0 and 100");
+        return NULL;
+    }
+    GCState *gcstate = get_gc_state();
+    struct gc_adaptive_state *adaptive = &gcstate->adaptive;
+    for (int i = 0; i < NUM_GENERATIONS; i++) {
+        if (adaptive->target > 0) {
+            gcstate->generations[i].threshold = adaptive->base_threshold[i];
+        }
+        else {
+            adaptive->base_threshold[i] = gcstate->generations[i].threshold;
+        }
+    }
+    adaptive->target = max_overhead / 100.0;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_adaptive -> double
+
+Return the highest percentage of the time to spend collecting.
+
+Zero means that the collection thresholds are not adapted.
+[clinic start generated code]*/
+
+static double
+gc_get_adaptive_impl(PyObject *module)
+/*[clinic end generated code: output=cdf097b6f2a38cef input=bd9137c705849e69]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->adaptive.target * 100.0;
+}
+
+/*[clinic input]
+gc.set_parallel
+
+    nthreads: int
+    /
+
+Set the number of threads used by large collections.
+
+The internal references of the objects of collections larger than about
+65000 objects are subtracted by nthreads threads, including the collecting
+one.  The other phases of the collection stay sequential.  1 disables
+parallel collection.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_parallel_impl(PyObject *module, int nthreads)
+/*[clinic end generated code: output=1bacc71f0882fbdf input=adffd291f22abad5]*/
+{
+    if (nthreads < 1) {
+        PyErr_SetString(PyExc_ValueError, "nthreads must be at least 1");
+        return NULL;
+    }
+    GCState *gcstate = get_gc_state();
+    gcstate->parallel = nthreads;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_parallel -> int
+
+Return the number of threads used by large collections.
+[clinic start generated code]*/
+
+static int
+gc_get_parallel_impl(PyObject *module)
+/*[clinic end generated code: output=5b8b3265d5cdfb34 input=a12decf691133889]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->parallel;
+}
+
+static void
+free_type_profile(void *profile)
+{
+    PyMem_Free(profile);
+}
+
+/*[clinic input]
+gc.set_profile
+
+    enabled: bool
+    /
+
+Enable or disable the profiling of collections.
+
+When profiling is enabled, get_profile() returns the profile of the last
+collection, also passed to the callbacks as the "profile" item of their info.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_profile_impl(PyObject *module, int enabled)
+/*[clinic end generated code: output=e5f5bbda3ad95153 input=41a1b8fd5b083735]*/
+{
+    GCState *gcstate = get_gc_state();
+    struct gc_profile_state *profile = &gcstate->profile;
+    if (enabled && profile->types == NULL) {
+        profile->types = _Py_hashtable_new_full(_Py_hashtable_hash_ptr,
+                                                _Py_hashtable_compare_direct,
+                                                NULL, free_type_profile,
+                                                NULL);
+        if (profile->types == NULL) {
+            return PyErr_NoMemory();
+        }
+    }
+    else if (!enabled && profile->types != NULL) {
+        _Py_hashtable_destroy(profile->types);
+        profile->types = NULL;
+        profile->active = 0;
+        Py_CLEAR(profile->last);
+    }
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_profile
+
+Return the profile of the last collection as a dict.
+
+The dict contains the generation collected, whether the collection was
+incremental, the numbers of objects examined and promoted to an older
+generation, the times spent in the collection, handling weak references and
+handling finalizers, and, in "types", the number of objects of each type and
+the time spent traversing them.  Return None if no collection was profiled
+since profiling was enabled.
+[clinic start generated code]*/
+
+static PyObject *
+gc_get_profile_impl(PyObject *module)
+/*[clinic end generated code: output=123f9c323d9b1774 input=e4c4d1d115872de4]*/
+{
+    GCState *gcstate = get_gc_state();
+    if (gcstate->profile.last == NULL) {
+        Py_RETURN_NONE;
+    }
+    return Py_NewRef(gcstate->profile.last);
+}
+
 static int
 referrersvisit(PyObject* obj, PyObject *objs)
 {
@@ -1690,6 +2688,10 @@ gc_get_referrers(PyObject *self, PyObject *args)
             return NULL;
         }
     }
+    if (!(gc_referrers_for(args, PENDING_HEAD(gcstate), result))) {
+        Py_DECREF(result);
+        return NULL;
+    }
     return result;
 }
 
@@ -1781,6 +2783,12 @@ gc_get_objects_impl(PyObject *module, Py_ssize_t generation)
         if (append_objects(result, GEN_HEAD(gcstate, generation))) {
             goto error;
         }
+        /* The pending objects of an incremental collection are still
+           part of the oldest generation */
+        if (generation == NUM_GENERATIONS-1
+            && append_objects(result, PENDING_HEAD(gcstate))) {
+            goto error;
+        }
 
         return result;
     }
@@ -1791,6 +2799,9 @@ gc_get_objects_impl(PyObject *module, Py_ssize_t generation)
             goto error;
         }
     }
+    if (append_objects(result, PENDING_HEAD(gcstate))) {
+        goto error;
+    }
     return result;
 
 error:
@@ -1811,12 +2822,16 @@ gc_get_stats_impl(PyObject *module)
     int i;
     struct gc_generation_stats stats[NUM_GENERATIONS], *st;
 
+    int thresholds[NUM_GENERATIONS];
+
     /* To get consistent values despite allocations while constructing
        the result list, we use a snapshot of the running stats. */
     GCState *gcstate = get_gc_state();
     for (i = 0; i < NUM_GENERATIONS; i++) {
         stats[i] = gcstate->generation_stats[i];
+        thresholds[i] = gcstate->generations[i].threshold;
     }
+    struct gc_incremental_state inc = gcstate->incremental;
 
     PyObject *result = PyList_New(0);
     if (result == NULL)
@@ -1825,11 +2840,35 @@ gc_get_stats_impl(PyObject *module)
     for (i = 0; i < NUM_GENERATIONS; i++) {
         PyObject *dict;
         st = &stats[i];
-        dict = Py_BuildValue("{snsnsn}",
-                             "collections", st->collections,
-                             "collected", st->collected,
-                             "uncollectable", st->uncollectable
-                            );
+        if (i == NUM_GENERATIONS-1) {
+            dict = Py_BuildValue("{snsnsnsdsdsisnsnsnsdsd}",
+                                 "collections", st->collections,
+                                 "collected", st->collected,
+                                 "uncollectable", st->uncollectable,
+                                 "time", _PyTime_AsSecondsDouble(st->time),
+                                 "survival", st->survival,
+                                 "threshold", thresholds[i],
+                                 "threshold_raised", st->raised,
+                                 "threshold_lowered", st->lowered,
+                                 "increments", inc.increments,
+                                 "increment_time",
+                                 _PyTime_AsSecondsDouble(inc.total_time),
+                                 "max_increment_time",
+                                 _PyTime_AsSecondsDouble(inc.max_time)
+                                );
+        }
+        else {
+            dict = Py_BuildValue("{snsnsnsdsdsisnsn}",
+                                 "collections", st->collections,
+                                 "collected", st->collected,
+                                 "uncollectable", st->uncollectable,
+                                 "time", _PyTime_AsSecondsDouble(st->time),
+                                 "survival", st->survival,
+                                 "threshold", thresholds[i],
+                                 "threshold_raised", st->raised,
+                                 "threshold_lowered", st->lowered
+                                );
+        }
         if (dict == NULL)
             goto error;
         if (PyList_Append(result, dict)) {
@@ -1893,22 +2932,33 @@ gc_is_finalized(PyObject *module, PyObject *obj)
 /*[clinic input]
 gc.freeze
 
+    *
+    isolate: bool = False
+
 Freeze all current tracked objects and ignore them for future collections.
 
 This can be used before a POSIX fork() call to make the gc copy-on-write friendly.
 Note: collection before a POSIX fork() call may free pages for future allocation
 which can cause copy-on-write.
+
+If isolate is true, the memory left free next to the objects allocated so far
+is not reused for new objects, so that the objects allocated after a fork()
+do not share pages with the frozen ones.
 [clinic start generated code]*/
 
 static PyObject *
-gc_freeze_impl(PyObject *module)
-/*[clinic end generated code: output=502159d9cdc4c139 input=b602b16ac5febbe5]*/
+gc_freeze_impl(PyObject *module, int isolate)
+/*[clinic end generated code: output=29a6e73118049782 input=9c6ed5588435dc40]*/
 {
     GCState *gcstate = get_gc_state();
+    incremental_reset(gcstate);
     for (int i = 0; i < NUM_GENERATIONS; ++i) {
         gc_list_merge(GEN_HEAD(gcstate, i), &gcstate->permanent_generation.head);
         gcstate->generations[i].count = 0;
     }
+    if (isolate) {
+        (void)_PyObject_RetireUsedPools();
+    }
     Py_RETURN_NONE;
 }
 
@@ -1958,6 +3008,14 @@ PyDoc_STRVAR(gc__doc__,
 "get_debug() -- Get debugging flags.\n"
 "set_threshold() -- Set the collection thresholds.\n"
 "get_threshold() -- Return the current the collection thresholds.\n"
+"set_incremental() -- Set the time budget of incremental collections.\n"
+"get_incremental() -- Return the time budget of incremental collections.\n"
+"set_adaptive() -- Set the highest share of the time to spend collecting.\n"
+"get_adaptive() -- Return the highest share of the time to spend collecting.\n"
+"set_parallel() -- Set the number of threads used by large collections.\n"
+"get_parallel() -- Return the number of threads used by large collections.\n"
+"set_profile() -- Enable or disable the profiling of collections.\n"
+"get_profile() -- Return the profile of the last collection.\n"
 "get_objects() -- Return a list of all objects tracked by the collector.\n"
 "is_tracked() -- Returns true if a given object is tracked.\n"
 "is_finalized() -- Returns true if a given object has been already finalized.\n"
@@ -1976,6 +3034,14 @@ static PyMethodDef GcMethods[] = {
     GC_GET_COUNT_METHODDEF
     {"set_threshold",  gc_set_threshold, METH_VARARGS, gc_set_thresh__doc__},
     GC_GET_THRESHOLD_METHODDEF
+    GC_SET_INCREMENTAL_METHODDEF
+    GC_GET_INCREMENTAL_METHODDEF
+    GC_SET_ADAPTIVE_METHODDEF
+    GC_GET_ADAPTIVE_METHODDEF
+    GC_SET_PARALLEL_METHODDEF
+    GC_GET_PARALLEL_METHODDEF
+    GC_SET_PROFILE_METHODDEF
+    GC_GET_PROFILE_METHODDEF
     GC_COLLECT_METHODDEF
     GC_GET_OBJECTS_METHODDEF
     GC_GET_STATS_METHODDEF
@@ -2173,6 +3239,11 @@ _PyGC_Fini(PyInterpreterState *interp)
     GCState *gcstate = &interp->gc;
     Py_CLEAR(gcstate->garbage);
     Py_CLEAR(gcstate->callbacks);
+    if (gcstate->profile.types != NULL) {
+        _Py_hashtable_destroy(gcstate->profile.types);
+        gcstate->profile.types = NULL;
+    }
+    Py_CLEAR(gcstate->profile.last);
 
     if (!_Py_IsMainInterpreter(interp)) {
         // bpo-46070: Explicitly untrack all objects currently tracked by the
@@ -2184,6 +3255,7 @@ _PyGC_Fini(PyInterpreterState *interp)
             PyGC_Head *gen = GEN_HEAD(gcstate, i);
             gc_fini_untrack(gen);
         }
+        gc_fini_untrack(PENDING_HEAD(gcstate));
     }
 }
 
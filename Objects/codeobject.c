@@ -6,6 +6,7 @@
 #include "pycore_code.h"          // _PyCodeConstructor
 #include "pycore_interp.h"        // PyInterpreterState.co_extra_freefuncs
 #include "pycore_opcode.h"        // _PyOpcode_Deopt
+#include "pycore_optimizer.h"     // _PyCode_ClearExecutors()
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
 #include "pycore_tuple.h"         // _PyTuple_ITEMS()
 #include "clinic/codeobject.c.h"
@@ -335,8 +336,10 @@ init_code(PyCodeObject *co, struct _PyCodeConstructor *con)
     co->co_weakreflist = NULL;
     co->co_extra = NULL;
     co->_co_code = NULL;
+    co->_co_executors = NULL;
 
     co->co_warmup = QUICKENING_INITIAL_WARMUP_VALUE;
+    co->co_optimizer_warmup = OPTIMIZER_WARMUP;
     memcpy(_PyCode_CODE(co), PyBytes_AS_STRING(con->code),
            PyBytes_GET_SIZE(con->code));
 }
@@ -1538,6 +1541,7 @@ code_dealloc(PyCodeObject *co)
     Py_XDECREF(co->co_linetable);
     Py_XDECREF(co->co_exceptiontable);
     Py_XDECREF(co->_co_code);
+    _PyCode_ClearExecutors(co);
     if (co->co_weakreflist != NULL) {
         PyObject_ClearWeakRefs((PyObject*)co);
     }
@@ -2091,6 +2095,8 @@ _PyStaticCode_Dealloc(PyCodeObject *co)
     }
     deopt_code(_PyCode_CODE(co), Py_SIZE(co));
     co->co_warmup = QUICKENING_INITIAL_WARMUP_VALUE;
+    co->co_optimizer_warmup = OPTIMIZER_WARMUP;
+    _PyCode_ClearExecutors(co);
     PyMem_Free(co->co_extra);
     Py_CLEAR(co->_co_code);
     co->co_extra = NULL;
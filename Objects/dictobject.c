@@ -254,32 +254,83 @@ get_dict_state(void)
 #endif
 
 
-void
-_PyDict_ClearFreeList(PyInterpreterState *interp)
-{
 #if PyDict_MAXFREELIST > 0
-    struct _Py_dict_state *state = &interp->dict_state;
-    while (state->numfree) {
+static void
+clear_freelist(struct _Py_dict_state *state, int limit)
+{
+    while (state->numfree > limit) {
         PyDictObject *op = state->free_list[--state->numfree];
         assert(PyDict_CheckExact(op));
         PyObject_GC_Del(op);
     }
-    while (state->keys_numfree) {
+}
+
+static void
+clear_keys_freelist(struct _Py_dict_state *state, int limit)
+{
+    while (state->keys_numfree > limit) {
         PyObject_Free(state->keys_free_list[--state->keys_numfree]);
     }
+}
+#endif
+
+void
+_PyDict_ClearFreeList(PyInterpreterState *interp)
+{
+#if PyDict_MAXFREELIST > 0
+    struct _Py_dict_state *state = &interp->dict_state;
+    clear_freelist(state, 0);
+    clear_keys_freelist(state, 0);
 #endif
 }
 
+int
+_PyDict_SetFreeListLimit(PyInterpreterState *interp, int keys, int limit)
+{
+#if PyDict_MAXFREELIST > 0
+    struct _Py_dict_state *state = &interp->dict_state;
+    void *array;
+    if (keys) {
+        clear_keys_freelist(state, limit);
+        array = PyMem_RawRealloc(state->keys_free_list,
+                                 limit * sizeof(PyDictKeysObject *));
+        if (array == NULL) {
+            return -1;
+        }
+        state->keys_free_list = array;
+        state->keys_info.limit = limit;
+    }
+    else {
+        clear_freelist(state, limit);
+        array = PyMem_RawRealloc(state->free_list,
+                                 limit * sizeof(PyDictObject *));
+        if (array == NULL) {
+            return -1;
+        }
+        state->free_list = array;
+        state->info.limit = limit;
+    }
+#endif
+    return 0;
+}
 
 void
 _PyDict_Fini(PyInterpreterState *interp)
 {
     _PyDict_ClearFreeList(interp);
-#if defined(Py_DEBUG) && PyDict_MAXFREELIST > 0
+#if PyDict_MAXFREELIST > 0
     struct _Py_dict_state *state = &interp->dict_state;
+    PyMem_RawFree(state->free_list);
+    state->free_list = NULL;
+    state->info.limit = 0;
+    PyMem_RawFree(state->keys_free_list);
+    state->keys_free_list = NULL;
+    state->keys_info.limit = 0;
+#ifdef Py_DEBUG
     state->numfree = -1;
     state->keys_numfree = -1;
 #endif
+#endif
 }
 
 static inline Py_hash_t
@@ -622,13 +673,18 @@ new_keys_object(uint8_t log2_size, bool unicode)
     // new_keys_object() must not be called after _PyDict_Fini()
     assert(state->keys_numfree != -1);
 #endif
-    if (log2_size == PyDict_LOG_MINSIZE && unicode && state->keys_numfree > 0) {
+    int use_freelist = (log2_size == PyDict_LOG_MINSIZE && unicode);
+    if (use_freelist && state->keys_numfree > 0) {
         dk = state->keys_free_list[--state->keys_numfree];
+        state->keys_info.hits++;
         OBJECT_STAT_INC(from_freelist);
     }
     else
 #endif
     {
+#if PyDict_MAXFREELIST > 0
+        state->keys_info.misses += use_freelist;
+#endif
         dk = PyObject_Malloc(sizeof(PyDictKeysObject)
                              + ((size_t)1 << log2_bytes)
                              + entry_size * usable);
@@ -679,7 +735,7 @@ free_keys_object(PyDictKeysObject *keys)
     assert(state->keys_numfree != -1);
 #endif
     if (DK_LOG_SIZE(keys) == PyDict_LOG_MINSIZE
-            && state->keys_numfree < PyDict_MAXFREELIST
+            && state->keys_numfree < state->keys_info.limit
             && DK_IS_UNICODE(keys)) {
         state->keys_free_list[state->keys_numfree++] = keys;
         OBJECT_STAT_INC(to_freelist);
@@ -728,12 +784,16 @@ new_dict(PyDictKeysObject *keys, PyDictValues *values, Py_ssize_t used, int free
         mp = state->free_list[--state->numfree];
         assert (mp != NULL);
         assert (Py_IS_TYPE(mp, &PyDict_Type));
+        state->info.hits++;
         OBJECT_STAT_INC(from_freelist);
         _Py_NewReference((PyObject *)mp);
     }
     else
 #endif
     {
+#if PyDict_MAXFREELIST > 0
+        state->info.misses++;
+#endif
         mp = PyObject_GC_New(PyDictObject, &PyDict_Type);
         if (mp == NULL) {
             dictkeys_decref(keys);
@@ -1544,7 +1604,7 @@ dictresize(PyDictObject *mp, uint8_t log2_newsize, int unicode)
 #endif
             if (DK_LOG_SIZE(oldkeys) == PyDict_LOG_MINSIZE &&
                     DK_IS_UNICODE(oldkeys) &&
-                    state->keys_numfree < PyDict_MAXFREELIST)
+                    state->keys_numfree < state->keys_info.limit)
             {
                 state->keys_free_list[state->keys_numfree++] = oldkeys;
                 OBJECT_STAT_INC(to_freelist);
@@ -2383,7 +2443,7 @@ dict_dealloc(PyDictObject *mp)
     // new_dict() must not be called after _PyDict_Fini()
     assert(state->numfree != -1);
 #endif
-    if (state->numfree < PyDict_MAXFREELIST && Py_IS_TYPE(mp, &PyDict_Type)) {
+    if (state->numfree < state->info.limit && Py_IS_TYPE(mp, &PyDict_Type)) {
         state->free_list[state->numfree++] = mp;
         OBJECT_STAT_INC(to_freelist);
     }
@@ -5685,10 +5745,13 @@ uint32_t _PyDictKeys_GetVersionForCurrentState(PyDictKeysObject *dictkeys)
     if (dictkeys->dk_version != 0) {
         return dictkeys->dk_version;
     }
-    if (next_dict_keys_version == 0) {
-        return 0;
+    /* The versions are unique across the interpreters */
+    int locked = _PyRuntimeState_LockObjects(&_PyRuntime);
+    uint32_t v = next_dict_keys_version;
+    if (v != 0) {
+        next_dict_keys_version++;
+        dictkeys->dk_version = v;
     }
-    uint32_t v = next_dict_keys_version++;
-    dictkeys->dk_version = v;
+    _PyRuntimeState_UnlockObjects(&_PyRuntime, locked);
     return v;
 }
@@ -141,11 +141,15 @@ PyFloat_FromDouble(double fval)
 #endif
         state->free_list = (PyFloatObject *) Py_TYPE(op);
         state->numfree--;
+        state->info.hits++;
         OBJECT_STAT_INC(from_freelist);
     }
     else
 #endif
     {
+#if PyFloat_MAXFREELIST > 0
+        state->info.misses++;
+#endif
         op = PyObject_Malloc(sizeof(PyFloatObject));
         if (!op) {
             return PyErr_NoMemory();
@@ -250,7 +254,7 @@ _PyFloat_ExactDealloc(PyObject *obj)
     // float_dealloc() must not be called after _PyFloat_Fini()
     assert(state->numfree != -1);
 #endif
-    if (state->numfree >= PyFloat_MAXFREELIST)  {
+    if (state->numfree >= state->info.limit)  {
         PyObject_Free(op);
         return;
     }
@@ -2016,6 +2020,22 @@ _PyFloat_ClearFreeList(PyInterpreterState *interp)
 #endif
 }
 
+int
+_PyFloat_SetFreeListLimit(PyInterpreterState *interp, int limit)
+{
+#if PyFloat_MAXFREELIST > 0
+    struct _Py_float_state *state = &interp->float_state;
+    while (state->numfree > limit) {
+        PyFloatObject *f = state->free_list;
+        state->free_list = (PyFloatObject*) Py_TYPE(f);
+        state->numfree--;
+        PyObject_Free(f);
+    }
+    state->info.limit = limit;
+#endif
+    return 0;
+}
+
 void
 _PyFloat_Fini(PyInterpreterState *interp)
 {
@@ -7,6 +7,7 @@
 #include "pycore_moduleobject.h"  // _PyModule_GetDict()
 #include "pycore_object.h"        // _PyObject_GC_UNTRACK()
 #include "pycore_opcode.h"        // _PyOpcode_Caches
+#include "pycore_optimizer.h"     // _PyCode_InvalidateExecutors()
 
 #include "frameobject.h"          // PyFrameObject
 #include "pycore_frame.h"
@@ -246,7 +247,7 @@ mark_stacks(PyCodeObject *code_obj, int len)
                     stacks[i+1] = next_stack;
                     break;
                 case SEND:
-                    j = get_arg(code, i) + i + 1;
+                    j = get_arg(code, i) + 1 + INLINE_CACHE_ENTRIES_SEND + i;
                     assert(j < len);
                     assert(stacks[j] == UNINITIALIZED || stacks[j] == pop_value(next_stack));
                     stacks[j] = pop_value(next_stack);
@@ -278,7 +279,7 @@ mark_stacks(PyCodeObject *code_obj, int len)
                 {
                     int64_t target_stack = pop_value(next_stack);
                     stacks[i+1] = push_value(next_stack, Object);
-                    j = get_arg(code, i) + i + 1;
+                    j = get_arg(code, i) + 1 + INLINE_CACHE_ENTRIES_FOR_ITER + i;
                     assert(j < len);
                     assert(stacks[j] == UNINITIALIZED || stacks[j] == target_stack);
                     stacks[j] = target_stack;
@@ -461,27 +462,31 @@ add_load_fast_null_checks(PyCodeObject *co)
     int changed = 0;
     _Py_CODEUNIT *instructions = _PyCode_CODE(co);
     for (Py_ssize_t i = 0; i < Py_SIZE(co); i++) {
-        switch (_Py_OPCODE(instructions[i])) {
-            case LOAD_FAST:
-            case LOAD_FAST__LOAD_FAST:
-            case LOAD_FAST__LOAD_CONST:
-                changed = 1;
-                _Py_SET_OPCODE(instructions[i], LOAD_FAST_CHECK);
-                break;
-            case LOAD_CONST__LOAD_FAST:
-                changed = 1;
-                _Py_SET_OPCODE(instructions[i], LOAD_CONST);
-                break;
-            case STORE_FAST__LOAD_FAST:
-                changed = 1;
-                _Py_SET_OPCODE(instructions[i], STORE_FAST);
-                break;
+        int opcode = _Py_OPCODE(instructions[i]);
+        if (opcode != LOAD_FAST &&
+            !_PyOpcode_SuperinstructionSecond[opcode])
+        {
+            continue;
+        }
+        // Superinstructions skip the NULL check of any LOAD_FAST they
+        // contain, so split them back into their first instruction.
+        int first = _PyOpcode_Deopt[opcode];
+        int second = _PyOpcode_SuperinstructionSecond[opcode];
+        if (first == LOAD_FAST) {
+            changed = 1;
+            _Py_SET_OPCODE(instructions[i], LOAD_FAST_CHECK);
+        }
+        else if (second == LOAD_FAST) {
+            changed = 1;
+            _Py_SET_OPCODE(instructions[i], first);
         }
     }
     if (changed) {
         // invalidate cached co_code object
         Py_CLEAR(co->_co_code);
     }
+    // Optimized loops skip the NULL checks as well.
+    _PyCode_InvalidateExecutors(co);
 }
 
 /* Setter for f_lineno - you can set f_lineno from within a trace function in
@@ -134,11 +134,14 @@ uint32_t _PyFunction_GetVersionForCurrentState(PyFunctionObject *func)
     if (func->func_version != 0) {
         return func->func_version;
     }
-    if (next_func_version == 0) {
-        return 0;
-    }
-    uint32_t v = next_func_version++;
-    func->func_version = v;
+    /* The versions are unique across the interpreters */
+    int locked = _PyRuntimeState_LockObjects(&_PyRuntime);
+    uint32_t v = next_func_version;
+    if (v != 0) {
+        next_func_version++;
+        func->func_version = v;
+    }
+    _PyRuntimeState_UnlockObjects(&_PyRuntime, locked);
     return v;
 }
 
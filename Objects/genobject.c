@@ -150,6 +150,33 @@ gen_dealloc(PyGenObject *gen)
     PyObject_GC_Del(gen);
 }
 
+/* Called with an exception set that has escaped from the frame of `gen`.
+ * StopIteration (and StopAsyncIteration for async generators) must not
+ * propagate out of a generator: replace it with a RuntimeError (PEP 479). */
+void
+_PyGen_ConvertStopIteration(PyGenObject *gen)
+{
+    if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
+        const char *msg = "generator raised StopIteration";
+        if (PyCoro_CheckExact(gen)) {
+            msg = "coroutine raised StopIteration";
+        }
+        else if (PyAsyncGen_CheckExact(gen)) {
+            msg = "async generator raised StopIteration";
+        }
+        _PyErr_FormatFromCause(PyExc_RuntimeError, "%s", msg);
+    }
+    else if (PyAsyncGen_CheckExact(gen) &&
+            PyErr_ExceptionMatches(PyExc_StopAsyncIteration))
+    {
+        /* code in `gen` raised a StopAsyncIteration error:
+           raise a RuntimeError.
+        */
+        const char *msg = "async generator raised StopAsyncIteration";
+        _PyErr_FormatFromCause(PyExc_RuntimeError, "%s", msg);
+    }
+}
+
 static PySendResult
 gen_send_ex2(PyGenObject *gen, PyObject *arg, PyObject **presult,
              int exc, int closing)
@@ -247,25 +274,7 @@ gen_send_ex2(PyGenObject *gen, PyObject *arg, PyObject **presult,
         }
     }
     else {
-        if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
-            const char *msg = "generator raised StopIteration";
-            if (PyCoro_CheckExact(gen)) {
-                msg = "coroutine raised StopIteration";
-            }
-            else if (PyAsyncGen_CheckExact(gen)) {
-                msg = "async generator raised StopIteration";
-            }
-            _PyErr_FormatFromCause(PyExc_RuntimeError, "%s", msg);
-        }
-        else if (PyAsyncGen_CheckExact(gen) &&
-                PyErr_ExceptionMatches(PyExc_StopAsyncIteration))
-        {
-            /* code in `gen` raised a StopAsyncIteration error:
-               raise a RuntimeError.
-            */
-            const char *msg = "async generator raised StopAsyncIteration";
-            _PyErr_FormatFromCause(PyExc_RuntimeError, "%s", msg);
-        }
+        _PyGen_ConvertStopIteration(gen);
     }
 
     /* generator can't be rerun, so release the frame */
@@ -496,8 +505,9 @@ _gen_throw(PyGenObject *gen, int close_on_genexit,
             /* Termination repetition of SEND loop */
             assert(_PyInterpreterFrame_LASTI(frame) >= 0);
             /* Backup to SEND */
-            assert(_Py_OPCODE(frame->prev_instr[-1]) == SEND);
-            int jump = _Py_OPARG(frame->prev_instr[-1]);
+            _Py_CODEUNIT *send = frame->prev_instr - 1 - INLINE_CACHE_ENTRIES_SEND;
+            assert(_PyOpcode_Deopt[_Py_OPCODE(*send)] == SEND);
+            int jump = _Py_OPARG(*send);
             frame->prev_instr += jump - 1;
             if (_PyGen_FetchStopIterationValue(&val) == 0) {
                 ret = gen_send(gen, val);
@@ -1658,37 +1668,87 @@ PyAsyncGen_New(PyFrameObject *f, PyObject *name, PyObject *qualname)
 }
 
 
-void
-_PyAsyncGen_ClearFreeLists(PyInterpreterState *interp)
-{
 #if _PyAsyncGen_MAXFREELIST > 0
-    struct _Py_async_gen_state *state = &interp->async_gen;
-
-    while (state->value_numfree) {
+static void
+clear_value_freelist(struct _Py_async_gen_state *state, int limit)
+{
+    while (state->value_numfree > limit) {
         _PyAsyncGenWrappedValue *o;
         o = state->value_freelist[--state->value_numfree];
         assert(_PyAsyncGenWrappedValue_CheckExact(o));
         PyObject_GC_Del(o);
     }
+}
 
-    while (state->asend_numfree) {
+static void
+clear_asend_freelist(struct _Py_async_gen_state *state, int limit)
+{
+    while (state->asend_numfree > limit) {
         PyAsyncGenASend *o;
         o = state->asend_freelist[--state->asend_numfree];
         assert(Py_IS_TYPE(o, &_PyAsyncGenASend_Type));
         PyObject_GC_Del(o);
     }
+}
+#endif
+
+void
+_PyAsyncGen_ClearFreeLists(PyInterpreterState *interp)
+{
+#if _PyAsyncGen_MAXFREELIST > 0
+    struct _Py_async_gen_state *state = &interp->async_gen;
+    clear_value_freelist(state, 0);
+    clear_asend_freelist(state, 0);
+#endif
+}
+
+int
+_PyAsyncGen_SetFreeListLimit(PyInterpreterState *interp, int asend, int limit)
+{
+#if _PyAsyncGen_MAXFREELIST > 0
+    struct _Py_async_gen_state *state = &interp->async_gen;
+    void *array;
+    if (asend) {
+        clear_asend_freelist(state, limit);
+        array = PyMem_RawRealloc(state->asend_freelist,
+                                 limit * sizeof(PyAsyncGenASend *));
+        if (array == NULL) {
+            return -1;
+        }
+        state->asend_freelist = array;
+        state->asend_info.limit = limit;
+    }
+    else {
+        clear_value_freelist(state, limit);
+        array = PyMem_RawRealloc(state->value_freelist,
+                                 limit * sizeof(_PyAsyncGenWrappedValue *));
+        if (array == NULL) {
+            return -1;
+        }
+        state->value_freelist = array;
+        state->value_info.limit = limit;
+    }
 #endif
+    return 0;
 }
 
 void
 _PyAsyncGen_Fini(PyInterpreterState *interp)
 {
     _PyAsyncGen_ClearFreeLists(interp);
-#if defined(Py_DEBUG) && _PyAsyncGen_MAXFREELIST > 0
+#if _PyAsyncGen_MAXFREELIST > 0
     struct _Py_async_gen_state *state = &interp->async_gen;
+    PyMem_RawFree(state->value_freelist);
+    state->value_freelist = NULL;
+    state->value_info.limit = 0;
+    PyMem_RawFree(state->asend_freelist);
+    state->asend_freelist = NULL;
+    state->asend_info.limit = 0;
+#ifdef Py_DEBUG
     state->value_numfree = -1;
     state->asend_numfree = -1;
 #endif
+#endif
 }
 
 
@@ -1737,7 +1797,7 @@ async_gen_asend_dealloc(PyAsyncGenASend *o)
     // async_gen_asend_dealloc() must not be called after _PyAsyncGen_Fini()
     assert(state->asend_numfree != -1);
 #endif
-    if (state->asend_numfree < _PyAsyncGen_MAXFREELIST) {
+    if (state->asend_numfree < state->asend_info.limit) {
         assert(PyAsyncGenASend_CheckExact(o));
         state->asend_freelist[state->asend_numfree++] = o;
     }
@@ -1905,11 +1965,15 @@ async_gen_asend_new(PyAsyncGenObject *gen, PyObject *sendval)
     if (state->asend_numfree) {
         state->asend_numfree--;
         o = state->asend_freelist[state->asend_numfree];
+        state->asend_info.hits++;
         _Py_NewReference((PyObject *)o);
     }
     else
 #endif
     {
+#if _PyAsyncGen_MAXFREELIST > 0
+        state->asend_info.misses++;
+#endif
         o = PyObject_GC_New(PyAsyncGenASend, &_PyAsyncGenASend_Type);
         if (o == NULL) {
             return NULL;
@@ -1943,7 +2007,7 @@ async_gen_wrapped_val_dealloc(_PyAsyncGenWrappedValue *o)
     // async_gen_wrapped_val_dealloc() must not be called after _PyAsyncGen_Fini()
     assert(state->value_numfree != -1);
 #endif
-    if (state->value_numfree < _PyAsyncGen_MAXFREELIST) {
+    if (state->value_numfree < state->value_info.limit) {
         assert(_PyAsyncGenWrappedValue_CheckExact(o));
         state->value_freelist[state->value_numfree++] = o;
         OBJECT_STAT_INC(to_freelist);
@@ -2023,6 +2087,7 @@ _PyAsyncGenValueWrapperNew(PyObject *val)
     if (state->value_numfree) {
         state->value_numfree--;
         o = state->value_freelist[state->value_numfree];
+        state->value_info.hits++;
         OBJECT_STAT_INC(from_freelist);
         assert(_PyAsyncGenWrappedValue_CheckExact(o));
         _Py_NewReference((PyObject*)o);
@@ -2030,6 +2095,9 @@ _PyAsyncGenValueWrapperNew(PyObject *val)
     else
 #endif
     {
+#if _PyAsyncGen_MAXFREELIST > 0
+        state->value_info.misses++;
+#endif
         o = PyObject_GC_New(_PyAsyncGenWrappedValue,
                             &_PyAsyncGenWrappedValue_Type);
         if (o == NULL) {
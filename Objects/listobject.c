@@ -3,7 +3,7 @@
 #include "Python.h"
 #include "pycore_abstract.h"      // _PyIndex_Check()
 #include "pycore_interp.h"        // PyInterpreterState.list
-#include "pycore_list.h"          // struct _Py_list_state
+#include "pycore_list.h"          // struct _Py_list_state, _PyListIterObject
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_tuple.h"         // _PyTuple_FromArray()
 #include <stddef.h>
@@ -110,27 +110,56 @@ list_preallocate_exact(PyListObject *self, Py_ssize_t size)
     return 0;
 }
 
+#if PyList_MAXFREELIST > 0
+static void
+clear_freelist(struct _Py_list_state *state, int limit)
+{
+    while (state->numfree > limit) {
+        PyListObject *op = state->free_list[--state->numfree];
+        assert(PyList_CheckExact(op));
+        PyObject_GC_Del(op);
+    }
+}
+#endif
+
 void
 _PyList_ClearFreeList(PyInterpreterState *interp)
 {
+#if PyList_MAXFREELIST > 0
+    clear_freelist(&interp->list, 0);
+#endif
+}
+
+int
+_PyList_SetFreeListLimit(PyInterpreterState *interp, int limit)
+{
 #if PyList_MAXFREELIST > 0
     struct _Py_list_state *state = &interp->list;
-    while (state->numfree) {
-        PyListObject *op = state->free_list[--state->numfree];
-        assert(PyList_CheckExact(op));
-        PyObject_GC_Del(op);
+    clear_freelist(state, limit);
+    void *array = PyMem_RawRealloc(state->free_list,
+                                   limit * sizeof(PyListObject *));
+    if (array == NULL) {
+        return -1;
     }
+    state->free_list = array;
+    state->info.limit = limit;
 #endif
+    return 0;
 }
 
 void
 _PyList_Fini(PyInterpreterState *interp)
 {
     _PyList_ClearFreeList(interp);
-#if defined(Py_DEBUG) && PyList_MAXFREELIST > 0
+#if PyList_MAXFREELIST > 0
     struct _Py_list_state *state = &interp->list;
+    PyMem_RawFree(state->free_list);
+    state->free_list = NULL;
+    state->info.limit = 0;
+#ifdef Py_DEBUG
     state->numfree = -1;
 #endif
+#endif
 }
 
 /* Print summary info about the state of the optimized allocator */
@@ -145,16 +174,12 @@ _PyList_DebugMallocStats(FILE *out)
 #endif
 }
 
-PyObject *
-PyList_New(Py_ssize_t size)
+/* Allocate a list of size NULL items, not tracked by the GC yet */
+static PyListObject *
+list_new_untracked(Py_ssize_t size)
 {
     PyListObject *op;
 
-    if (size < 0) {
-        PyErr_BadInternalCall();
-        return NULL;
-    }
-
 #if PyList_MAXFREELIST > 0
     struct _Py_list_state *state = get_list_state();
 #ifdef Py_DEBUG
@@ -164,12 +189,16 @@ PyList_New(Py_ssize_t size)
     if (PyList_MAXFREELIST && state->numfree) {
         state->numfree--;
         op = state->free_list[state->numfree];
+        state->info.hits++;
         OBJECT_STAT_INC(from_freelist);
         _Py_NewReference((PyObject *)op);
     }
     else
 #endif
     {
+#if PyList_MAXFREELIST > 0
+        state->info.misses++;
+#endif
         op = PyObject_GC_New(PyListObject, &PyList_Type);
         if (op == NULL) {
             return NULL;
@@ -182,11 +211,26 @@ PyList_New(Py_ssize_t size)
         op->ob_item = (PyObject **) PyMem_Calloc(size, sizeof(PyObject *));
         if (op->ob_item == NULL) {
             Py_DECREF(op);
-            return PyErr_NoMemory();
+            PyErr_NoMemory();
+            return NULL;
         }
     }
     Py_SET_SIZE(op, size);
     op->allocated = size;
+    return op;
+}
+
+PyObject *
+PyList_New(Py_ssize_t size)
+{
+    if (size < 0) {
+        PyErr_BadInternalCall();
+        return NULL;
+    }
+    PyListObject *op = list_new_untracked(size);
+    if (op == NULL) {
+        return NULL;
+    }
     _PyObject_GC_TRACK(op);
     return (PyObject *) op;
 }
@@ -209,6 +253,44 @@ list_new_prealloc(Py_ssize_t size)
     return (PyObject *) op;
 }
 
+void
+_PyList_Track(PyListObject *self)
+{
+    _PyObject_GC_TRACK(self);
+}
+
+/* Used by the interpreter to build list displays.  The list is left
+   untracked when none of its items can be part of a cycle; the functions
+   storing items track it again when needed (see _PyList_MaintainTracking).
+   Steals the references to the items, even on failure. */
+PyObject *
+_PyList_FromArraySteal(PyObject *const *src, Py_ssize_t n)
+{
+    PyListObject *list = list_new_untracked(0);
+    if (list != NULL && n > 0) {
+        list->ob_item = PyMem_New(PyObject *, n);
+        if (list->ob_item == NULL) {
+            Py_CLEAR(list);
+            PyErr_NoMemory();
+        }
+    }
+    if (list == NULL) {
+        for (Py_ssize_t i = 0; i < n; i++) {
+            Py_DECREF(src[i]);
+        }
+        return NULL;
+    }
+    list->allocated = n;
+    PyObject **dst = list->ob_item;
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *item = src[i];
+        _PyList_MaintainTracking(list, item);
+        dst[i] = item;
+    }
+    Py_SET_SIZE(list, n);
+    return (PyObject *)list;
+}
+
 Py_ssize_t
 PyList_Size(PyObject *op)
 {
@@ -264,6 +346,9 @@ PyList_SetItem(PyObject *op, Py_ssize_t i,
                         "list assignment index out of range");
         return -1;
     }
+    if (newitem != NULL) {
+        _PyList_MaintainTracking((PyListObject *)op, newitem);
+    }
     p = ((PyListObject *)op) -> ob_item + i;
     Py_XSETREF(*p, newitem);
     return 0;
@@ -294,6 +379,7 @@ ins1(PyListObject *self, Py_ssize_t where, PyObject *v)
     for (i = n; --i >= where; )
         items[i+1] = items[i];
     Py_INCREF(v);
+    _PyList_MaintainTracking(self, v);
     items[where] = v;
     return 0;
 }
@@ -358,7 +444,7 @@ list_dealloc(PyListObject *op)
     // list_dealloc() must not be called after _PyList_Fini()
     assert(state->numfree != -1);
 #endif
-    if (state->numfree < PyList_MAXFREELIST && PyList_CheckExact(op)) {
+    if (state->numfree < state->info.limit && PyList_CheckExact(op)) {
         state->free_list[state->numfree++] = op;
         OBJECT_STAT_INC(to_freelist);
     }
@@ -716,7 +802,10 @@ list_ass_slice(PyListObject *a, Py_ssize_t ilow, Py_ssize_t ihigh, PyObject *v)
     }
     for (k = 0; k < n; k++, ilow++) {
         PyObject *w = vitem[k];
-        Py_XINCREF(w);
+        if (w != NULL) {
+            Py_INCREF(w);
+            _PyList_MaintainTracking(a, w);
+        }
         item[ilow] = w;
     }
     for (k = norig - 1; k >= 0; --k)
@@ -790,6 +879,7 @@ list_ass_item(PyListObject *a, Py_ssize_t i, PyObject *v)
     if (v == NULL)
         return list_ass_slice(a, i, i+1, v);
     Py_INCREF(v);
+    _PyList_MaintainTracking(a, v);
     Py_SETREF(a->ob_item[i], v);
     return 0;
 }
@@ -919,6 +1009,7 @@ list_extend(PyListObject *self, PyObject *iterable)
         for (i = 0; i < n; i++) {
             PyObject *o = src[i];
             Py_INCREF(o);
+            _PyList_MaintainTracking(self, o);
             dest[i] = o;
         }
         Py_DECREF(iterable);
@@ -969,6 +1060,7 @@ list_extend(PyListObject *self, PyObject *iterable)
         }
         if (Py_SIZE(self) < self->allocated) {
             /* steals ref */
+            _PyList_MaintainTracking(self, item);
             PyList_SET_ITEM(self, Py_SIZE(self), item);
             Py_SET_SIZE(self, Py_SIZE(self) + 1);
         }
@@ -3114,6 +3206,7 @@ list_ass_subscript(PyListObject* self, PyObject* item, PyObject* value)
                 garbage[i] = selfitems[cur];
                 ins = seqitems[i];
                 Py_INCREF(ins);
+                _PyList_MaintainTracking(self, ins);
                 selfitems[cur] = ins;
             }
 
@@ -3188,19 +3281,13 @@ PyTypeObject PyList_Type = {
 
 /*********************** List Iterator **************************/
 
-typedef struct {
-    PyObject_HEAD
-    Py_ssize_t it_index;
-    PyListObject *it_seq; /* Set to NULL when iterator is exhausted */
-} listiterobject;
-
-static void listiter_dealloc(listiterobject *);
-static int listiter_traverse(listiterobject *, visitproc, void *);
-static PyObject *listiter_next(listiterobject *);
-static PyObject *listiter_len(listiterobject *, PyObject *);
+static void listiter_dealloc(_PyListIterObject *);
+static int listiter_traverse(_PyListIterObject *, visitproc, void *);
+static PyObject *listiter_next(_PyListIterObject *);
+static PyObject *listiter_len(_PyListIterObject *, PyObject *);
 static PyObject *listiter_reduce_general(void *_it, int forward);
-static PyObject *listiter_reduce(listiterobject *, PyObject *);
-static PyObject *listiter_setstate(listiterobject *, PyObject *state);
+static PyObject *listiter_reduce(_PyListIterObject *, PyObject *);
+static PyObject *listiter_setstate(_PyListIterObject *, PyObject *state);
 
 PyDoc_STRVAR(length_hint_doc, "Private method returning an estimate of len(list(it)).");
 PyDoc_STRVAR(reduce_doc, "Return state information for pickling.");
@@ -3216,7 +3303,7 @@ static PyMethodDef listiter_methods[] = {
 PyTypeObject PyListIter_Type = {
     PyVarObject_HEAD_INIT(&PyType_Type, 0)
     "list_iterator",                            /* tp_name */
-    sizeof(listiterobject),                     /* tp_basicsize */
+    sizeof(_PyListIterObject),                     /* tp_basicsize */
     0,                                          /* tp_itemsize */
     /* methods */
     (destructor)listiter_dealloc,               /* tp_dealloc */
@@ -3250,13 +3337,13 @@ PyTypeObject PyListIter_Type = {
 static PyObject *
 list_iter(PyObject *seq)
 {
-    listiterobject *it;
+    _PyListIterObject *it;
 
     if (!PyList_Check(seq)) {
         PyErr_BadInternalCall();
         return NULL;
     }
-    it = PyObject_GC_New(listiterobject, &PyListIter_Type);
+    it = PyObject_GC_New(_PyListIterObject, &PyListIter_Type);
     if (it == NULL)
         return NULL;
     it->it_index = 0;
@@ -3267,7 +3354,7 @@ list_iter(PyObject *seq)
 }
 
 static void
-listiter_dealloc(listiterobject *it)
+listiter_dealloc(_PyListIterObject *it)
 {
     _PyObject_GC_UNTRACK(it);
     Py_XDECREF(it->it_seq);
@@ -3275,14 +3362,14 @@ listiter_dealloc(listiterobject *it)
 }
 
 static int
-listiter_traverse(listiterobject *it, visitproc visit, void *arg)
+listiter_traverse(_PyListIterObject *it, visitproc visit, void *arg)
 {
     Py_VISIT(it->it_seq);
     return 0;
 }
 
 static PyObject *
-listiter_next(listiterobject *it)
+listiter_next(_PyListIterObject *it)
 {
     PyListObject *seq;
     PyObject *item;
@@ -3306,7 +3393,7 @@ listiter_next(listiterobject *it)
 }
 
 static PyObject *
-listiter_len(listiterobject *it, PyObject *Py_UNUSED(ignored))
+listiter_len(_PyListIterObject *it, PyObject *Py_UNUSED(ignored))
 {
     Py_ssize_t len;
     if (it->it_seq) {
@@ -3318,13 +3405,13 @@ listiter_len(listiterobject *it, PyObject *Py_UNUSED(ignored))
 }
 
 static PyObject *
-listiter_reduce(listiterobject *it, PyObject *Py_UNUSED(ignored))
+listiter_reduce(_PyListIterObject *it, PyObject *Py_UNUSED(ignored))
 {
     return listiter_reduce_general(it, 1);
 }
 
 static PyObject *
-listiter_setstate(listiterobject *it, PyObject *state)
+listiter_setstate(_PyListIterObject *it, PyObject *state)
 {
     Py_ssize_t index = PyLong_AsSsize_t(state);
     if (index == -1 && PyErr_Occurred())
@@ -3499,7 +3586,7 @@ listiter_reduce_general(void *_it, int forward)
 
     /* the objects are not the same, index is of different types! */
     if (forward) {
-        listiterobject *it = (listiterobject *)_it;
+        _PyListIterObject *it = (_PyListIterObject *)_it;
         if (it->it_seq) {
             return Py_BuildValue("N(O)n", _PyEval_GetBuiltin(&_Py_ID(iter)),
                                  it->it_seq, it->it_index);
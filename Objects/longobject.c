@@ -191,6 +191,37 @@ _PyLong_Copy(PyLongObject *src)
     return (PyObject *)result;
 }
 
+/* Store an int with the given value in *target, releasing the reference
+   previously held there (if any).  If the old object is an exact
+   single-digit int that nothing else refers to, it is reused in place
+   to avoid an allocation.  This is used by FOR_ITER_RANGE to write the
+   loop variable directly.  Return 0 on success, -1 on failure. */
+int
+_PyLong_AssignValue(PyObject **target, long value)
+{
+    PyObject *old = *target;
+    if (IS_SMALL_INT(value)) {
+        *target = get_small_int((sdigit)value);
+        Py_XDECREF(old);
+        return 0;
+    }
+    if (old != NULL && PyLong_CheckExact(old) &&
+        Py_REFCNT(old) == 1 && Py_SIZE(old) == 1 &&
+        (unsigned long)value <= PyLong_MASK)
+    {
+        /* Only positive values are handled in place, since iterating
+           over a range with a positive step is by far the common case. */
+        ((PyLongObject *)old)->ob_digit[0] = (digit)value;
+        return 0;
+    }
+    *target = PyLong_FromLong(value);
+    Py_XDECREF(old);
+    if (*target == NULL) {
+        return -1;
+    }
+    return 0;
+}
+
 static PyObject *
 _PyLong_FromMedium(sdigit x)
 {
@@ -7,13 +7,17 @@
 #include "pycore_context.h"       // _PyContextTokenMissing_Type
 #include "pycore_dict.h"          // _PyObject_MakeDictFromInstanceAttributes()
 #include "pycore_floatobject.h"   // _PyFloat_DebugMallocStats()
+#include "pycore_freelist.h"      // _PyObject_InitFreeLists()
+#include "pycore_genobject.h"     // _PyAsyncGen_MAXFREELIST
 #include "pycore_initconfig.h"    // _PyStatus_EXCEPTION()
+#include "pycore_list.h"          // PyList_MAXFREELIST
 #include "pycore_namespace.h"     // _PyNamespace_Type
 #include "pycore_object.h"        // _PyType_CheckConsistency(), _Py_FatalRefcountError()
 #include "pycore_pyerrors.h"      // _PyErr_Occurred()
 #include "pycore_pymem.h"         // _PyMem_IsPtrFreed()
 #include "pycore_pystate.h"       // _PyThreadState_GET()
 #include "pycore_symtable.h"      // PySTEntry_Type
+#include "pycore_tuple.h"         // PyTuple_NFREELISTS
 #include "pycore_typeobject.h"    // _PyTypes_InitSlotDefs()
 #include "pycore_unionobject.h"   // _PyUnion_Type
 #include "frameobject.h"          // PyFrame_Type
@@ -2012,6 +2016,24 @@ _PyTypes_FiniTypes(PyInterpreterState *interp)
 }
 
 
+/* Pin or unpin the objects which all interpreters share: the singletons,
+   the static types with their dictionaries and the interned strings.  While
+   subinterpreters run under their own GIL, their reference counts are
+   updated concurrently, so they must never drop to zero.  They are unpinned
+   when the main interpreter is finalized, to be deallocated as usual. */
+void
+_PyObject_SetSharedObjectsPinned(int pinned)
+{
+    _PyObject_SetPinned(Py_None, pinned);
+    _PyObject_SetPinned(Py_True, pinned);
+    _PyObject_SetPinned(Py_False, pinned);
+    _PyObject_SetPinned(Py_Ellipsis, pinned);
+    _PyObject_SetPinned(Py_NotImplemented, pinned);
+    _PyType_SetStaticTypePinned(&PyBaseObject_Type, pinned);
+    _PyUnicode_SetInternedPinned(pinned);
+}
+
+
 void
 _Py_NewReference(PyObject *op)
 {
@@ -2136,6 +2158,167 @@ _PyObject_DebugTypeStats(FILE *out)
     _PyTuple_DebugMallocStats(out);
 }
 
+
+/* Names and default limits of the free lists */
+static const struct {
+    const char *name;
+    int default_limit;
+} freelists[_Py_FREELIST_KINDS] = {
+    [_Py_FREELIST_FLOAT] = {"float", PyFloat_MAXFREELIST},
+    [_Py_FREELIST_DICT] = {"dict", PyDict_MAXFREELIST},
+    [_Py_FREELIST_DICT_KEYS] = {"dict_keys", PyDict_MAXFREELIST},
+    [_Py_FREELIST_LIST] = {"list", PyList_MAXFREELIST},
+#if PyTuple_NFREELISTS > 0
+    [_Py_FREELIST_TUPLE] = {"tuple", PyTuple_MAXFREELIST},
+#else
+    [_Py_FREELIST_TUPLE] = {"tuple", 0},
+#endif
+    [_Py_FREELIST_ASYNC_GEN_VALUE] = {"async_gen_value",
+                                      _PyAsyncGen_MAXFREELIST},
+    [_Py_FREELIST_ASYNC_GEN_ASEND] = {"async_gen_asend",
+                                      _PyAsyncGen_MAXFREELIST},
+};
+
+const char*
+_PyObject_GetFreeListName(int kind)
+{
+    if (kind < 0 || kind >= _Py_FREELIST_KINDS) {
+        return NULL;
+    }
+    return freelists[kind].name;
+}
+
+int
+_PyObject_ParseFreeListLimits(const wchar_t *spec, int *limits)
+{
+    const wchar_t *p = spec;
+    while (*p != L'\0') {
+        const wchar_t *sep = wcschr(p, L'=');
+        if (sep == NULL) {
+            return -1;
+        }
+        size_t len = (size_t)(sep - p);
+        int kind = 0;
+        for (; kind < _Py_FREELIST_KINDS; kind++) {
+            const char *name = freelists[kind].name;
+            size_t i = 0;
+            while (i < len && name[i] != '\0' && (wchar_t)name[i] == p[i]) {
+                i++;
+            }
+            if (i == len && name[i] == '\0') {
+                break;
+            }
+        }
+        if (kind == _Py_FREELIST_KINDS) {
+            return -1;
+        }
+
+        wchar_t *end;
+        errno = 0;
+        long limit = wcstol(sep + 1, &end, 10);
+        if (end == sep + 1 || errno == ERANGE || limit < 0 || limit > INT_MAX
+            || (*end != L',' && *end != L'\0'))
+        {
+            return -1;
+        }
+        limits[kind] = (int)limit;
+        p = end;
+        if (*p == L',' && *++p == L'\0') {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+PyStatus
+_PyObject_InitFreeLists(PyInterpreterState *interp)
+{
+    int limits[_Py_FREELIST_KINDS];
+    for (int kind = 0; kind < _Py_FREELIST_KINDS; kind++) {
+        limits[kind] = freelists[kind].default_limit;
+    }
+    const PyConfig *config = _PyInterpreterState_GetConfig(interp);
+    if (config->freelist_limits != NULL
+        && _PyObject_ParseFreeListLimits(config->freelist_limits, limits) < 0)
+    {
+        return _PyStatus_ERR("invalid free list limits");
+    }
+    for (int kind = 0; kind < _Py_FREELIST_KINDS; kind++) {
+        if (_PyObject_SetFreeListLimit(interp, kind, limits[kind]) < 0) {
+            return _PyStatus_NO_MEMORY();
+        }
+    }
+    return _PyStatus_OK();
+}
+
+struct _Py_freelist_info*
+_PyObject_GetFreeList(PyInterpreterState *interp, int kind,
+                      Py_ssize_t *numfree)
+{
+    switch (kind) {
+#if PyFloat_MAXFREELIST > 0
+    case _Py_FREELIST_FLOAT:
+        *numfree = interp->float_state.numfree;
+        return &interp->float_state.info;
+#endif
+#if PyDict_MAXFREELIST > 0
+    case _Py_FREELIST_DICT:
+        *numfree = interp->dict_state.numfree;
+        return &interp->dict_state.info;
+    case _Py_FREELIST_DICT_KEYS:
+        *numfree = interp->dict_state.keys_numfree;
+        return &interp->dict_state.keys_info;
+#endif
+#if PyList_MAXFREELIST > 0
+    case _Py_FREELIST_LIST:
+        *numfree = interp->list.numfree;
+        return &interp->list.info;
+#endif
+#if PyTuple_NFREELISTS > 0
+    case _Py_FREELIST_TUPLE:
+        *numfree = 0;
+        for (int i = 0; i < PyTuple_NFREELISTS; i++) {
+            *numfree += interp->tuple.numfree[i];
+        }
+        return &interp->tuple.info;
+#endif
+#if _PyAsyncGen_MAXFREELIST > 0
+    case _Py_FREELIST_ASYNC_GEN_VALUE:
+        *numfree = interp->async_gen.value_numfree;
+        return &interp->async_gen.value_info;
+    case _Py_FREELIST_ASYNC_GEN_ASEND:
+        *numfree = interp->async_gen.asend_numfree;
+        return &interp->async_gen.asend_info;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+int
+_PyObject_SetFreeListLimit(PyInterpreterState *interp, int kind, int limit)
+{
+    assert(limit >= 0);
+    switch (kind) {
+    case _Py_FREELIST_FLOAT:
+        return _PyFloat_SetFreeListLimit(interp, limit);
+    case _Py_FREELIST_DICT:
+        return _PyDict_SetFreeListLimit(interp, 0, limit);
+    case _Py_FREELIST_DICT_KEYS:
+        return _PyDict_SetFreeListLimit(interp, 1, limit);
+    case _Py_FREELIST_LIST:
+        return _PyList_SetFreeListLimit(interp, limit);
+    case _Py_FREELIST_TUPLE:
+        return _PyTuple_SetFreeListLimit(interp, limit);
+    case _Py_FREELIST_ASYNC_GEN_VALUE:
+        return _PyAsyncGen_SetFreeListLimit(interp, 0, limit);
+    case _Py_FREELIST_ASYNC_GEN_ASEND:
+        return _PyAsyncGen_SetFreeListLimit(interp, 1, limit);
+    default:
+        Py_UNREACHABLE();
+    }
+}
+
 /* These methods are used to control infinite recursion in repr, str, print,
    etc.  Container objects that may recursively contain themselves,
    e.g. builtin dictionaries and lists, should use Py_ReprEnter() and
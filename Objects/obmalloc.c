@@ -1,6 +1,7 @@
 #include "Python.h"
 #include "pycore_pymem.h"         // _PyTraceMalloc_Config
 #include "pycore_code.h"         // stats
+#include "pycore_pystate.h"       // _PyThreadState_GET()
 
 #include <stdbool.h>
 #include <stdlib.h>               // malloc()
@@ -146,6 +147,11 @@ _PyObject_ArenaVirtualFree(void *Py_UNUSED(ctx), void *ptr,
 }
 
 #elif defined(ARENAS_USE_MMAP)
+/* Ask for transparent huge pages, see _PyObject_SetArenaHugePages() */
+static int arena_hugepages = 0;
+/* Total number of arenas given the advice. */
+static size_t narenas_hugepages = 0;
+
 static void *
 _PyObject_ArenaMmap(void *Py_UNUSED(ctx), size_t size)
 {
@@ -989,6 +995,17 @@ static int running_on_valgrind = -1;
 #   error "arena size not an exact multiple of pool size"
 #endif
 
+/*
+ * Each interpreter keeps up to PYMALLOC_CACHE_BYTES bytes of the blocks it
+ * frees for each size class, and serves its next allocations of that class
+ * from them without touching the pools (see struct _Py_obmalloc_cache).
+ * Blocks freed while the cache is full go straight back to their pools.
+ * Set it to 0 to disable the caches.
+ */
+#ifndef PYMALLOC_CACHE_BYTES
+#define PYMALLOC_CACHE_BYTES    4096
+#endif
+
 /*
  * -- End of tunable settings section --
  */
@@ -1036,6 +1053,11 @@ struct arena_object {
     /* Singly-linked list of available pools. */
     struct pool_header* freepools;
 
+    /* The number of available pools whose pages were given back to the
+     * system, see _PyObject_ReleaseFreePools().
+     */
+    uint nreleasedpools;
+
     /* Whenever this arena_object is not associated with an allocated
      * arena, the nextarena member is used to link all unassociated
      * arena_objects in the singly-linked `unused_arena_objects` list.
@@ -1057,6 +1079,7 @@ struct arena_object {
 #define POOL_OVERHEAD   _Py_SIZE_ROUND_UP(sizeof(struct pool_header), ALIGNMENT)
 
 #define DUMMY_SIZE_IDX          0xffff  /* size class of newly cached pools */
+                                        /* and of released free pools */
 
 /* Round pointer P down to the closest pool-aligned address <= P, as a poolp */
 #define POOL_ADDR(P) ((poolp)_Py_ALIGN_DOWN((P), POOL_SIZE))
@@ -1274,10 +1297,46 @@ static size_t narenas_highwater = 0;
 
 static Py_ssize_t raw_allocated_blocks;
 
+/* Number of free pools whose pages are currently given back to the system,
+   total number of pools released, and number of release passes which
+   released some. */
+static size_t npools_released = 0;
+static size_t ntimes_pool_released = 0;
+static size_t nrelease_passes = 0;
+/* Set when a pool became free since the last release pass. */
+static int pools_to_release = 0;
+
+static Py_ssize_t cached_blocks(int i);
+
+/* The pools and arenas are shared by all interpreters.  Once
+ * subinterpreters run under their own GIL, they are protected by a lock,
+ * taken when the block is not served by the cache of the interpreter.
+ * pools_lock() returns whether it was taken.
+ */
+static inline int
+pools_lock(void)
+{
+    if (UNLIKELY(_PyRuntime.ceval.own_gils)) {
+        PyThread_acquire_lock(_PyRuntime.shared_locks.obmalloc, WAIT_LOCK);
+        return 1;
+    }
+    return 0;
+}
+
+static inline void
+pools_unlock(int locked)
+{
+    if (locked) {
+        PyThread_release_lock(_PyRuntime.shared_locks.obmalloc);
+    }
+}
+
 Py_ssize_t
 _Py_GetAllocatedBlocks(void)
 {
-    Py_ssize_t n = raw_allocated_blocks;
+    int locked = pools_lock();
+    /* blocks kept in the caches are free */
+    Py_ssize_t n = raw_allocated_blocks - cached_blocks(-1);
     /* add up allocated blocks for used pools */
     for (uint i = 0; i < maxarenas; ++i) {
         /* Skip arenas which are not allocated. */
@@ -1294,6 +1353,7 @@ _Py_GetAllocatedBlocks(void)
             n += p->ref.count;
         }
     }
+    pools_unlock(locked);
     return n;
 }
 
@@ -1571,6 +1631,50 @@ arena_map_is_used(block *p)
 #endif /* WITH_PYMALLOC_RADIX_TREE */
 
 
+#if defined(ARENAS_USE_MMAP) && defined(MADV_HUGEPAGE)
+/* Size and alignment of a transparent huge page (x86-64, and arm64 with
+   4 KiB pages) */
+#define HUGEPAGE_SIZE ((size_t)1 << 21)
+
+/* Part of the last huge page mapping not handed out yet */
+static char *hugepage_next = NULL;
+static char *hugepage_end = NULL;
+
+/* The kernel only backs a range with a huge page at the first fault if the
+   whole aligned range is already mapped and advised, so arenas are carved
+   from huge page aligned mappings instead of being mapped one by one.  Each
+   arena is still unmapped on its own by _PyObject_ArenaMunmap(). */
+static void *
+arena_mmap_hugepage(void)
+{
+    Py_BUILD_ASSERT(HUGEPAGE_SIZE % ARENA_SIZE == 0);
+    if (hugepage_next == hugepage_end) {
+        size_t len = 2 * HUGEPAGE_SIZE;
+        char *ptr = mmap(NULL, len, PROT_READ|PROT_WRITE,
+                         MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+        if (ptr == MAP_FAILED) {
+            return NULL;
+        }
+        char *start = _Py_ALIGN_UP(ptr, HUGEPAGE_SIZE);
+        char *end = start + HUGEPAGE_SIZE;
+        if (start != ptr) {
+            munmap(ptr, start - ptr);
+        }
+        if (end != ptr + len) {
+            munmap(end, ptr + len - end);
+        }
+        if (madvise(start, HUGEPAGE_SIZE, MADV_HUGEPAGE) == 0) {
+            narenas_hugepages += HUGEPAGE_SIZE / ARENA_SIZE;
+        }
+        hugepage_next = start;
+        hugepage_end = end;
+    }
+    void *ptr = hugepage_next;
+    hugepage_next += ARENA_SIZE;
+    return ptr;
+}
+#endif
+
 /* Allocate a new arena.  If we run out of memory, return NULL.  Else
  * allocate a new arena, and return the address of an arena_object
  * describing the new arena.  It's expected that the caller will set
@@ -1639,6 +1743,12 @@ new_arena(void)
     arenaobj = unused_arena_objects;
     unused_arena_objects = arenaobj->nextarena;
     assert(arenaobj->address == 0);
+#if defined(ARENAS_USE_MMAP) && defined(MADV_HUGEPAGE)
+    if (arena_hugepages && _PyObject_Arena.alloc == _PyObject_ArenaMmap) {
+        address = arena_mmap_hugepage();
+    }
+    else
+#endif
     address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
 #if WITH_PYMALLOC_RADIX_TREE
     if (address != NULL) {
@@ -1664,6 +1774,7 @@ new_arena(void)
     if (narenas_currently_allocated > narenas_highwater)
         narenas_highwater = narenas_currently_allocated;
     arenaobj->freepools = NULL;
+    arenaobj->nreleasedpools = 0;
     /* pool_address <- first pool-aligned address in the arena
        nfreepools <- number of whole pools that fit after alignment */
     arenaobj->pool_address = (block*)arenaobj->address;
@@ -1854,6 +1965,11 @@ allocate_from_new_pool(uint size)
         /* Unlink from cached pools. */
         usable_arenas->freepools = pool->nextpool;
         usable_arenas->nfreepools--;
+        if (pool->szidx == DUMMY_SIZE_IDX) {
+            /* Its pages will be faulted back in as it is used. */
+            usable_arenas->nreleasedpools--;
+            npools_released--;
+        }
         if (UNLIKELY(usable_arenas->nfreepools == 0)) {
             /* Wholly allocated:  remove. */
             assert(usable_arenas->freepools == NULL);
@@ -1965,9 +2081,23 @@ pymalloc_alloc(void *Py_UNUSED(ctx), size_t nbytes)
     }
 
     uint size = (uint)(nbytes - 1) >> ALIGNMENT_SHIFT;
-    poolp pool = usedpools[size + size];
     block *bp;
 
+#if PYMALLOC_CACHE_BYTES > 0
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (LIKELY(tstate != NULL)) {
+        struct _Py_obmalloc_cache *cache = &tstate->interp->obmalloc;
+        bp = cache->bins[size].head;
+        if (LIKELY(bp != NULL)) {
+            cache->bins[size].head = *(block **)bp;
+            cache->bins[size].count--;
+            return (void *)bp;
+        }
+    }
+#endif
+
+    int locked = pools_lock();
+    poolp pool = usedpools[size + size];
     if (LIKELY(pool != pool->nextpool)) {
         /*
          * There is a used pool for this size class.
@@ -1988,6 +2118,7 @@ pymalloc_alloc(void *Py_UNUSED(ctx), size_t nbytes)
          */
         bp = allocate_from_new_pool(size);
     }
+    pools_unlock(locked);
 
     return (void *)bp;
 }
@@ -2003,7 +2134,9 @@ _PyObject_Malloc(void *ctx, size_t nbytes)
 
     ptr = PyMem_RawMalloc(nbytes);
     if (ptr != NULL) {
+        int locked = pools_lock();
         raw_allocated_blocks++;
+        pools_unlock(locked);
     }
     return ptr;
 }
@@ -2023,7 +2156,9 @@ _PyObject_Calloc(void *ctx, size_t nelem, size_t elsize)
 
     ptr = PyMem_RawCalloc(nelem, elsize);
     if (ptr != NULL) {
+        int locked = pools_lock();
         raw_allocated_blocks++;
+        pools_unlock(locked);
     }
     return ptr;
 }
@@ -2059,6 +2194,7 @@ insert_to_freepool(poolp pool)
     struct arena_object *ao = &arenas[pool->arenaindex];
     pool->nextpool = ao->freepools;
     ao->freepools = pool;
+    pools_to_release = 1;
     uint nf = ao->nfreepools;
     /* If this is the rightmost arena with this number of free pools,
      * nfp2lasta[nf] needs to change.  Caution:  if nf is 0, there
@@ -2137,6 +2273,7 @@ insert_to_freepool(poolp pool)
                              (void *)ao->address, ARENA_SIZE);
         ao->address = 0;                        /* mark unassociated */
         --narenas_currently_allocated;
+        npools_released -= ao->nreleasedpools;
 
         return;
     }
@@ -2212,26 +2349,10 @@ insert_to_freepool(poolp pool)
            || ao->prevarena->nextarena == ao);
 }
 
-/* Free a memory block allocated by pymalloc_alloc().
-   Return 1 if it was freed.
-   Return 0 if the block was not allocated by pymalloc_alloc(). */
-static inline int
-pymalloc_free(void *Py_UNUSED(ctx), void *p)
+/* Give the block p back to its pool. */
+static inline void
+pymalloc_free_block(poolp pool, void *p)
 {
-    assert(p != NULL);
-
-#ifdef WITH_VALGRIND
-    if (UNLIKELY(running_on_valgrind > 0)) {
-        return 0;
-    }
-#endif
-
-    poolp pool = POOL_ADDR(p);
-    if (UNLIKELY(!address_in_range(p, pool))) {
-        return 0;
-    }
-    /* We allocated this address. */
-
     /* Link p to the start of the pool's freeblock list.  Since
      * the pool had at least the p block outstanding, the pool
      * wasn't empty (so it's already in a usedpools[] list, or
@@ -2252,7 +2373,7 @@ pymalloc_free(void *Py_UNUSED(ctx), void *p)
          * blocks of the same size class.
          */
         insert_to_usedpool(pool);
-        return 1;
+        return;
     }
 
     /* freeblock wasn't NULL, so the pool wasn't full,
@@ -2260,7 +2381,7 @@ pymalloc_free(void *Py_UNUSED(ctx), void *p)
      */
     if (LIKELY(pool->ref.count != 0)) {
         /* pool isn't empty:  leave it in usedpools */
-        return 1;
+        return;
     }
 
     /* Pool is now empty:  unlink from usedpools, and
@@ -2269,6 +2390,61 @@ pymalloc_free(void *Py_UNUSED(ctx), void *p)
      * (being not referenced, they are perhaps paged out).
      */
     insert_to_freepool(pool);
+}
+
+/* Give the blocks of a cache bin back to their pools. */
+static void
+cache_bin_clear(struct _Py_obmalloc_cache *cache, uint size)
+{
+    block *bp = cache->bins[size].head;
+    cache->bins[size].head = NULL;
+    cache->bins[size].count = 0;
+    int locked = pools_lock();
+    while (bp != NULL) {
+        block *next = *(block **)bp;
+        pymalloc_free_block(POOL_ADDR(bp), bp);
+        bp = next;
+    }
+    pools_unlock(locked);
+}
+
+/* Free a memory block allocated by pymalloc_alloc().
+   Return 1 if it was freed.
+   Return 0 if the block was not allocated by pymalloc_alloc(). */
+static inline int
+pymalloc_free(void *Py_UNUSED(ctx), void *p)
+{
+    assert(p != NULL);
+
+#ifdef WITH_VALGRIND
+    if (UNLIKELY(running_on_valgrind > 0)) {
+        return 0;
+    }
+#endif
+
+    poolp pool = POOL_ADDR(p);
+    if (UNLIKELY(!address_in_range(p, pool))) {
+        return 0;
+    }
+    /* We allocated this address. */
+
+#if PYMALLOC_CACHE_BYTES > 0
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (LIKELY(tstate != NULL)) {
+        struct _Py_obmalloc_cache *cache = &tstate->interp->obmalloc;
+        uint size = pool->szidx;
+        if (LIKELY(cache->bins[size].count < cache->bins[size].limit)) {
+            *(block **)p = cache->bins[size].head;
+            cache->bins[size].head = p;
+            cache->bins[size].count++;
+            return 1;
+        }
+    }
+#endif
+
+    int locked = pools_lock();
+    pymalloc_free_block(pool, p);
+    pools_unlock(locked);
     return 1;
 }
 
@@ -2284,7 +2460,9 @@ _PyObject_Free(void *ctx, void *p)
     if (UNLIKELY(!pymalloc_free(ctx, p))) {
         /* pymalloc didn't allocate this address */
         PyMem_RawFree(p);
+        int locked = pools_lock();
         raw_allocated_blocks--;
+        pools_unlock(locked);
     }
 }
 
@@ -2375,6 +2553,353 @@ _PyObject_Realloc(void *ctx, void *ptr, size_t nbytes)
     return PyMem_RawRealloc(ptr, nbytes);
 }
 
+void
+_PyMem_InitCache(struct _Py_obmalloc_cache *cache)
+{
+    for (uint i = 0; i < _PyMem_CACHE_BINS; i++) {
+        assert(cache->bins[i].head == NULL);
+        cache->bins[i].count = 0;
+        if (i < NB_SMALL_SIZE_CLASSES) {
+            cache->bins[i].limit = PYMALLOC_CACHE_BYTES / INDEX2SIZE(i);
+        }
+        else {
+            cache->bins[i].limit = 0;
+        }
+    }
+}
+
+void
+_PyMem_ClearCache(struct _Py_obmalloc_cache *cache)
+{
+    for (uint i = 0; i < NB_SMALL_SIZE_CLASSES; i++) {
+        cache->bins[i].limit = 0;
+        cache_bin_clear(cache, i);
+    }
+}
+
+/* The caches of the interpreters visited by clear_all_caches() and
+   cached_blocks(): the cache of an interpreter is protected by its GIL, so
+   only the current one is visited once they have their own GIL. */
+static PyInterpreterState *
+first_cache_interp(void)
+{
+    if (_PyRuntime.ceval.own_gils) {
+        return _PyInterpreterState_GET();
+    }
+    return _PyRuntime.interpreters.head;
+}
+
+#define NEXT_CACHE_INTERP(interp) \
+    (_PyRuntime.ceval.own_gils ? NULL : (interp)->next)
+
+/* Give the blocks of the caches of all interpreters back to their pools,
+   leaving the caches enabled. */
+static void
+clear_all_caches(void)
+{
+    PyInterpreterState *interp = first_cache_interp();
+    for (; interp != NULL; interp = NEXT_CACHE_INTERP(interp)) {
+        for (uint i = 0; i < NB_SMALL_SIZE_CLASSES; i++) {
+            cache_bin_clear(&interp->obmalloc, i);
+        }
+    }
+}
+
+/* Number of blocks of size class i (or of all of them if i is -1) kept in
+   the caches of the interpreters. */
+static Py_ssize_t
+cached_blocks(int i)
+{
+    Py_ssize_t n = 0;
+    PyInterpreterState *interp = first_cache_interp();
+    for (; interp != NULL; interp = NEXT_CACHE_INTERP(interp)) {
+        for (uint j = 0; j < NB_SMALL_SIZE_CLASSES; j++) {
+            if (i < 0 || (uint)i == j) {
+                n += interp->obmalloc.bins[j].count;
+            }
+        }
+    }
+    return n;
+}
+
+/* Stop allocating from the pools currently in use, see gc.freeze().
+ *
+ * The partially used pools are unlinked from usedpools[], so that new
+ * blocks come from empty pools instead of sharing pages with the blocks
+ * allocated so far.  A retired pool is linked to itself: freeing its blocks
+ * never puts it back in usedpools[] (its freeblock list is not empty), and
+ * once it is empty insert_to_freepool() unlinks it from itself and reuses
+ * it as usual.  Returns the number of retired pools.
+ */
+Py_ssize_t
+_PyObject_RetireUsedPools(void)
+{
+    /* The cached blocks would otherwise be reused before the new pools */
+    clear_all_caches();
+
+    int locked = pools_lock();
+    Py_ssize_t n = 0;
+    for (uint i = 0; i < NB_SMALL_SIZE_CLASSES; i++) {
+        poolp head = PTA(i);
+        poolp pool = head->nextpool;
+        while (pool != head) {
+            poolp next = pool->nextpool;
+            assert(pool->freeblock != NULL);
+            pool->nextpool = pool;
+            pool->prevpool = pool;
+            pool = next;
+            n++;
+        }
+        head->nextpool = head;
+        head->prevpool = head;
+    }
+    pools_unlock(locked);
+    return n;
+}
+
+/* Size of the pages released by _PyObject_ReleaseFreePools(), or 0 if it
+   cannot release any. */
+static size_t
+release_page_size(void)
+{
+    static size_t page_size = (size_t)-1;
+    if (page_size == (size_t)-1) {
+        page_size = 0;
+#if defined(ARENAS_USE_MMAP) && defined(MADV_DONTNEED) && defined(_SC_PAGESIZE)
+        long size = sysconf(_SC_PAGESIZE);
+        if (size > 0 && (size_t)size < POOL_SIZE
+            && POOL_SIZE % (size_t)size == 0)
+        {
+            page_size = (size_t)size;
+        }
+#endif
+    }
+    return page_size;
+}
+
+/* Give the pages of the free pools back to the system.
+ *
+ * Arenas are only freed once all their pools are free, so a long running
+ * process can keep many free pools in partially used arenas.  This releases
+ * their pages with madvise(MADV_DONTNEED), except the first page of each
+ * pool, which holds the header linking it in the freepools list of its
+ * arena.  A released pool is marked with DUMMY_SIZE_IDX, so that it is
+ * initialized again when it is reused; its pages are then faulted back in.
+ *
+ * Pools are pushed to and popped from the front of the freepools lists, so
+ * the pools freed since the last pass come first, and the walk stops at the
+ * first released one.  Nothing is released from the arenas of a custom
+ * arena allocator, nor from arenas backed by huge pages, which releasing
+ * part of would split.  It is called after the collections of the oldest
+ * generation.  Returns the number of released pools.
+ */
+Py_ssize_t
+_PyObject_ReleaseFreePools(void)
+{
+#if defined(ARENAS_USE_MMAP) && defined(MADV_DONTNEED)
+    int locked = pools_lock();
+    if (!pools_to_release) {
+        pools_unlock(locked);
+        return 0;
+    }
+    pools_to_release = 0;
+    size_t page_size = release_page_size();
+    if (page_size == 0 || arena_hugepages
+        || _PyObject_Arena.alloc != _PyObject_ArenaMmap)
+    {
+        pools_unlock(locked);
+        return 0;
+    }
+
+    size_t n = 0;
+    struct arena_object *ao = usable_arenas;
+    for (; ao != NULL; ao = ao->nextarena) {
+        poolp pool = ao->freepools;
+        for (; pool != NULL && pool->szidx != DUMMY_SIZE_IDX;
+             pool = pool->nextpool)
+        {
+            assert(pool->ref.count == 0);
+            if (madvise((block *)pool + page_size, POOL_SIZE - page_size,
+                        MADV_DONTNEED) < 0)
+            {
+                break;
+            }
+            pool->szidx = DUMMY_SIZE_IDX;
+            ao->nreleasedpools++;
+            n++;
+        }
+    }
+    if (n > 0) {
+        npools_released += n;
+        ntimes_pool_released += n;
+        nrelease_passes++;
+    }
+    pools_unlock(locked);
+    return (Py_ssize_t)n;
+#else
+    return 0;
+#endif
+}
+
+/* Advise the kernel to back the arenas with transparent huge pages, see
+   PyConfig.malloc_hugepages. */
+void
+_PyObject_SetArenaHugePages(int enable)
+{
+#if defined(ARENAS_USE_MMAP) && defined(MADV_HUGEPAGE)
+    int locked = pools_lock();
+    if (enable && !arena_hugepages
+        && _PyObject_Arena.alloc == _PyObject_ArenaMmap)
+    {
+        /* Advise the arenas allocated so far */
+        for (uint i = 0; i < maxarenas; i++) {
+            if (arenas[i].address != 0
+                && madvise((void *)arenas[i].address, ARENA_SIZE,
+                           MADV_HUGEPAGE) == 0)
+            {
+                narenas_hugepages++;
+            }
+        }
+    }
+    arena_hugepages = enable;
+    pools_unlock(locked);
+#endif
+}
+
+#ifdef Py_DEBUG
+/* Is target in the list?  The list is traversed via the nextpool pointers.
+ * The list may be NULL-terminated, or circular.  Return 1 if target is in
+ * list, else 0.
+ */
+static int
+pool_is_in_list(const poolp target, poolp list)
+{
+    poolp origlist = list;
+    assert(target != NULL);
+    if (list == NULL)
+        return 0;
+    do {
+        if (target == list)
+            return 1;
+        list = list->nextpool;
+    } while (list != NULL && list != origlist);
+    return 0;
+}
+#endif
+
+int
+_PyObject_GetMallocStats(struct _PyObject_MallocStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    if (!_PyMem_PymallocEnabled()) {
+        return 0;
+    }
+    int locked = pools_lock();
+    stats->arenas_allocated = narenas_currently_allocated;
+    stats->arenas_allocated_total = ntimes_arena_allocated;
+    stats->arenas_highwater = narenas_highwater;
+#ifdef ARENAS_USE_MMAP
+    stats->arenas_hugepages = narenas_hugepages;
+#endif
+    stats->pools_released = npools_released;
+    stats->pools_released_total = ntimes_pool_released;
+    stats->release_passes = nrelease_passes;
+    stats->bytes_released = npools_released * (POOL_SIZE - release_page_size());
+    stats->arena_size = ARENA_SIZE;
+    stats->pool_size = POOL_SIZE;
+
+    const uint numclasses = SMALL_REQUEST_THRESHOLD >> ALIGNMENT_SHIFT;
+    Py_BUILD_ASSERT(NB_SMALL_SIZE_CLASSES <= _PyObject_MAX_SIZE_CLASSES);
+    /* # of pools, allocated blocks, and free blocks per class index */
+    size_t numpools[NB_SMALL_SIZE_CLASSES] = {0};
+    size_t numblocks[NB_SMALL_SIZE_CLASSES] = {0};
+    size_t numfreeblocks[NB_SMALL_SIZE_CLASSES] = {0};
+    size_t narenas = 0;
+
+    /* Because full pools aren't linked to from anything, it's easiest
+     * to march over all the arenas.  If we're lucky, most of the memory
+     * will be living in full pools -- would be a shame to miss them.
+     */
+    for (uint i = 0; i < maxarenas; ++i) {
+        uintptr_t base = arenas[i].address;
+
+        /* Skip arenas which are not allocated. */
+        if (arenas[i].address == (uintptr_t)NULL)
+            continue;
+        narenas += 1;
+
+        stats->pools_free += arenas[i].nfreepools;
+
+        /* round up to pool alignment */
+        if (base & (uintptr_t)POOL_SIZE_MASK) {
+            stats->bytes_arena_alignment += POOL_SIZE;
+            base &= ~(uintptr_t)POOL_SIZE_MASK;
+            base += POOL_SIZE;
+        }
+
+        /* visit every pool in the arena */
+        assert(base <= (uintptr_t) arenas[i].pool_address);
+        for (; base < (uintptr_t) arenas[i].pool_address; base += POOL_SIZE) {
+            poolp p = (poolp)base;
+            const uint sz = p->szidx;
+            uint freeblocks;
+
+            if (p->ref.count == 0) {
+                /* currently unused */
+#ifdef Py_DEBUG
+                assert(pool_is_in_list(p, arenas[i].freepools));
+#endif
+                continue;
+            }
+            ++numpools[sz];
+            numblocks[sz] += p->ref.count;
+            freeblocks = NUMBLOCKS(sz) - p->ref.count;
+            numfreeblocks[sz] += freeblocks;
+#ifdef Py_DEBUG
+            if (freeblocks > 0)
+                assert(pool_is_in_list(p, usedpools[sz + sz]));
+#endif
+        }
+    }
+    assert(narenas == narenas_currently_allocated);
+    (void)narenas;
+
+    for (uint i = 0; i < numclasses; ++i) {
+        size_t p = numpools[i];
+        size_t b = numblocks[i];
+        size_t f = numfreeblocks[i];
+        uint size = INDEX2SIZE(i);
+        if (p == 0) {
+            assert(b == 0 && f == 0);
+            continue;
+        }
+        size_t c = (size_t)cached_blocks(i);
+        stats->bytes_allocated += (b - c) * size;
+        stats->bytes_available += f * size;
+        stats->bytes_cached += c * size;
+        stats->bytes_pool_headers += p * POOL_OVERHEAD;
+        stats->bytes_quantization += p * ((POOL_SIZE - POOL_OVERHEAD) % size);
+
+        size_t n = stats->nsize_classes++;
+        stats->size_classes[n].block_size = size;
+        stats->size_classes[n].pools = p;
+        stats->size_classes[n].blocks = b;
+        stats->size_classes[n].free_blocks = f;
+    }
+
+#if WITH_PYMALLOC_RADIX_TREE
+    stats->bytes_arena_map = sizeof(arena_map_root);
+#ifdef USE_INTERIOR_NODES
+    stats->arena_map_mid_nodes = arena_map_mid_count;
+    stats->arena_map_bot_nodes = arena_map_bot_count;
+    stats->bytes_arena_map += sizeof(arena_map_mid_t) * arena_map_mid_count
+                              + sizeof(arena_map_bot_t) * arena_map_bot_count;
+#endif
+#endif
+    pools_unlock(locked);
+    return 1;
+}
+
 #else   /* ! WITH_PYMALLOC */
 
 /*==========================================================================*/
@@ -2387,6 +2912,40 @@ _Py_GetAllocatedBlocks(void)
     return 0;
 }
 
+Py_ssize_t
+_PyObject_RetireUsedPools(void)
+{
+    return 0;
+}
+
+void
+_PyMem_InitCache(struct _Py_obmalloc_cache *cache)
+{
+}
+
+void
+_PyMem_ClearCache(struct _Py_obmalloc_cache *cache)
+{
+}
+
+Py_ssize_t
+_PyObject_ReleaseFreePools(void)
+{
+    return 0;
+}
+
+void
+_PyObject_SetArenaHugePages(int enable)
+{
+}
+
+int
+_PyObject_GetMallocStats(struct _PyObject_MallocStats *stats)
+{
+    memset(stats, 0, sizeof(*stats));
+    return 0;
+}
+
 #endif /* WITH_PYMALLOC */
 
 
@@ -2927,27 +3486,6 @@ _PyDebugAllocatorStats(FILE *out,
 
 #ifdef WITH_PYMALLOC
 
-#ifdef Py_DEBUG
-/* Is target in the list?  The list is traversed via the nextpool pointers.
- * The list may be NULL-terminated, or circular.  Return 1 if target is in
- * list, else 0.
- */
-static int
-pool_is_in_list(const poolp target, poolp list)
-{
-    poolp origlist = list;
-    assert(target != NULL);
-    if (list == NULL)
-        return 0;
-    do {
-        if (target == list)
-            return 1;
-        list = list->nextpool;
-    } while (list != NULL && list != origlist);
-    return 0;
-}
-#endif
-
 /* Print summary info to "out" about the state of pymalloc's structures.
  * In Py_DEBUG mode, also perform some expensive internal consistency
  * checks.
@@ -2958,33 +3496,13 @@ pool_is_in_list(const poolp target, poolp list)
 int
 _PyObject_DebugMallocStats(FILE *out)
 {
-    if (!_PyMem_PymallocEnabled()) {
+    struct _PyObject_MallocStats stats;
+    if (!_PyObject_GetMallocStats(&stats)) {
         return 0;
     }
 
-    uint i;
     const uint numclasses = SMALL_REQUEST_THRESHOLD >> ALIGNMENT_SHIFT;
-    /* # of pools, allocated blocks, and free blocks per class index */
-    size_t numpools[SMALL_REQUEST_THRESHOLD >> ALIGNMENT_SHIFT];
-    size_t numblocks[SMALL_REQUEST_THRESHOLD >> ALIGNMENT_SHIFT];
-    size_t numfreeblocks[SMALL_REQUEST_THRESHOLD >> ALIGNMENT_SHIFT];
-    /* total # of allocated bytes in used and full pools */
-    size_t allocated_bytes = 0;
-    /* total # of available bytes in used pools */
-    size_t available_bytes = 0;
-    /* # of free pools + pools not yet carved out of current arena */
-    uint numfreepools = 0;
-    /* # of bytes for arena alignment padding */
-    size_t arena_alignment = 0;
-    /* # of bytes in used and full pools used for pool_headers */
-    size_t pool_header_bytes = 0;
-    /* # of bytes in used and full pools wasted due to quantization,
-     * i.e. the necessarily leftover space at the ends of used and
-     * full pools.
-     */
-    size_t quantization = 0;
-    /* # of arenas actually allocated. */
-    size_t narenas = 0;
+    size_t narenas = stats.arenas_allocated;
     /* running total -- should equal narenas * ARENA_SIZE */
     size_t total;
     char buf[128];
@@ -2992,78 +3510,18 @@ _PyObject_DebugMallocStats(FILE *out)
     fprintf(out, "Small block threshold = %d, in %u size classes.\n",
             SMALL_REQUEST_THRESHOLD, numclasses);
 
-    for (i = 0; i < numclasses; ++i)
-        numpools[i] = numblocks[i] = numfreeblocks[i] = 0;
-
-    /* Because full pools aren't linked to from anything, it's easiest
-     * to march over all the arenas.  If we're lucky, most of the memory
-     * will be living in full pools -- would be a shame to miss them.
-     */
-    for (i = 0; i < maxarenas; ++i) {
-        uint j;
-        uintptr_t base = arenas[i].address;
-
-        /* Skip arenas which are not allocated. */
-        if (arenas[i].address == (uintptr_t)NULL)
-            continue;
-        narenas += 1;
-
-        numfreepools += arenas[i].nfreepools;
-
-        /* round up to pool alignment */
-        if (base & (uintptr_t)POOL_SIZE_MASK) {
-            arena_alignment += POOL_SIZE;
-            base &= ~(uintptr_t)POOL_SIZE_MASK;
-            base += POOL_SIZE;
-        }
-
-        /* visit every pool in the arena */
-        assert(base <= (uintptr_t) arenas[i].pool_address);
-        for (j = 0; base < (uintptr_t) arenas[i].pool_address;
-             ++j, base += POOL_SIZE) {
-            poolp p = (poolp)base;
-            const uint sz = p->szidx;
-            uint freeblocks;
-
-            if (p->ref.count == 0) {
-                /* currently unused */
-#ifdef Py_DEBUG
-                assert(pool_is_in_list(p, arenas[i].freepools));
-#endif
-                continue;
-            }
-            ++numpools[sz];
-            numblocks[sz] += p->ref.count;
-            freeblocks = NUMBLOCKS(sz) - p->ref.count;
-            numfreeblocks[sz] += freeblocks;
-#ifdef Py_DEBUG
-            if (freeblocks > 0)
-                assert(pool_is_in_list(p, usedpools[sz + sz]));
-#endif
-        }
-    }
-    assert(narenas == narenas_currently_allocated);
-
     fputc('\n', out);
     fputs("class   size   num pools   blocks in use  avail blocks\n"
           "-----   ----   ---------   -------------  ------------\n",
           out);
 
-    for (i = 0; i < numclasses; ++i) {
-        size_t p = numpools[i];
-        size_t b = numblocks[i];
-        size_t f = numfreeblocks[i];
-        uint size = INDEX2SIZE(i);
-        if (p == 0) {
-            assert(b == 0 && f == 0);
-            continue;
-        }
-        fprintf(out, "%5u %6u %11zu %15zu %13zu\n",
-                i, size, p, b, f);
-        allocated_bytes += b * size;
-        available_bytes += f * size;
-        pool_header_bytes += p * POOL_OVERHEAD;
-        quantization += p * ((POOL_SIZE - POOL_OVERHEAD) % size);
+    for (size_t i = 0; i < stats.nsize_classes; ++i) {
+        size_t size = stats.size_classes[i].block_size;
+        fprintf(out, "%5zu %6zu %11zu %15zu %13zu\n",
+                (size >> ALIGNMENT_SHIFT) - 1, size,
+                stats.size_classes[i].pools,
+                stats.size_classes[i].blocks,
+                stats.size_classes[i].free_blocks);
     }
     fputc('\n', out);
 #ifdef PYMEM_DEBUG_SERIALNO
@@ -3075,6 +3533,13 @@ _PyObject_DebugMallocStats(FILE *out)
     (void)printone(out, "# arenas reclaimed", ntimes_arena_allocated - narenas);
     (void)printone(out, "# arenas highwater mark", narenas_highwater);
     (void)printone(out, "# arenas allocated current", narenas);
+#ifdef ARENAS_USE_MMAP
+    (void)printone(out, "# arenas advised to use huge pages",
+                   narenas_hugepages);
+#endif
+    (void)printone(out, "# free pools released current", npools_released);
+    (void)printone(out, "# free pools released total", ntimes_pool_released);
+    (void)printone(out, "# free pool release passes", nrelease_passes);
 
     PyOS_snprintf(buf, sizeof(buf),
                   "%zu arenas * %d bytes/arena",
@@ -3084,16 +3549,20 @@ _PyObject_DebugMallocStats(FILE *out)
     fputc('\n', out);
 
     /* Account for what all of those arena bytes are being used for. */
-    total = printone(out, "# bytes in allocated blocks", allocated_bytes);
-    total += printone(out, "# bytes in available blocks", available_bytes);
+    total = printone(out, "# bytes in allocated blocks", stats.bytes_allocated);
+    total += printone(out, "# bytes in available blocks", stats.bytes_available);
+    total += printone(out, "# bytes in interpreter caches", stats.bytes_cached);
 
     PyOS_snprintf(buf, sizeof(buf),
-        "%u unused pools * %d bytes", numfreepools, POOL_SIZE);
-    total += printone(out, buf, (size_t)numfreepools * POOL_SIZE);
-
-    total += printone(out, "# bytes lost to pool headers", pool_header_bytes);
-    total += printone(out, "# bytes lost to quantization", quantization);
-    total += printone(out, "# bytes lost to arena alignment", arena_alignment);
+        "%zu unused pools * %d bytes", stats.pools_free, POOL_SIZE);
+    total += printone(out, buf, stats.pools_free * POOL_SIZE);
+
+    total += printone(out, "# bytes lost to pool headers",
+                      stats.bytes_pool_headers);
+    total += printone(out, "# bytes lost to quantization",
+                      stats.bytes_quantization);
+    total += printone(out, "# bytes lost to arena alignment",
+                      stats.bytes_arena_alignment);
     (void)printone(out, "Total", total);
     assert(narenas * ARENA_SIZE == total);
 
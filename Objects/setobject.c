@@ -1851,8 +1851,8 @@ PyDoc_STRVAR(add_doc,
 \n\
 This has no effect if the element is already present.");
 
-static int
-set_contains(PySetObject *so, PyObject *key)
+int
+_PySet_Contains(PySetObject *so, PyObject *key)
 {
     PyObject *tmpkey;
     int rv;
@@ -1876,7 +1876,7 @@ set_direct_contains(PySetObject *so, PyObject *key)
 {
     long result;
 
-    result = set_contains(so, key);
+    result = _PySet_Contains(so, key);
     if (result < 0)
         return NULL;
     return PyBool_FromLong(result);
@@ -2025,7 +2025,7 @@ static PySequenceMethods set_as_sequence = {
     0,                                  /* sq_slice */
     0,                                  /* sq_ass_item */
     0,                                  /* sq_ass_slice */
-    (objobjproc)set_contains,           /* sq_contains */
+    (objobjproc)_PySet_Contains,        /* sq_contains */
 };
 
 /* set object ********************************************************/
@@ -391,11 +391,14 @@ assign_version_tag(struct type_cache *cache, PyTypeObject *type)
         return 0;
     }
 
+    int locked = _PyRuntimeState_LockObjects(&_PyRuntime);
     if (next_version_tag == 0) {
         /* We have run out of version numbers */
+        _PyRuntimeState_UnlockObjects(&_PyRuntime, locked);
         return 0;
     }
     type->tp_version_tag = next_version_tag++;
+    _PyRuntimeState_UnlockObjects(&_PyRuntime, locked);
     assert (type->tp_version_tag != 0);
 
     PyObject *bases = type->tp_bases;
@@ -6552,10 +6555,79 @@ PyType_Ready(PyTypeObject *type)
     /* All done -- set the ready flag */
     type->tp_flags = (type->tp_flags & ~Py_TPFLAGS_READYING) | Py_TPFLAGS_READY;
     assert(_PyType_CheckConsistency(type));
+
+    /* A static type readied once the interpreters have their own GIL is
+       shared like those readied before */
+    if (_PyRuntime.ceval.own_gils && !(type->tp_flags & Py_TPFLAGS_HEAPTYPE)) {
+        _PyType_SetStaticTypePinned(type, 1);
+    }
     return 0;
 }
 
 
+/* Pin or unpin a static type, the objects of its dictionary and its static
+   subclasses, which all interpreters share: see
+   _PyObject_SetSharedObjectsPinned(). */
+void
+_PyType_SetStaticTypePinned(PyTypeObject *type, int pinned)
+{
+    assert(!(type->tp_flags & Py_TPFLAGS_HEAPTYPE));
+    _PyObject_SetPinned((PyObject *)type, pinned);
+
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    if (type->tp_dict != NULL) {
+        _PyObject_SetPinned(type->tp_dict, pinned);
+        while (PyDict_Next(type->tp_dict, &pos, &key, &value)) {
+            _PyObject_SetPinned(key, pinned);
+            _PyObject_SetPinned(value, pinned);
+        }
+    }
+    if (type->tp_mro != NULL) {
+        _PyObject_SetPinned(type->tp_mro, pinned);
+    }
+    if (type->tp_bases != NULL) {
+        _PyObject_SetPinned(type->tp_bases, pinned);
+    }
+
+    PyObject *subclasses = type->tp_subclasses;
+    if (subclasses == NULL) {
+        return;
+    }
+    /* See add_subclass() */
+    if (pinned && _PyObject_GC_IS_TRACKED(subclasses)) {
+        _PyObject_GC_UNTRACK(subclasses);
+    }
+    pos = 0;
+    while (PyDict_Next(subclasses, &pos, NULL, &value)) {
+        PyObject *sub = PyWeakref_GET_OBJECT(value);
+        if (sub != Py_None
+            && !(((PyTypeObject *)sub)->tp_flags & Py_TPFLAGS_HEAPTYPE))
+        {
+            _PyType_SetStaticTypePinned((PyTypeObject *)sub, pinned);
+        }
+    }
+}
+
+
+/* Once subinterpreters run under their own GIL, several threads can update
+   the subclasses of a static type at once.  The lock is only held during
+   dictionary updates, which cannot run Python code. */
+static int
+lock_static_subclasses(PyTypeObject *base)
+{
+    if (base->tp_flags & Py_TPFLAGS_HEAPTYPE) {
+        return 0;
+    }
+    return _PyRuntimeState_LockObjects(&_PyRuntime);
+}
+
+static void
+unlock_static_subclasses(void)
+{
+    _PyRuntimeState_UnlockObjects(&_PyRuntime, 1);
+}
+
 static int
 add_subclass(PyTypeObject *base, PyTypeObject *type)
 {
@@ -6572,15 +6644,44 @@ add_subclass(PyTypeObject *base, PyTypeObject *type)
     // Only get tp_subclasses after creating the key and value.
     // PyWeakref_NewRef() can trigger a garbage collection which can execute
     // arbitrary Python code and so modify base->tp_subclasses.
-    PyObject *subclasses = base->tp_subclasses;
-    if (subclasses == NULL) {
-        base->tp_subclasses = subclasses = PyDict_New();
-        if (subclasses == NULL)
-            return -1;
+    // The dictionary is created before taking the lock, since PyDict_New()
+    // can also trigger a garbage collection.
+    PyObject *newdict = NULL;
+    int result;
+    while (1) {
+        if (base->tp_subclasses == NULL && newdict == NULL) {
+            newdict = PyDict_New();
+            if (newdict == NULL) {
+                result = -1;
+                break;
+            }
+        }
+        int locked = lock_static_subclasses(base);
+        PyObject *subclasses = base->tp_subclasses;
+        if (subclasses == NULL && newdict != NULL) {
+            base->tp_subclasses = subclasses = newdict;
+            newdict = NULL;
+        }
+        if (subclasses != NULL) {
+            assert(PyDict_CheckExact(subclasses));
+            result = PyDict_SetItem(subclasses, key, ref);
+            if (locked && _PyObject_GC_IS_TRACKED(subclasses)) {
+                /* Keep the dictionary out of the garbage collector lists
+                   of the interpreters: the weak references can't form a
+                   cycle.  It was tracked by the current interpreter. */
+                _PyObject_GC_UNTRACK(subclasses);
+            }
+        }
+        if (locked) {
+            unlock_static_subclasses();
+        }
+        if (subclasses != NULL) {
+            break;
+        }
+        // Another thread removed the last subclass in the meantime
     }
-    assert(PyDict_CheckExact(subclasses));
 
-    int result = PyDict_SetItem(subclasses, key, ref);
+    Py_XDECREF(newdict);
     Py_DECREF(ref);
     Py_DECREF(key);
     return result;
@@ -6605,27 +6706,36 @@ add_all_subclasses(PyTypeObject *type, PyObject *bases)
 static void
 remove_subclass(PyTypeObject *base, PyTypeObject *type)
 {
-    PyObject *subclasses = base->tp_subclasses;  // borrowed ref
-    if (subclasses == NULL) {
+    if (base->tp_subclasses == NULL) {
         return;
     }
-    assert(PyDict_CheckExact(subclasses));
 
     PyObject *key = PyLong_FromVoidPtr((void *) type);
-    if (key == NULL || PyDict_DelItem(subclasses, key)) {
-        /* This can happen if the type initialization errored out before
-           the base subclasses were updated (e.g. a non-str __qualname__
-           was passed in the type dict). */
+    int locked = lock_static_subclasses(base);
+    PyObject *subclasses = base->tp_subclasses;  // borrowed ref
+    if (subclasses != NULL) {
+        assert(PyDict_CheckExact(subclasses));
+        if (key == NULL || PyDict_DelItem(subclasses, key)) {
+            /* This can happen if the type initialization errored out before
+               the base subclasses were updated (e.g. a non-str __qualname__
+               was passed in the type dict). */
+            PyErr_Clear();
+        }
+
+        if (PyDict_Size(subclasses) == 0) {
+            // Delete the dictionary to save memory. _PyStaticType_Dealloc()
+            // callers also test if tp_subclasses is NULL to check if a static
+            // type has no subclass.
+            Py_CLEAR(base->tp_subclasses);
+        }
+    }
+    else if (key == NULL) {
         PyErr_Clear();
     }
-    Py_XDECREF(key);
-
-    if (PyDict_Size(subclasses) == 0) {
-        // Delete the dictionary to save memory. _PyStaticType_Dealloc()
-        // callers also test if tp_subclasses is NULL to check if a static type
-        // has no subclass.
-        Py_CLEAR(base->tp_subclasses);
+    if (locked) {
+        unlock_static_subclasses();
     }
+    Py_XDECREF(key);
 }
 
 static void
@@ -7670,17 +7780,17 @@ slot_tp_call(PyObject *self, PyObject *args, PyObject *kwds)
 
 /* There are two slot dispatch functions for tp_getattro.
 
-   - slot_tp_getattro() is used when __getattribute__ is overridden
+   - _Py_slot_tp_getattro() is used when __getattribute__ is overridden
      but no __getattr__ hook is present;
 
-   - slot_tp_getattr_hook() is used when a __getattr__ hook is present.
+   - _Py_slot_tp_getattr_hook() is used when a __getattr__ hook is present.
 
-   The code in update_one_slot() always installs slot_tp_getattr_hook(); this
-   detects the absence of __getattr__ and then installs the simpler slot if
-   necessary. */
+   The code in update_one_slot() always installs _Py_slot_tp_getattr_hook();
+   this detects the absence of __getattr__ and then installs the simpler slot
+   if necessary. */
 
-static PyObject *
-slot_tp_getattro(PyObject *self, PyObject *name)
+PyObject *
+_Py_slot_tp_getattro(PyObject *self, PyObject *name)
 {
     PyObject *stack[2] = {self, name};
     return vectorcall_method(&_Py_ID(__getattribute__), stack, 2);
@@ -7704,8 +7814,8 @@ call_attribute(PyObject *self, PyObject *attr, PyObject *name)
     return res;
 }
 
-static PyObject *
-slot_tp_getattr_hook(PyObject *self, PyObject *name)
+PyObject *
+_Py_slot_tp_getattr_hook(PyObject *self, PyObject *name)
 {
     PyTypeObject *tp = Py_TYPE(self);
     PyObject *getattr, *getattribute, *res;
@@ -7718,8 +7828,8 @@ slot_tp_getattr_hook(PyObject *self, PyObject *name)
     getattr = _PyType_Lookup(tp, &_Py_ID(__getattr__));
     if (getattr == NULL) {
         /* No __getattr__ hook: use a simpler dispatcher */
-        tp->tp_getattro = slot_tp_getattro;
-        return slot_tp_getattro(self, name);
+        tp->tp_getattro = _Py_slot_tp_getattro;
+        return _Py_slot_tp_getattro(self, name);
     }
     Py_INCREF(getattr);
     /* speed hack: we could use lookup_maybe, but that would resolve the
@@ -8079,10 +8189,10 @@ static slotdef slotdefs[] = {
            PyWrapperFlag_KEYWORDS),
     TPSLOT("__str__", tp_str, slot_tp_str, wrap_unaryfunc,
            "__str__($self, /)\n--\n\nReturn str(self)."),
-    TPSLOT("__getattribute__", tp_getattro, slot_tp_getattr_hook,
+    TPSLOT("__getattribute__", tp_getattro, _Py_slot_tp_getattr_hook,
            wrap_binaryfunc,
            "__getattribute__($self, name, /)\n--\n\nReturn getattr(self, name)."),
-    TPSLOT("__getattr__", tp_getattro, slot_tp_getattr_hook, NULL, ""),
+    TPSLOT("__getattr__", tp_getattro, _Py_slot_tp_getattr_hook, NULL, ""),
     TPSLOT("__setattr__", tp_setattro, slot_tp_setattro, wrap_setattr,
            "__setattr__($self, name, value, /)\n--\n\nImplement setattr(self, name, value)."),
     TPSLOT("__delattr__", tp_setattro, slot_tp_setattro, wrap_delattr,
@@ -14642,23 +14642,47 @@ PyUnicode_InternInPlace(PyObject **p)
         }
     }
 
+    /* With subinterpreters running under their own GIL, several threads
+       can intern strings at once.  The strings interned then are pinned,
+       like those interned before: they are shared by the interpreters. */
+    int locked = _PyRuntimeState_LockObjects(&_PyRuntime);
+
     PyObject *t = PyDict_SetDefault(interned, s, s);
     if (t == NULL) {
         PyErr_Clear();
-        return;
     }
+    else if (t == s) {
+        /* The two references in interned dict (key and value) are not
+           counted by refcnt. unicode_dealloc() and
+           _PyUnicode_ClearInterned() take care of this. */
+        Py_SET_REFCNT(s, Py_REFCNT(s) - 2);
+        _PyUnicode_STATE(s).interned = 1;
+        if (locked) {
+            _PyObject_SetPinned(s, 1);
+        }
+    }
+    _PyRuntimeState_UnlockObjects(&_PyRuntime, locked);
 
-    if (t != s) {
+    if (t != NULL && t != s) {
         Py_INCREF(t);
         Py_SETREF(*p, t);
+    }
+}
+
+/* Pin or unpin the interned strings, see
+   _PyObject_SetSharedObjectsPinned() */
+void
+_PyUnicode_SetInternedPinned(int pinned)
+{
+    if (interned == NULL) {
         return;
     }
 
-    /* The two references in interned dict (key and value) are not counted by
-       refcnt. unicode_dealloc() and _PyUnicode_ClearInterned() take care of
-       this. */
-    Py_SET_REFCNT(s, Py_REFCNT(s) - 2);
-    _PyUnicode_STATE(s).interned = 1;
+    Py_ssize_t pos = 0;
+    PyObject *s, *ignored_value;
+    while (PyDict_Next(interned, &pos, &s, &ignored_value)) {
+        _PyObject_SetPinned(s, pinned);
+    }
 }
 
 // Function kept for the stable ABI.
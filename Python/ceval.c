@@ -13,15 +13,19 @@
 #include "pycore_ceval.h"         // _PyEval_SignalAsyncExc()
 #include "pycore_code.h"
 #include "pycore_function.h"
+#include "pycore_genobject.h"     // _PyGen_ConvertStopIteration()
 #include "pycore_initconfig.h"    // _PyStatus_OK()
+#include "pycore_list.h"          // _PyListIterObject
 #include "pycore_long.h"          // _PyLong_GetZero()
 #include "pycore_object.h"        // _PyObject_GC_TRACK()
 #include "pycore_moduleobject.h"  // PyModuleObject
 #include "pycore_opcode.h"        // EXTRA_CASES
+#include "pycore_optimizer.h"     // _PyExecutor_Execute()
 #include "pycore_pyerrors.h"      // _PyErr_Fetch()
 #include "pycore_pylifecycle.h"   // _PyErr_Print()
 #include "pycore_pymem.h"         // _PyMem_IsPtrFreed()
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
+#include "pycore_range.h"         // _PyRangeIterObject
 #include "pycore_sysmodule.h"     // _PySys_Audit()
 #include "pycore_tuple.h"         // _PyTuple_ITEMS()
 #include "pycore_emscripten_signal.h"  // _Py_CHECK_EMSCRIPTEN_SIGNALS
@@ -249,7 +253,7 @@ COMPUTE_EVAL_BREAKER(PyInterpreterState *interp,
         | (_Py_atomic_load_relaxed_int32(&ceval->signals_pending)
            && _Py_ThreadCanHandleSignals(interp))
         | (_Py_atomic_load_relaxed_int32(&ceval2->pending.calls_to_do)
-           && _Py_ThreadCanHandlePendingCalls())
+           && _Py_ThreadCanHandlePendingCalls(interp))
         | ceval2->pending.async_exc);
 }
 
@@ -355,7 +359,9 @@ _Py_FatalError_TstateNULL(const char *func)
 int
 _PyEval_ThreadsInitialized(_PyRuntimeState *runtime)
 {
-    return gil_created(&runtime->ceval.gil);
+    PyInterpreterState *interp = runtime->interpreters.main;
+    return (interp != NULL && interp->ceval.gil != NULL
+            && gil_created(interp->ceval.gil));
 }
 
 int
@@ -365,23 +371,57 @@ PyEval_ThreadsInitialized(void)
     return _PyEval_ThreadsInitialized(runtime);
 }
 
+/* Create the GIL of the interpreter of tstate and take it if own_gil is
+   non-zero, else make the interpreter share the GIL of the main interpreter.
+
+   The current thread holds a GIL when it creates a subinterpreter: it
+   releases it if the subinterpreter uses another one. */
 PyStatus
-_PyEval_InitGIL(PyThreadState *tstate)
+_PyEval_InitGIL(PyThreadState *tstate, int own_gil)
 {
-    if (!_Py_IsMainInterpreter(tstate->interp)) {
-        /* Currently, the GIL is shared by all interpreters,
-           and only the main interpreter is responsible to create
-           and destroy it. */
+    PyInterpreterState *interp = tstate->interp;
+    PyInterpreterState *main_interp = _PyInterpreterState_Main();
+
+    if (!own_gil) {
+        assert(interp != main_interp);
+        assert(gil_created(main_interp->ceval.gil));
+        interp->ceval.gil = main_interp->ceval.gil;
+        interp->ceval.own_gil = 0;
+        _PyEval_SwitchGIL(NULL, tstate);
         return _PyStatus_OK();
     }
 
-    struct _gil_runtime_state *gil = &tstate->interp->runtime->ceval.gil;
+    if (interp != main_interp) {
+#ifdef HAVE_THREAD_LOCAL
+        _PyRuntimeState *runtime = interp->runtime;
+        if (!runtime->ceval.own_gils) {
+            /* The GIL of the main interpreter is still the only one */
+            assert(held_gil == main_interp->ceval.gil);
+            PyStatus status = _PyRuntimeState_EnableOwnGILs(runtime);
+            if (_PyStatus_EXCEPTION(status)) {
+                return status;
+            }
+        }
+#else
+        return _PyStatus_ERR("a subinterpreter cannot have its own GIL "
+                             "without thread-local storage");
+#endif
+    }
+
+    struct _gil_runtime_state *gil = &interp->_gil;
     assert(!gil_created(gil));
 
     PyThread_init_thread();
     create_gil(gil);
+    interp->ceval.gil = gil;
+    interp->ceval.own_gil = 1;
 
-    take_gil(tstate);
+    if (interp != main_interp) {
+        _PyEval_SwitchGIL(NULL, tstate);
+    }
+    else {
+        take_gil(tstate);
+    }
 
     assert(gil_created(gil));
     return _PyStatus_OK();
@@ -390,22 +430,51 @@ _PyEval_InitGIL(PyThreadState *tstate)
 void
 _PyEval_FiniGIL(PyInterpreterState *interp)
 {
-    if (!_Py_IsMainInterpreter(interp)) {
-        /* Currently, the GIL is shared by all interpreters,
-           and only the main interpreter is responsible to create
-           and destroy it. */
+    struct _gil_runtime_state *gil = interp->ceval.gil;
+    if (gil == NULL || !interp->ceval.own_gil) {
+        /* First Py_InitializeFromConfig() call: the GIL doesn't exist
+           yet, or the interpreter shares the GIL of the main interpreter,
+           which destroys it: do nothing. */
         return;
     }
 
-    struct _gil_runtime_state *gil = &interp->runtime->ceval.gil;
     if (!gil_created(gil)) {
-        /* First Py_InitializeFromConfig() call: the GIL doesn't exist
-           yet: do nothing. */
         return;
     }
 
+#ifdef HAVE_THREAD_LOCAL
+    if (held_gil == gil) {
+        /* A subinterpreter is destroyed by a thread holding its GIL */
+        drop_gil(gil, NULL, NULL);
+    }
+#endif
     destroy_gil(gil);
     assert(!gil_created(gil));
+    interp->ceval.gil = NULL;
+}
+
+/* Make the current thread hold the GIL of the interpreter of newts, which
+   becomes its current thread state instead of oldts (see
+   _PyThreadState_Swap()).  The GIL held by the thread so far, if another
+   one, is released. */
+void
+_PyEval_SwitchGIL(PyThreadState *oldts, PyThreadState *newts)
+{
+#ifdef HAVE_THREAD_LOCAL
+    struct _gil_runtime_state *gil = newts->interp->ceval.gil;
+    if (gil == held_gil || gil == NULL || !gil_created(gil)) {
+        return;
+    }
+    if (held_gil != NULL) {
+        if (oldts != NULL && oldts->interp->ceval.gil == held_gil) {
+            drop_gil(held_gil, &oldts->interp->ceval, oldts);
+        }
+        else {
+            drop_gil(held_gil, NULL, NULL);
+        }
+    }
+    take_gil(newts);
+#endif
 }
 
 void
@@ -440,17 +509,15 @@ PyEval_ReleaseLock(void)
     /* This function must succeed when the current thread state is NULL.
        We therefore avoid PyThreadState_Get() which dumps a fatal error
        in debug mode. */
-    struct _ceval_runtime_state *ceval = &runtime->ceval;
-    struct _ceval_state *ceval2 = &tstate->interp->ceval;
-    drop_gil(ceval, ceval2, tstate);
+    struct _ceval_state *ceval = &tstate->interp->ceval;
+    drop_gil(ceval->gil, ceval, tstate);
 }
 
 void
 _PyEval_ReleaseLock(PyThreadState *tstate)
 {
-    struct _ceval_runtime_state *ceval = &tstate->interp->runtime->ceval;
-    struct _ceval_state *ceval2 = &tstate->interp->ceval;
-    drop_gil(ceval, ceval2, tstate);
+    struct _ceval_state *ceval = &tstate->interp->ceval;
+    drop_gil(ceval->gil, ceval, tstate);
 }
 
 void
@@ -476,9 +543,8 @@ PyEval_ReleaseThread(PyThreadState *tstate)
     if (new_tstate != tstate) {
         Py_FatalError("wrong thread state");
     }
-    struct _ceval_runtime_state *ceval = &runtime->ceval;
-    struct _ceval_state *ceval2 = &tstate->interp->ceval;
-    drop_gil(ceval, ceval2, tstate);
+    struct _ceval_state *ceval = &tstate->interp->ceval;
+    drop_gil(ceval->gil, ceval, tstate);
 }
 
 #ifdef HAVE_FORK
@@ -490,8 +556,8 @@ _PyEval_ReInitThreads(PyThreadState *tstate)
 {
     _PyRuntimeState *runtime = tstate->interp->runtime;
 
-    struct _gil_runtime_state *gil = &runtime->ceval.gil;
-    if (!gil_created(gil)) {
+    struct _gil_runtime_state *gil = tstate->interp->ceval.gil;
+    if (gil == NULL || !gil_created(gil)) {
         return _PyStatus_OK();
     }
     recreate_gil(gil);
@@ -525,10 +591,9 @@ PyEval_SaveThread(void)
     PyThreadState *tstate = _PyThreadState_Swap(&runtime->gilstate, NULL);
     _Py_EnsureTstateNotNULL(tstate);
 
-    struct _ceval_runtime_state *ceval = &runtime->ceval;
-    struct _ceval_state *ceval2 = &tstate->interp->ceval;
-    assert(gil_created(&ceval->gil));
-    drop_gil(ceval, ceval2, tstate);
+    struct _ceval_state *ceval = &tstate->interp->ceval;
+    assert(gil_created(ceval->gil));
+    drop_gil(ceval->gil, ceval, tstate);
     return tstate;
 }
 
@@ -693,17 +758,17 @@ handle_signals(PyThreadState *tstate)
 static int
 make_pending_calls(PyInterpreterState *interp)
 {
-    /* only execute pending calls on main thread */
-    if (!_Py_ThreadCanHandlePendingCalls()) {
+    /* only execute the main interpreter's pending calls on main thread */
+    if (!_Py_ThreadCanHandlePendingCalls(interp)) {
         return 0;
     }
 
     /* don't perform recursive pending calls */
-    static int busy = 0;
-    if (busy) {
+    struct _pending_calls *pending = &interp->ceval.pending;
+    if (pending->busy) {
         return 0;
     }
-    busy = 1;
+    pending->busy = 1;
 
     /* unsignal before starting to call callbacks, so that any callback
        added in-between re-signals */
@@ -711,7 +776,6 @@ make_pending_calls(PyInterpreterState *interp)
     int res = 0;
 
     /* perform a bounded number of calls, in case of recursion */
-    struct _pending_calls *pending = &interp->ceval.pending;
     for (int i=0; i<NPENDINGCALLS; i++) {
         int (*func)(void *) = NULL;
         void *arg = NULL;
@@ -731,11 +795,11 @@ make_pending_calls(PyInterpreterState *interp)
         }
     }
 
-    busy = 0;
+    pending->busy = 0;
     return res;
 
 error:
-    busy = 0;
+    pending->busy = 0;
     SIGNAL_PENDING_CALLS(interp);
     return res;
 }
@@ -789,18 +853,17 @@ Py_MakePendingCalls(void)
 /* The interpreter's recursion limit */
 
 void
-_PyEval_InitRuntimeState(struct _ceval_runtime_state *ceval)
+_PyEval_InitState(PyInterpreterState *interp, PyThread_type_lock pending_lock)
 {
-    _gil_initialize(&ceval->gil);
-}
-
-void
-_PyEval_InitState(struct _ceval_state *ceval, PyThread_type_lock pending_lock)
-{
-    struct _pending_calls *pending = &ceval->pending;
+    struct _pending_calls *pending = &interp->ceval.pending;
     assert(pending->lock == NULL);
 
     pending->lock = pending_lock;
+
+    /* The GIL is set up by _PyEval_InitGIL() */
+    _gil_initialize(&interp->_gil);
+    interp->ceval.gil = NULL;
+    interp->ceval.own_gil = 0;
 }
 
 void
@@ -1210,7 +1273,7 @@ eval_frame_handle_pending(PyThreadState *tstate)
         if (_PyThreadState_Swap(&runtime->gilstate, NULL) != tstate) {
             Py_FatalError("tstate mix-up");
         }
-        drop_gil(ceval, ceval2, tstate);
+        drop_gil(ceval2->gil, ceval2, tstate);
 
         /* Other threads may run now */
 
@@ -1632,6 +1695,24 @@ pop_frame(PyThreadState *tstate, _PyInterpreterFrame *frame)
     return prev_frame;
 }
 
+/* Pop the frame of a generator that was resumed inline by FOR_ITER_GEN,
+ * once it has returned or raised. This does the same clean up as
+ * gen_send_ex2() does when a generator finishes. */
+static _PyInterpreterFrame *
+pop_gen_frame(PyThreadState *tstate, _PyInterpreterFrame *frame)
+{
+    assert(frame->owner == FRAME_OWNED_BY_GENERATOR);
+    PyGenObject *gen = _PyFrame_GetGenerator(frame);
+    _PyInterpreterFrame *prev_frame = frame->previous;
+    frame->previous = NULL;
+    tstate->exc_info = gen->gi_exc_state.previous_item;
+    gen->gi_exc_state.previous_item = NULL;
+    _PyErr_ClearExcState(&gen->gi_exc_state);
+    gen->gi_frame_state = FRAME_CLEARED;
+    _PyFrame_Clear(frame);
+    return prev_frame;
+}
+
 /* It is only between the KW_NAMES instruction and the following CALL,
  * that this has any meaning.
  */
@@ -1846,67 +1927,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             DISPATCH();
         }
 
-        TARGET(LOAD_FAST__LOAD_FAST) {
-            PyObject *value = GETLOCAL(oparg);
-            assert(value != NULL);
-            NEXTOPARG();
-            next_instr++;
-            Py_INCREF(value);
-            PUSH(value);
-            value = GETLOCAL(oparg);
-            assert(value != NULL);
-            Py_INCREF(value);
-            PUSH(value);
-            NOTRACE_DISPATCH();
-        }
-
-        TARGET(LOAD_FAST__LOAD_CONST) {
-            PyObject *value = GETLOCAL(oparg);
-            assert(value != NULL);
-            NEXTOPARG();
-            next_instr++;
-            Py_INCREF(value);
-            PUSH(value);
-            value = GETITEM(consts, oparg);
-            Py_INCREF(value);
-            PUSH(value);
-            NOTRACE_DISPATCH();
-        }
-
-        TARGET(STORE_FAST__LOAD_FAST) {
-            PyObject *value = POP();
-            SETLOCAL(oparg, value);
-            NEXTOPARG();
-            next_instr++;
-            value = GETLOCAL(oparg);
-            assert(value != NULL);
-            Py_INCREF(value);
-            PUSH(value);
-            NOTRACE_DISPATCH();
-        }
-
-        TARGET(STORE_FAST__STORE_FAST) {
-            PyObject *value = POP();
-            SETLOCAL(oparg, value);
-            NEXTOPARG();
-            next_instr++;
-            value = POP();
-            SETLOCAL(oparg, value);
-            NOTRACE_DISPATCH();
-        }
-
-        TARGET(LOAD_CONST__LOAD_FAST) {
-            PyObject *value = GETITEM(consts, oparg);
-            NEXTOPARG();
-            next_instr++;
-            Py_INCREF(value);
-            PUSH(value);
-            value = GETLOCAL(oparg);
-            assert(value != NULL);
-            Py_INCREF(value);
-            PUSH(value);
-            NOTRACE_DISPATCH();
-        }
+#include "superinstructions.h"
 
         TARGET(POP_TOP) {
             PyObject *value = POP();
@@ -2073,8 +2094,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             DEOPT_IF(!PyUnicode_CheckExact(left), BINARY_OP);
             DEOPT_IF(Py_TYPE(right) != Py_TYPE(left), BINARY_OP);
             _Py_CODEUNIT true_next = next_instr[INLINE_CACHE_ENTRIES_BINARY_OP];
-            assert(_Py_OPCODE(true_next) == STORE_FAST ||
-                   _Py_OPCODE(true_next) == STORE_FAST__LOAD_FAST);
+            assert(_PyOpcode_Deopt[_Py_OPCODE(true_next)] == STORE_FAST);
             PyObject **target_local = &GETLOCAL(_Py_OPARG(true_next));
             DEOPT_IF(*target_local != left, BINARY_OP);
             STAT_INC(BINARY_OP, hit);
@@ -2142,6 +2162,235 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             NOTRACE_DISPATCH();
         }
 
+        TARGET(BINARY_OP_AND_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            STAT_INC(BINARY_OP, hit);
+            PyObject *res = PyLong_FromSsize_t(a & b);
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_OR_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            STAT_INC(BINARY_OP, hit);
+            PyObject *res = PyLong_FromSsize_t(a | b);
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_XOR_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            STAT_INC(BINARY_OP, hit);
+            PyObject *res = PyLong_FromSsize_t(a ^ b);
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_LSHIFT_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            DEOPT_IF(b < 0 || b > _PyLong_MAX_COMPACT_LSHIFT, BINARY_OP);
+            STAT_INC(BINARY_OP, hit);
+            /* Multiply, as left shifts of negative values are undefined */
+            PyObject *res = PyLong_FromLongLong((long long)a * (1LL << b));
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_RSHIFT_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            DEOPT_IF(b < 0, BINARY_OP);
+            STAT_INC(BINARY_OP, hit);
+            b = Py_MIN(b, (Py_ssize_t)(8 * sizeof(Py_ssize_t) - 1));
+            PyObject *res = PyLong_FromSsize_t(
+                Py_ARITHMETIC_RIGHT_SHIFT(Py_ssize_t, a, b));
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_FLOOR_DIVIDE_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            DEOPT_IF(b == 0, BINARY_OP);
+            STAT_INC(BINARY_OP, hit);
+            /* Round towards minus infinity, not towards zero */
+            Py_ssize_t div = a / b;
+            if (a % b != 0 && (a < 0) != (b < 0)) {
+                div--;
+            }
+            PyObject *res = PyLong_FromSsize_t(div);
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_REMAINDER_INT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+            DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+            DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+            Py_ssize_t a = _PyLong_CompactValue((PyLongObject *)left);
+            Py_ssize_t b = _PyLong_CompactValue((PyLongObject *)right);
+            DEOPT_IF(b == 0, BINARY_OP);
+            STAT_INC(BINARY_OP, hit);
+            /* The result has the sign of the divisor */
+            Py_ssize_t mod = a % b;
+            if (mod != 0 && (mod < 0) != (b < 0)) {
+                mod += b;
+            }
+            PyObject *res = PyLong_FromSsize_t(mod);
+            SET_SECOND(res);
+            _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            _Py_DECREF_SPECIALIZED(left, (destructor)PyObject_Free);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(BINARY_OP_MIXED_INT_FLOAT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *left = SECOND();
+            PyObject *right = TOP();
+            /* One operand is a float, the other a compact int.  The value
+             * of a compact int is exactly representable as a double, so
+             * this gives the same result as float_add() and friends. */
+            double dleft, dright;
+            if (PyFloat_CheckExact(left)) {
+                DEOPT_IF(!PyLong_CheckExact(right), BINARY_OP);
+                DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)right), BINARY_OP);
+                dleft = ((PyFloatObject *)left)->ob_fval;
+                dright = (double)_PyLong_CompactValue((PyLongObject *)right);
+            }
+            else {
+                DEOPT_IF(!PyFloat_CheckExact(right), BINARY_OP);
+                DEOPT_IF(!PyLong_CheckExact(left), BINARY_OP);
+                DEOPT_IF(!_PyLong_IsCompact((PyLongObject *)left), BINARY_OP);
+                dleft = (double)_PyLong_CompactValue((PyLongObject *)left);
+                dright = ((PyFloatObject *)right)->ob_fval;
+            }
+            STAT_INC(BINARY_OP, hit);
+            double dres;
+            switch (oparg) {
+                case NB_ADD:
+                case NB_INPLACE_ADD:
+                    dres = dleft + dright;
+                    break;
+                case NB_SUBTRACT:
+                case NB_INPLACE_SUBTRACT:
+                    dres = dleft - dright;
+                    break;
+                case NB_MULTIPLY:
+                case NB_INPLACE_MULTIPLY:
+                    dres = dleft * dright;
+                    break;
+                default:
+                    Py_UNREACHABLE();
+            }
+            PyObject *res = PyFloat_FromDouble(dres);
+            SET_SECOND(res);
+            Py_DECREF(right);
+            Py_DECREF(left);
+            STACK_SHRINK(1);
+            if (res == NULL) {
+                goto error;
+            }
+            JUMPBY(INLINE_CACHE_ENTRIES_BINARY_OP);
+            NOTRACE_DISPATCH();
+        }
+
         TARGET(BINARY_SUBSCR) {
             PREDICTED(BINARY_SUBSCR);
             PyObject *sub = POP();
@@ -2355,6 +2604,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             STAT_INC(STORE_SUBSCR, hit);
 
             PyObject *old_value = PyList_GET_ITEM(list, index);
+            _PyList_MaintainTracking((PyListObject *)list, value);
             PyList_SET_ITEM(list, index, value);
             STACK_SHRINK(3);
             assert(old_value != NULL);
@@ -2444,6 +2694,57 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             DTRACE_FUNCTION_EXIT();
             _Py_LeaveRecursiveCallTstate(tstate);
             if (!frame->is_entry) {
+                if (frame->owner == FRAME_OWNED_BY_GENERATOR) {
+                    /* The generator was resumed by FOR_ITER_GEN or SEND_GEN
+                     * and is now exhausted.  Both have a single cache entry,
+                     * so the resuming instruction is just before it. */
+                    frame = cframe.current_frame = pop_gen_frame(tstate, frame);
+                    _Py_CODEUNIT *resumer = frame->prev_instr - 1;
+                    PyObject *gen = _PyFrame_StackPop(frame);
+                    Py_DECREF(gen);
+                    if (_PyOpcode_Deopt[_Py_OPCODE(*resumer)] == SEND) {
+                        /* The return value replaces the delegate */
+                        assert(INLINE_CACHE_ENTRIES_SEND == 1);
+                        _PyFrame_StackPush(frame, retval);
+                    }
+                    else {
+                        /* The loop is exited as the generic FOR_ITER would
+                         * do, discarding the return value */
+                        assert(INLINE_CACHE_ENTRIES_FOR_ITER == 1);
+                        assert(_PyOpcode_Deopt[_Py_OPCODE(*resumer)] == FOR_ITER);
+                        Py_DECREF(retval);
+                    }
+                    frame->prev_instr += _Py_OPARG(*resumer);
+                    goto resume_frame;
+                }
+                if (frame->is_init) {
+                    /* The new instance is already on the caller's stack */
+                    frame = cframe.current_frame = pop_frame(tstate, frame);
+                    if (retval != Py_None) {
+                        _PyErr_Format(tstate, PyExc_TypeError,
+                                      "__init__() should return None, "
+                                      "not '%.200s'",
+                                      Py_TYPE(retval)->tp_name);
+                        Py_DECREF(retval);
+                        goto resume_with_error;
+                    }
+                    Py_DECREF(retval);
+                    goto resume_frame;
+                }
+                if (frame->is_init) {
+                    /* The new instance is already on the caller's stack */
+                    frame = cframe.current_frame = pop_frame(tstate, frame);
+                    if (retval != Py_None) {
+                        _PyErr_Format(tstate, PyExc_TypeError,
+                                      "__init__() should return None, "
+                                      "not '%.200s'",
+                                      Py_TYPE(retval)->tp_name);
+                        Py_DECREF(retval);
+                        goto resume_with_error;
+                    }
+                    Py_DECREF(retval);
+                    goto resume_frame;
+                }
                 frame = cframe.current_frame = pop_frame(tstate, frame);
                 _PyFrame_StackPush(frame, retval);
                 goto resume_frame;
@@ -2587,7 +2888,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
         }
 
         TARGET(SEND) {
-            assert(frame->is_entry);
+            PREDICTED(SEND);
             assert(STACK_LEVEL() >= 2);
             PyObject *v = POP();
             PyObject *receiver = TOP();
@@ -2626,15 +2927,57 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
                 assert(retval != NULL);
                 Py_DECREF(receiver);
                 SET_TOP(retval);
-                JUMPBY(oparg);
+                JUMPBY(INLINE_CACHE_ENTRIES_SEND + oparg);
                 DISPATCH();
             }
             assert(gen_status == PYGEN_NEXT);
             assert(retval != NULL);
             PUSH(retval);
+            JUMPBY(INLINE_CACHE_ENTRIES_SEND);
             DISPATCH();
         }
 
+        TARGET(SEND_ADAPTIVE) {
+            assert(cframe.use_tracing == 0);
+            _PySendCache *cache = (_PySendCache *)next_instr;
+            if (ADAPTIVE_COUNTER_IS_ZERO(cache)) {
+                next_instr--;
+                _Py_Specialize_Send(SECOND(), next_instr, oparg);
+                NOTRACE_DISPATCH_SAME_OPARG();
+            }
+            else {
+                STAT_INC(SEND, deferred);
+                DECREMENT_ADAPTIVE_COUNTER(cache);
+                JUMP_TO_INSTRUCTION(SEND);
+            }
+        }
+
+        TARGET(SEND_GEN) {
+            assert(cframe.use_tracing == 0);
+            DEOPT_IF(tstate->interp->eval_frame, SEND);
+            PyGenObject *gen = (PyGenObject *)SECOND();
+            DEOPT_IF(Py_TYPE(gen) != &PyGen_Type &&
+                     Py_TYPE(gen) != &PyCoro_Type, SEND);
+            DEOPT_IF(gen->gi_frame_state >= FRAME_EXECUTING, SEND);
+            PyObject *v = TOP();
+            DEOPT_IF(gen->gi_frame_state == FRAME_CREATED && !Py_IsNone(v),
+                     SEND);
+            STAT_INC(SEND, hit);
+            _PyInterpreterFrame *gen_frame = (_PyInterpreterFrame *)gen->gi_iframe;
+            STACK_SHRINK(1);
+            _PyFrame_StackPush(gen_frame, v);
+            gen->gi_frame_state = FRAME_EXECUTING;
+            gen->gi_exc_state.previous_item = tstate->exc_info;
+            tstate->exc_info = &gen->gi_exc_state;
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            JUMPBY(INLINE_CACHE_ENTRIES_SEND);
+            frame->prev_instr = next_instr - 1;
+            gen_frame->previous = frame;
+            gen_frame->is_entry = false;
+            frame = cframe.current_frame = gen_frame;
+            goto start_frame;
+        }
+
         TARGET(ASYNC_GEN_WRAP) {
             PyObject *v = TOP();
             assert(frame->f_code->co_flags & CO_ASYNC_GENERATOR);
@@ -2649,13 +2992,24 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
 
         TARGET(YIELD_VALUE) {
             assert(oparg == STACK_LEVEL());
-            assert(frame->is_entry);
             PyObject *retval = POP();
-            _PyFrame_GetGenerator(frame)->gi_frame_state = FRAME_SUSPENDED;
+            PyGenObject *gen = _PyFrame_GetGenerator(frame);
+            gen->gi_frame_state = FRAME_SUSPENDED;
             _PyFrame_SetStackPointer(frame, stack_pointer);
             TRACE_FUNCTION_EXIT();
             DTRACE_FUNCTION_EXIT();
             _Py_LeaveRecursiveCallTstate(tstate);
+            if (!frame->is_entry) {
+                /* Resumed by FOR_ITER_GEN or SEND_GEN: hand the value
+                 * straight back to the previous frame. */
+                tstate->exc_info = gen->gi_exc_state.previous_item;
+                gen->gi_exc_state.previous_item = NULL;
+                _PyInterpreterFrame *gen_frame = frame;
+                frame = cframe.current_frame = frame->previous;
+                gen_frame->previous = NULL;
+                _PyFrame_StackPush(frame, retval);
+                goto resume_frame;
+            }
             /* Restore previous cframe and return. */
             tstate->cframe = cframe.previous;
             tstate->cframe->use_tracing = cframe.use_tracing;
@@ -3238,25 +3592,19 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
         }
 
         TARGET(BUILD_TUPLE) {
-            PyObject *tup = PyTuple_New(oparg);
+            STACK_SHRINK(oparg);
+            PyObject *tup = _PyTuple_FromArraySteal(stack_pointer, oparg);
             if (tup == NULL)
                 goto error;
-            while (--oparg >= 0) {
-                PyObject *item = POP();
-                PyTuple_SET_ITEM(tup, oparg, item);
-            }
             PUSH(tup);
             DISPATCH();
         }
 
         TARGET(BUILD_LIST) {
-            PyObject *list =  PyList_New(oparg);
+            STACK_SHRINK(oparg);
+            PyObject *list = _PyList_FromArraySteal(stack_pointer, oparg);
             if (list == NULL)
                 goto error;
-            while (--oparg >= 0) {
-                PyObject *item = POP();
-                PyList_SET_ITEM(list, oparg, item);
-            }
             PUSH(list);
             DISPATCH();
         }
@@ -3588,6 +3936,122 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             NOTRACE_DISPATCH();
         }
 
+        TARGET(LOAD_ATTR_CLASS) {
+            /* LOAD_ATTR, for attributes of classes whose metaclass is type */
+            assert(cframe.use_tracing == 0);
+            _PyLoadMethodCache *cache = (_PyLoadMethodCache *)next_instr;
+            PyObject *cls = TOP();
+            DEOPT_IF(!PyType_Check(cls), LOAD_ATTR);
+            uint32_t type_version = read_u32(cache->type_version);
+            assert(type_version != 0);
+            DEOPT_IF(((PyTypeObject *)cls)->tp_version_tag != type_version,
+                     LOAD_ATTR);
+            STAT_INC(LOAD_ATTR, hit);
+            PyObject *res = read_obj(cache->descr);
+            assert(res != NULL);
+            Py_INCREF(res);
+            SET_TOP(res);
+            Py_DECREF(cls);
+            JUMPBY(INLINE_CACHE_ENTRIES_LOAD_ATTR);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_ATTR_METACLASS) {
+            /* LOAD_ATTR, for attributes of classes with a custom metaclass */
+            assert(cframe.use_tracing == 0);
+            _PyLoadMethodCache *cache = (_PyLoadMethodCache *)next_instr;
+            PyObject *cls = TOP();
+            DEOPT_IF(!PyType_Check(cls), LOAD_ATTR);
+            uint32_t type_version = read_u32(cache->type_version);
+            assert(type_version != 0);
+            DEOPT_IF(((PyTypeObject *)cls)->tp_version_tag != type_version,
+                     LOAD_ATTR);
+            uint32_t meta_version = read_u32(cache->keys_version);
+            DEOPT_IF(Py_TYPE(cls)->tp_version_tag != meta_version, LOAD_ATTR);
+            STAT_INC(LOAD_ATTR, hit);
+            PyObject *res = read_obj(cache->descr);
+            assert(res != NULL);
+            Py_INCREF(res);
+            SET_TOP(res);
+            Py_DECREF(cls);
+            JUMPBY(INLINE_CACHE_ENTRIES_LOAD_ATTR);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_ATTR_PROPERTY) {
+            /* LOAD_ATTR, calling a Python property getter in a new frame */
+            assert(cframe.use_tracing == 0);
+            DEOPT_IF(tstate->interp->eval_frame, LOAD_ATTR);
+            _PyLoadMethodCache *cache = (_PyLoadMethodCache *)next_instr;
+            PyObject *owner = TOP();
+            uint32_t type_version = read_u32(cache->type_version);
+            assert(type_version != 0);
+            DEOPT_IF(Py_TYPE(owner)->tp_version_tag != type_version, LOAD_ATTR);
+            PyFunctionObject *fget = (PyFunctionObject *)read_obj(cache->descr);
+            assert(Py_IS_TYPE(fget, &PyFunction_Type));
+            DEOPT_IF(fget->func_version != read_u32(cache->keys_version),
+                     LOAD_ATTR);
+            STAT_INC(LOAD_ATTR, hit);
+            Py_INCREF(fget);
+            _PyInterpreterFrame *new_frame = _PyFrame_Push(tstate, fget);
+            if (new_frame == NULL) {
+                goto error;
+            }
+            CALL_STAT_INC(inlined_py_calls);
+            PyCodeObject *code = (PyCodeObject *)fget->func_code;
+            assert(code->co_argcount == 1);
+            STACK_SHRINK(1);
+            new_frame->localsplus[0] = owner;
+            for (int i = 1; i < code->co_nlocalsplus; i++) {
+                new_frame->localsplus[i] = NULL;
+            }
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            JUMPBY(INLINE_CACHE_ENTRIES_LOAD_ATTR);
+            frame->prev_instr = next_instr - 1;
+            new_frame->previous = frame;
+            frame = cframe.current_frame = new_frame;
+            goto start_frame;
+        }
+
+        TARGET(LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN) {
+            /* LOAD_ATTR, calling a Python __getattribute__ in a new frame */
+            assert(cframe.use_tracing == 0);
+            DEOPT_IF(tstate->interp->eval_frame, LOAD_ATTR);
+            _PyLoadMethodCache *cache = (_PyLoadMethodCache *)next_instr;
+            PyObject *owner = TOP();
+            uint32_t type_version = read_u32(cache->type_version);
+            assert(type_version != 0);
+            DEOPT_IF(Py_TYPE(owner)->tp_version_tag != type_version, LOAD_ATTR);
+            PyFunctionObject *getattribute =
+                (PyFunctionObject *)read_obj(cache->descr);
+            assert(Py_IS_TYPE(getattribute, &PyFunction_Type));
+            DEOPT_IF(getattribute->func_version != read_u32(cache->keys_version),
+                     LOAD_ATTR);
+            STAT_INC(LOAD_ATTR, hit);
+            Py_INCREF(getattribute);
+            _PyInterpreterFrame *new_frame = _PyFrame_Push(tstate, getattribute);
+            if (new_frame == NULL) {
+                goto error;
+            }
+            CALL_STAT_INC(inlined_py_calls);
+            PyCodeObject *code = (PyCodeObject *)getattribute->func_code;
+            assert(code->co_argcount == 2);
+            PyObject *name = GETITEM(names, oparg);
+            Py_INCREF(name);
+            STACK_SHRINK(1);
+            new_frame->localsplus[0] = owner;
+            new_frame->localsplus[1] = name;
+            for (int i = 2; i < code->co_nlocalsplus; i++) {
+                new_frame->localsplus[i] = NULL;
+            }
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            JUMPBY(INLINE_CACHE_ENTRIES_LOAD_ATTR);
+            frame->prev_instr = next_instr - 1;
+            new_frame->previous = frame;
+            frame = cframe.current_frame = new_frame;
+            goto start_frame;
+        }
+
         TARGET(STORE_ATTR_ADAPTIVE) {
             assert(cframe.use_tracing == 0);
             _PyAttrCache *cache = (_PyAttrCache *)next_instr;
@@ -3877,6 +4341,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
         }
 
         TARGET(CONTAINS_OP) {
+            PREDICTED(CONTAINS_OP);
             PyObject *right = POP();
             PyObject *left = POP();
             int res = PySequence_Contains(right, left);
@@ -3888,9 +4353,121 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             PyObject *b = (res^oparg) ? Py_True : Py_False;
             Py_INCREF(b);
             PUSH(b);
+            JUMPBY(INLINE_CACHE_ENTRIES_CONTAINS_OP);
             DISPATCH();
         }
 
+        TARGET(CONTAINS_OP_ADAPTIVE) {
+            assert(cframe.use_tracing == 0);
+            _PyContainsOpCache *cache = (_PyContainsOpCache *)next_instr;
+            if (ADAPTIVE_COUNTER_IS_ZERO(cache)) {
+                next_instr--;
+                _Py_Specialize_ContainsOp(SECOND(), TOP(), next_instr);
+                NOTRACE_DISPATCH_SAME_OPARG();
+            }
+            else {
+                STAT_INC(CONTAINS_OP, deferred);
+                DECREMENT_ADAPTIVE_COUNTER(cache);
+                JUMP_TO_INSTRUCTION(CONTAINS_OP);
+            }
+        }
+
+        TARGET(CONTAINS_OP_DICT) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            DEOPT_IF(!PyDict_CheckExact(right), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            PyObject *left = SECOND();
+            /* Reuses the cached hash of str keys */
+            int res = PyDict_Contains(right, left);
+            if (res < 0) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            PyObject *b = (res^oparg) ? Py_True : Py_False;
+            Py_INCREF(b);
+            SET_TOP(b);
+            JUMPBY(INLINE_CACHE_ENTRIES_CONTAINS_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(CONTAINS_OP_SET) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            DEOPT_IF(!PySet_CheckExact(right) && !PyFrozenSet_CheckExact(right),
+                     CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            PyObject *left = SECOND();
+            int res = _PySet_Contains((PySetObject *)right, left);
+            if (res < 0) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            PyObject *b = (res^oparg) ? Py_True : Py_False;
+            Py_INCREF(b);
+            SET_TOP(b);
+            JUMPBY(INLINE_CACHE_ENTRIES_CONTAINS_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(CONTAINS_OP_STR) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            PyObject *left = SECOND();
+            DEOPT_IF(!PyUnicode_CheckExact(right), CONTAINS_OP);
+            DEOPT_IF(!PyUnicode_CheckExact(left), CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            int res = PyUnicode_Contains(right, left);
+            if (res < 0) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            _Py_DECREF_SPECIALIZED(left, _PyUnicode_ExactDealloc);
+            _Py_DECREF_SPECIALIZED(right, _PyUnicode_ExactDealloc);
+            PyObject *b = (res^oparg) ? Py_True : Py_False;
+            Py_INCREF(b);
+            SET_TOP(b);
+            JUMPBY(INLINE_CACHE_ENTRIES_CONTAINS_OP);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(CONTAINS_OP_TUPLE) {
+            assert(cframe.use_tracing == 0);
+            PyObject *right = TOP();
+            DEOPT_IF(!PyTuple_CheckExact(right), CONTAINS_OP);
+            Py_ssize_t len = PyTuple_GET_SIZE(right);
+            DEOPT_IF(len > CONTAINS_OP_TUPLE_MAX_SIZE, CONTAINS_OP);
+            STAT_INC(CONTAINS_OP, hit);
+            PyObject *left = SECOND();
+            int res = 0;
+            for (Py_ssize_t i = 0; i < len; i++) {
+                PyObject *item = PyTuple_GET_ITEM(right, i);
+                if (item == left) {
+                    res = 1;
+                    break;
+                }
+                res = PyObject_RichCompareBool(item, left, Py_EQ);
+                if (res != 0) {
+                    break;
+                }
+            }
+            if (res < 0) {
+                goto error;
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(left);
+            Py_DECREF(right);
+            PyObject *b = (res^oparg) ? Py_True : Py_False;
+            Py_INCREF(b);
+            SET_TOP(b);
+            JUMPBY(INLINE_CACHE_ENTRIES_CONTAINS_OP);
+            NOTRACE_DISPATCH();
+        }
+
         TARGET(CHECK_EG_MATCH) {
             PyObject *match_type = POP();
             if (check_except_star_type_valid(tstate, match_type) < 0) {
@@ -4213,6 +4790,25 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             assert(oparg < INSTR_OFFSET());
             JUMPBY(-oparg);
             CHECK_EVAL_BREAKER();
+            if (--frame->f_code->co_optimizer_warmup <= 0) {
+                _PyOptimizer_BackEdge(frame, frame->prev_instr, oparg,
+                                      stack_pointer);
+            }
+            DISPATCH();
+        }
+
+        TARGET(JUMP_BACKWARD_EXECUTOR) {
+            assert(cframe.use_tracing == 0);
+            _PyExecutor *executor = _PyCode_GetExecutor(frame->f_code,
+                                                        INSTR_OFFSET() - 1);
+            JUMPBY(-oparg);
+            CHECK_EVAL_BREAKER();
+            int err = _PyExecutor_Execute(executor, frame, stack_pointer);
+            next_instr = frame->prev_instr + 1;
+            stack_pointer = _PyFrame_GetStackPointer(frame);
+            if (err < 0) {
+                goto error;
+            }
             DISPATCH();
         }
 
@@ -4337,14 +4933,10 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             PREDICTED(FOR_ITER);
             /* before: [iter]; after: [iter, iter()] *or* [] */
             PyObject *iter = TOP();
-#ifdef Py_STATS
-            extern int _PySpecialization_ClassifyIterator(PyObject *);
-            _py_stats.opcode_stats[FOR_ITER].specialization.failure++;
-            _py_stats.opcode_stats[FOR_ITER].specialization.failure_kinds[_PySpecialization_ClassifyIterator(iter)]++;
-#endif
             PyObject *next = (*Py_TYPE(iter)->tp_iternext)(iter);
             if (next != NULL) {
                 PUSH(next);
+                JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER);
                 PREDICT(STORE_FAST);
                 PREDICT(UNPACK_SEQUENCE);
                 DISPATCH();
@@ -4361,10 +4953,118 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             /* iterator ended normally */
             STACK_SHRINK(1);
             Py_DECREF(iter);
-            JUMPBY(oparg);
+            JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER + oparg);
             DISPATCH();
         }
 
+        TARGET(FOR_ITER_ADAPTIVE) {
+            assert(cframe.use_tracing == 0);
+            _PyForIterCache *cache = (_PyForIterCache *)next_instr;
+            if (ADAPTIVE_COUNTER_IS_ZERO(cache)) {
+                next_instr--;
+                _Py_Specialize_ForIter(TOP(), next_instr, oparg);
+                NOTRACE_DISPATCH_SAME_OPARG();
+            }
+            else {
+                STAT_INC(FOR_ITER, deferred);
+                DECREMENT_ADAPTIVE_COUNTER(cache);
+                JUMP_TO_INSTRUCTION(FOR_ITER);
+            }
+        }
+
+        TARGET(FOR_ITER_LIST) {
+            assert(cframe.use_tracing == 0);
+            _PyListIterObject *it = (_PyListIterObject *)TOP();
+            DEOPT_IF(Py_TYPE(it) != &PyListIter_Type, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            PyListObject *seq = it->it_seq;
+            if (seq != NULL) {
+                if (it->it_index < PyList_GET_SIZE(seq)) {
+                    PyObject *next = PyList_GET_ITEM(seq, it->it_index++);
+                    Py_INCREF(next);
+                    PUSH(next);
+                    JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER);
+                    NOTRACE_DISPATCH();
+                }
+                it->it_seq = NULL;
+                Py_DECREF(seq);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(it);
+            JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER + oparg);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(FOR_ITER_TUPLE) {
+            assert(cframe.use_tracing == 0);
+            _PyTupleIterObject *it = (_PyTupleIterObject *)TOP();
+            DEOPT_IF(Py_TYPE(it) != &PyTupleIter_Type, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            PyTupleObject *seq = it->it_seq;
+            if (seq != NULL) {
+                if (it->it_index < PyTuple_GET_SIZE(seq)) {
+                    PyObject *next = PyTuple_GET_ITEM(seq, it->it_index++);
+                    Py_INCREF(next);
+                    PUSH(next);
+                    JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER);
+                    NOTRACE_DISPATCH();
+                }
+                it->it_seq = NULL;
+                Py_DECREF(seq);
+            }
+            STACK_SHRINK(1);
+            Py_DECREF(it);
+            JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER + oparg);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(FOR_ITER_RANGE) {
+            assert(cframe.use_tracing == 0);
+            _PyRangeIterObject *r = (_PyRangeIterObject *)TOP();
+            DEOPT_IF(Py_TYPE(r) != &PyRangeIter_Type, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            _Py_CODEUNIT next = next_instr[INLINE_CACHE_ENTRIES_FOR_ITER];
+            assert(_PyOpcode_Deopt[_Py_OPCODE(next)] == STORE_FAST);
+            if (r->index >= r->len) {
+                STACK_SHRINK(1);
+                Py_DECREF(r);
+                JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER + oparg);
+                NOTRACE_DISPATCH();
+            }
+            long value = (long)(r->start +
+                                (unsigned long)(r->index++) * r->step);
+            /* Store the value directly into the loop variable, skipping
+               the boxing round trip through the stack. */
+            if (_PyLong_AssignValue(&GETLOCAL(_Py_OPARG(next)), value) < 0) {
+                goto error;
+            }
+            // The STORE_FAST is already done.
+            JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER + 1);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(FOR_ITER_GEN) {
+            assert(cframe.use_tracing == 0);
+            DEOPT_IF(tstate->interp->eval_frame, FOR_ITER);
+            PyGenObject *gen = (PyGenObject *)TOP();
+            DEOPT_IF(Py_TYPE(gen) != &PyGen_Type, FOR_ITER);
+            DEOPT_IF(gen->gi_frame_state >= FRAME_EXECUTING, FOR_ITER);
+            STAT_INC(FOR_ITER, hit);
+            _PyInterpreterFrame *gen_frame = (_PyInterpreterFrame *)gen->gi_iframe;
+            Py_INCREF(Py_None);
+            _PyFrame_StackPush(gen_frame, Py_None);
+            gen->gi_frame_state = FRAME_EXECUTING;
+            gen->gi_exc_state.previous_item = tstate->exc_info;
+            tstate->exc_info = &gen->gi_exc_state;
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            JUMPBY(INLINE_CACHE_ENTRIES_FOR_ITER);
+            frame->prev_instr = next_instr - 1;
+            gen_frame->previous = frame;
+            gen_frame->is_entry = false;
+            frame = cframe.current_frame = gen_frame;
+            goto start_frame;
+        }
+
         TARGET(BEFORE_ASYNC_WITH) {
             PyObject *mgr = TOP();
             PyObject *res;
@@ -4828,6 +5528,62 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
             goto start_frame;
         }
 
+        TARGET(CALL_ALLOC_AND_ENTER_INIT) {
+            assert(call_shape.kwnames == NULL);
+            assert(cframe.use_tracing == 0);
+            DEOPT_IF(tstate->interp->eval_frame, CALL);
+            DEOPT_IF(is_method(stack_pointer, oparg), CALL);
+            _PyCallCache *cache = (_PyCallCache *)next_instr;
+            PyObject *callable = PEEK(oparg + 1);
+            DEOPT_IF(!PyType_Check(callable), CALL);
+            PyTypeObject *tp = (PyTypeObject *)callable;
+            DEOPT_IF(tp->tp_version_tag != read_u32(cache->func_version), CALL);
+            assert(tp->tp_flags & Py_TPFLAGS_HEAPTYPE);
+            PyObject *cached = ((PyHeapTypeObject *)tp)->_spec_cache.init;
+            assert(PyFunction_Check(cached));
+            PyFunctionObject *init = (PyFunctionObject *)cached;
+            DEOPT_IF(init->func_version != cache->min_args, CALL);
+            PyCodeObject *code = (PyCodeObject *)init->func_code;
+            assert(code->co_argcount == oparg + 1);
+            STAT_INC(CALL, hit);
+            PyObject *self = PyType_GenericAlloc(tp, 0);
+            if (self == NULL) {
+                goto error;
+            }
+            if (_PyObject_InitializeDict(self)) {
+                Py_DECREF(self);
+                goto error;
+            }
+            Py_INCREF(init);
+            _PyInterpreterFrame *new_frame = _PyFrame_Push(tstate, init);
+            if (new_frame == NULL) {
+                Py_DECREF(self);
+                goto error;
+            }
+            CALL_STAT_INC(inlined_py_calls);
+            STACK_SHRINK(oparg);
+            Py_INCREF(self);
+            new_frame->localsplus[0] = self;
+            for (int i = 0; i < oparg; i++) {
+                new_frame->localsplus[i+1] = stack_pointer[i];
+            }
+            for (int i = oparg + 1; i < code->co_nlocalsplus; i++) {
+                new_frame->localsplus[i] = NULL;
+            }
+            new_frame->is_init = true;
+            /* Replace the NULL and the class with the new instance, which
+             * is left there when __init__ returns. */
+            STACK_SHRINK(1);
+            SET_TOP(self);
+            Py_DECREF(tp);
+            _PyFrame_SetStackPointer(frame, stack_pointer);
+            JUMPBY(INLINE_CACHE_ENTRIES_CALL);
+            frame->prev_instr = next_instr - 1;
+            new_frame->previous = frame;
+            frame = cframe.current_frame = new_frame;
+            goto start_frame;
+        }
+
         TARGET(CALL_PY_WITH_DEFAULTS) {
             assert(call_shape.kwnames == NULL);
             DEOPT_IF(tstate->interp->eval_frame, CALL);
@@ -5772,7 +6528,13 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, _PyInterpreterFrame *frame, int
         assert(tstate->cframe->current_frame == frame->previous);
         return NULL;
     }
-    frame = cframe.current_frame = pop_frame(tstate, frame);
+    if (frame->owner == FRAME_OWNED_BY_GENERATOR) {
+        _PyGen_ConvertStopIteration(_PyFrame_GetGenerator(frame));
+        frame = cframe.current_frame = pop_gen_frame(tstate, frame);
+    }
+    else {
+        frame = cframe.current_frame = pop_frame(tstate, frame);
+    }
 
 resume_with_error:
     SET_LOCALS_FROM_FRAME();
@@ -6877,9 +7639,7 @@ maybe_call_line_trace(Py_tracefunc func, PyObject *obj,
         /* Trace backward edges (except in 'yield from') or if line number has changed */
         int trace = line != lastline ||
             (_PyInterpreterFrame_LASTI(frame) < instr_prev &&
-             // SEND has no quickened forms, so no need to use _PyOpcode_Deopt
-             // here:
-             _Py_OPCODE(*frame->prev_instr) != SEND);
+             _PyOpcode_Deopt[_Py_OPCODE(*frame->prev_instr)] != SEND);
         if (trace) {
             result = call_trace(func, obj, tstate, frame, PyTrace_LINE, Py_None);
         }
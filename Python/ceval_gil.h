@@ -47,6 +47,13 @@
      run and end up being the first to re-acquire it, making the "timeslices"
      much longer than expected.
      (Note: this mechanism is enabled with FORCE_SWITCHING above)
+
+   - Each interpreter points to the GIL it uses (ceval.gil).  Isolated
+     subinterpreters have a GIL of their own, so that they can run Python
+     code in parallel with the other interpreters.  The others share the
+     GIL of the main interpreter.  A thread state swapped in from another
+     interpreter can therefore need another GIL: the GIL held by each thread
+     is tracked so that _PyThreadState_Swap() can switch to it.
 */
 
 #include "condvar.h"
@@ -90,6 +97,15 @@
 
 #define DEFAULT_INTERVAL 5000
 
+#ifdef HAVE_THREAD_LOCAL
+/* The GIL held by the current thread, or NULL */
+static _Py_thread_local struct _gil_runtime_state *held_gil = NULL;
+#  define SET_HELD_GIL(gil) held_gil = (gil)
+#else
+/* Without thread-local storage, all the interpreters share a GIL */
+#  define SET_HELD_GIL(gil)
+#endif
+
 static void _gil_initialize(struct _gil_runtime_state *gil)
 {
     _Py_atomic_int uninitialized = {-1};
@@ -140,11 +156,12 @@ static void recreate_gil(struct _gil_runtime_state *gil)
     create_gil(gil);
 }
 
+/* Release the GIL.  ceval is the state of the interpreter of tstate, it is
+   only used if tstate is not NULL. */
 static void
-drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
+drop_gil(struct _gil_runtime_state *gil, struct _ceval_state *ceval,
          PyThreadState *tstate)
 {
-    struct _gil_runtime_state *gil = &ceval->gil;
     if (!_Py_atomic_load_relaxed(&gil->locked)) {
         Py_FatalError("drop_gil: GIL is not locked");
     }
@@ -160,11 +177,12 @@ drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
     MUTEX_LOCK(gil->mutex);
     _Py_ANNOTATE_RWLOCK_RELEASED(&gil->locked, /*is_write=*/1);
     _Py_atomic_store_relaxed(&gil->locked, 0);
+    SET_HELD_GIL(NULL);
     COND_SIGNAL(gil->cond);
     MUTEX_UNLOCK(gil->mutex);
 
 #ifdef FORCE_SWITCHING
-    if (_Py_atomic_load_relaxed(&ceval2->gil_drop_request) && tstate != NULL) {
+    if (tstate != NULL && _Py_atomic_load_relaxed(&ceval->gil_drop_request)) {
         MUTEX_LOCK(gil->switch_mutex);
         /* Not switched yet => wait */
         if (((PyThreadState*)_Py_atomic_load_relaxed(&gil->last_holder)) == tstate)
@@ -228,7 +246,7 @@ take_gil(PyThreadState *tstate)
     PyInterpreterState *interp = tstate->interp;
     struct _ceval_runtime_state *ceval = &interp->runtime->ceval;
     struct _ceval_state *ceval2 = &interp->ceval;
-    struct _gil_runtime_state *gil = &ceval->gil;
+    struct _gil_runtime_state *gil = ceval2->gil;
 
     /* Check that _PyEval_InitThreads() was called to create the lock */
     assert(gil_created(gil));
@@ -271,6 +289,7 @@ take_gil(PyThreadState *tstate)
     /* We now hold the GIL */
     _Py_atomic_store_relaxed(&gil->locked, 1);
     _Py_ANNOTATE_RWLOCK_ACQUIRED(&gil->locked, /*is_write=*/1);
+    SET_HELD_GIL(gil);
 
     if (tstate != (PyThreadState*)_Py_atomic_load_relaxed(&gil->last_holder)) {
         _Py_atomic_store_relaxed(&gil->last_holder, (uintptr_t)tstate);
@@ -291,7 +310,7 @@ take_gil(PyThreadState *tstate)
            in take_gil() while the main thread called
            wait_for_thread_shutdown() from Py_Finalize(). */
         MUTEX_UNLOCK(gil->mutex);
-        drop_gil(ceval, ceval2, tstate);
+        drop_gil(gil, ceval2, tstate);
         PyThread_exit_thread();
     }
     assert(is_tstate_valid(tstate));
@@ -318,14 +337,20 @@ take_gil(PyThreadState *tstate)
     errno = err;
 }
 
+/* The switch interval is a property of the GIL of the current interpreter */
+
 void _PyEval_SetSwitchInterval(unsigned long microseconds)
 {
-    struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    struct _gil_runtime_state *gil = interp->ceval.gil;
+    assert(gil != NULL);
     gil->interval = microseconds;
 }
 
 unsigned long _PyEval_GetSwitchInterval()
 {
-    struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    struct _gil_runtime_state *gil = interp->ceval.gil;
+    assert(gil != NULL);
     return gil->interval;
 }
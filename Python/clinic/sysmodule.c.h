@@ -929,6 +929,75 @@ sys__debugmallocstats(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__debugmallocstats_impl(module);
 }
 
+PyDoc_STRVAR(sys__set_freelist_limit__doc__,
+"_set_freelist_limit($module, name, limit, /)\n"
+"--\n"
+"\n"
+"Set the maximum number of objects kept for reuse by a free list.\n"
+"\n"
+"The objects above the new limit are freed.  See _get_malloc_stats()\n"
+"for the names of the free lists.");
+
+#define SYS__SET_FREELIST_LIMIT_METHODDEF    \
+    {"_set_freelist_limit", _PyCFunction_CAST(sys__set_freelist_limit), METH_FASTCALL, sys__set_freelist_limit__doc__},
+
+static PyObject *
+sys__set_freelist_limit_impl(PyObject *module, const char *name, int limit);
+
+static PyObject *
+sys__set_freelist_limit(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    const char *name;
+    int limit;
+
+    if (!_PyArg_CheckPositional("_set_freelist_limit", nargs, 2, 2)) {
+        goto exit;
+    }
+    if (!PyUnicode_Check(args[0])) {
+        _PyArg_BadArgument("_set_freelist_limit", "argument 1", "str", args[0]);
+        goto exit;
+    }
+    Py_ssize_t name_length;
+    name = PyUnicode_AsUTF8AndSize(args[0], &name_length);
+    if (name == NULL) {
+        goto exit;
+    }
+    if (strlen(name) != (size_t)name_length) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        goto exit;
+    }
+    limit = _PyLong_AsInt(args[1]);
+    if (limit == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = sys__set_freelist_limit_impl(module, name, limit);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys__get_malloc_stats__doc__,
+"_get_malloc_stats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict of statistics of pymalloc and of the free lists.\n"
+"\n"
+"The pymalloc keys are missing if pymalloc is not used.  Unlike\n"
+"_debugmallocstats(), this only visits the pool headers.");
+
+#define SYS__GET_MALLOC_STATS_METHODDEF    \
+    {"_get_malloc_stats", (PyCFunction)sys__get_malloc_stats, METH_NOARGS, sys__get_malloc_stats__doc__},
+
+static PyObject *
+sys__get_malloc_stats_impl(PyObject *module);
+
+static PyObject *
+sys__get_malloc_stats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__get_malloc_stats_impl(module);
+}
+
 PyDoc_STRVAR(sys__clear_type_cache__doc__,
 "_clear_type_cache($module, /)\n"
 "--\n"
@@ -1014,4 +1083,4 @@ sys_getandroidapilevel(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=98efd34fd9b9b6ab input=a9049054013a1b77]*/
+/*[clinic end generated code: output=d5f3e4525cf0ce37 input=a9049054013a1b77]*/
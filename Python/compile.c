@@ -7939,11 +7939,7 @@ scan_block_for_local(int target, basicblock *b, bool unsafe_to_start,
         struct instr *instr = &b->b_instr[i];
         assert(instr->i_opcode != EXTENDED_ARG);
         assert(instr->i_opcode != EXTENDED_ARG_QUICK);
-        assert(instr->i_opcode != LOAD_FAST__LOAD_FAST);
-        assert(instr->i_opcode != STORE_FAST__LOAD_FAST);
-        assert(instr->i_opcode != LOAD_CONST__LOAD_FAST);
-        assert(instr->i_opcode != STORE_FAST__STORE_FAST);
-        assert(instr->i_opcode != LOAD_FAST__LOAD_CONST);
+        assert(!_PyOpcode_SuperinstructionSecond[instr->i_opcode]);
         if (unsafe && instr->i_except != NULL) {
             MAYBE_PUSH(instr->i_except);
         }
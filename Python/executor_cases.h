@@ -0,0 +1,252 @@
+// Micro-op implementations, included by Python/optimizer.c both into the
+// executor's dispatch loop and into one function per uop for compiled
+// traces.  The includer defines:
+//
+//   TARGET(op)         start of the implementation of op
+//   TARGET_ALIAS(op)   op shares the implementation that follows
+//   NEXT_UOP()         continue with the next uop
+//   JUMP_TO_UOP(i)     continue with the uop at index i in the trace
+//   EXIT_TRACE(offset) leave the trace, resuming at the instruction at offset
+//   DEOPT()            leave the trace at the start of the current instruction
+//   DEOPT_OPERANDS()   same, pushing the folded operands first
+//   ERROR()            leave the trace with an exception set
+//
+// and frame, stack_pointer, consts, tstate and eval_breaker.
+
+        TARGET(UOP_LOAD_FAST) {
+            PyObject *value = GETLOCAL(uop->oparg);
+            assert(value != NULL);
+            Py_INCREF(value);
+            PUSH(value);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_LOAD_CONST) {
+            PyObject *value = consts[uop->oparg];
+            Py_INCREF(value);
+            PUSH(value);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_STORE_FAST) {
+            PyObject *value;
+            if (RIGHT_OPERAND(uop) == OPERAND_STACK) {
+                value = POP();
+            }
+            else {
+                value = FOLDED(RIGHT_OPERAND(uop), uop->right);
+                Py_INCREF(value);
+            }
+            SETLOCAL(uop->oparg, value);
+            CHECK_TRACING();
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_POP_TOP) {
+            PyObject *value = POP();
+            Py_DECREF(value);
+            CHECK_TRACING();
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_GUARD_STACK) {
+            if (!type_check(PEEK(uop->oparg), UOP_TYPE(uop))) {
+                DEOPT();
+            }
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_GUARD_LOCAL) {
+            PyObject *value = GETLOCAL(uop->oparg);
+            if (value == NULL || !type_check(value, UOP_TYPE(uop))) {
+                DEOPT();
+            }
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_ADD_INT) {
+            BINARY_OPERANDS();
+            PyObject *sum = _PyLong_Add((PyLongObject *)left,
+                                        (PyLongObject *)right);
+            DECREF_OPERANDS((destructor)PyObject_Free);
+            if (sum == NULL) {
+                ERROR();
+            }
+            PUSH(sum);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_SUBTRACT_INT) {
+            BINARY_OPERANDS();
+            PyObject *sub = _PyLong_Subtract((PyLongObject *)left,
+                                             (PyLongObject *)right);
+            DECREF_OPERANDS((destructor)PyObject_Free);
+            if (sub == NULL) {
+                ERROR();
+            }
+            PUSH(sub);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_MULTIPLY_INT) {
+            BINARY_OPERANDS();
+            PyObject *prod = _PyLong_Multiply((PyLongObject *)left,
+                                              (PyLongObject *)right);
+            DECREF_OPERANDS((destructor)PyObject_Free);
+            if (prod == NULL) {
+                ERROR();
+            }
+            PUSH(prod);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_ADD_FLOAT) {
+            BINARY_OPERANDS();
+            double dsum = PyFloat_AS_DOUBLE(left) + PyFloat_AS_DOUBLE(right);
+            DECREF_OPERANDS(_PyFloat_ExactDealloc);
+            PyObject *sum = PyFloat_FromDouble(dsum);
+            if (sum == NULL) {
+                ERROR();
+            }
+            PUSH(sum);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_SUBTRACT_FLOAT) {
+            BINARY_OPERANDS();
+            double dsub = PyFloat_AS_DOUBLE(left) - PyFloat_AS_DOUBLE(right);
+            DECREF_OPERANDS(_PyFloat_ExactDealloc);
+            PyObject *sub = PyFloat_FromDouble(dsub);
+            if (sub == NULL) {
+                ERROR();
+            }
+            PUSH(sub);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_MULTIPLY_FLOAT) {
+            BINARY_OPERANDS();
+            double dprod = PyFloat_AS_DOUBLE(left) * PyFloat_AS_DOUBLE(right);
+            DECREF_OPERANDS(_PyFloat_ExactDealloc);
+            PyObject *prod = PyFloat_FromDouble(dprod);
+            if (prod == NULL) {
+                ERROR();
+            }
+            PUSH(prod);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_SUBSCR_LIST_INT) {
+            BINARY_OPERANDS();
+            // Leave unless 0 <= sub < PyList_Size(list)
+            Py_ssize_t signed_magnitude = Py_SIZE(right);
+            if (((size_t)signed_magnitude) > 1) {
+                DEOPT_OPERANDS();
+            }
+            Py_ssize_t index = ((PyLongObject*)right)->ob_digit[0];
+            if (index >= PyList_GET_SIZE(left)) {
+                DEOPT_OPERANDS();
+            }
+            PyObject *res = PyList_GET_ITEM(left, index);
+            assert(res != NULL);
+            Py_INCREF(res);
+            if (RIGHT_OPERAND(uop) == OPERAND_STACK) {
+                _Py_DECREF_SPECIALIZED(right, (destructor)PyObject_Free);
+            }
+            if (LEFT_OPERAND(uop) == OPERAND_STACK) {
+                Py_DECREF(left);
+            }
+            STACK_SHRINK(nstack);
+            PUSH(res);
+            CHECK_TRACING();
+            NEXT_UOP();
+        }
+
+        TARGET_ALIAS(UOP_COMPARE_INT_JUMP)
+        TARGET(UOP_COMPARE_INT_BRANCH) {
+            BINARY_OPERANDS();
+            assert(Py_ABS(Py_SIZE(left)) <= 1 && Py_ABS(Py_SIZE(right)) <= 1);
+            Py_ssize_t ileft = Py_SIZE(left) * ((PyLongObject *)left)->ob_digit[0];
+            Py_ssize_t iright = Py_SIZE(right) * ((PyLongObject *)right)->ob_digit[0];
+            int sign = (ileft > iright) - (ileft < iright);
+            DECREF_OPERANDS((destructor)PyObject_Free);
+            if ((9 << (sign + 1)) & uop->oparg) {
+                if (uop->opcode == UOP_COMPARE_INT_BRANCH) {
+                    JUMP_TO_UOP(uop->exit);
+                }
+                EXIT_TRACE(uop->exit);
+            }
+            NEXT_UOP();
+        }
+
+        TARGET_ALIAS(UOP_COMPARE_FLOAT_JUMP)
+        TARGET(UOP_COMPARE_FLOAT_BRANCH) {
+            BINARY_OPERANDS();
+            double dleft = PyFloat_AS_DOUBLE(left);
+            double dright = PyFloat_AS_DOUBLE(right);
+            if (isnan(dleft) || isnan(dright)) {
+                DEOPT_OPERANDS();
+            }
+            int sign = (dleft > dright) - (dleft < dright);
+            DECREF_OPERANDS(_PyFloat_ExactDealloc);
+            if ((9 << (sign + 1)) & uop->oparg) {
+                if (uop->opcode == UOP_COMPARE_FLOAT_BRANCH) {
+                    JUMP_TO_UOP(uop->exit);
+                }
+                EXIT_TRACE(uop->exit);
+            }
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_FOR_ITER_RANGE) {
+            _PyRangeIterObject *r = (_PyRangeIterObject *)TOP();
+            if (r->index >= r->len) {
+                /* The interpreter finishes the loop */
+                EXIT_TRACE(uop->target);
+            }
+            long value = (long)(r->start +
+                                (unsigned long)(r->index++) * r->step);
+            if (_PyLong_AssignValue(&GETLOCAL(uop->oparg), value) < 0) {
+                ERROR();
+            }
+            CHECK_TRACING();
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_FOR_ITER_LIST) {
+            _PyListIterObject *it = (_PyListIterObject *)TOP();
+            PyListObject *seq = it->it_seq;
+            if (seq == NULL || it->it_index >= PyList_GET_SIZE(seq)) {
+                /* The interpreter finishes the loop */
+                EXIT_TRACE(uop->target);
+            }
+            PyObject *next = PyList_GET_ITEM(seq, it->it_index++);
+            Py_INCREF(next);
+            PUSH(next);
+            NEXT_UOP();
+        }
+
+        TARGET(UOP_JUMP_FORWARD) {
+            JUMP_TO_UOP(uop->exit);
+        }
+
+        TARGET(UOP_JUMP_TO_BODY) {
+            if (_Py_atomic_load_relaxed(eval_breaker) ||
+                tstate->cframe->use_tracing)
+            {
+                /* Let the JUMP_BACKWARD handle it */
+                EXIT_TRACE(uop->target);
+            }
+            JUMP_TO_UOP(executor->body);
+        }
+
+        TARGET(UOP_POP_JUMP_TO_BODY) {
+            if (_Py_atomic_load_relaxed(eval_breaker) ||
+                tstate->cframe->use_tracing)
+            {
+                /* Let the POP_JUMP_BACKWARD handle it */
+                PUSH(Py_NewRef(uop->oparg ? Py_True : Py_False));
+                EXIT_TRACE(uop->target);
+            }
+            JUMP_TO_UOP(executor->body);
+        }
@@ -1,5 +1,6 @@
 #include "Python.h"
 #include "pycore_fileutils.h"     // _Py_HasFileSystemDefaultEncodeErrors
+#include "pycore_freelist.h"      // _PyObject_ParseFreeListLimits()
 #include "pycore_getopt.h"        // _PyOS_GetOpt()
 #include "pycore_initconfig.h"    // _PyStatus_OK()
 #include "pycore_interp.h"        // _PyInterpreterState.runtime
@@ -118,6 +119,14 @@ The following implementation-specific options are available:\n\
    files are desired as well as suppressing the extra visual location indicators \n\
    when the interpreter displays tracebacks.\n\
 \n\
+-X jit: compile hot loops to machine code (x86-64 only)\n\
+\n\
+-X malloc_hugepages: back the arenas of pymalloc with transparent huge pages\n\
+   (Linux only)\n\
+\n\
+-X freelist_limits=NAME=LIMIT,...: set the maximum number of objects kept for\n\
+   reuse by free lists, e.g. \"dict=1000,tuple=4000\"\n\
+\n\
 -X frozen_modules=[on|off]: whether or not frozen modules should be used.\n\
    The default is \"on\" (or \"off\" if you are running a local build).";
 
@@ -155,6 +164,11 @@ static const char usage_envvars[] =
 "   and end column offset) to every instruction in code objects. This is useful \n"
 "   when smaller code objects and pyc files are desired as well as suppressing the \n"
 "   extra visual location indicators when the interpreter displays tracebacks.\n"
+"PYTHONJIT: compile hot loops to machine code (x86-64 only).\n"
+"PYTHONMALLOCHUGEPAGES: back the arenas of pymalloc with transparent huge pages\n"
+"   (Linux only).\n"
+"PYTHONFREELISTLIMITS: limits of the free lists of objects, as NAME=LIMIT pairs\n"
+"   separated by commas.\n"
 "These variables have equivalent command-line parameters (see --help for details):\n"
 "PYTHONDEBUG             : enable parser debug mode (-d)\n"
 "PYTHONDONTWRITEBYTECODE : don't write .pyc files (-B)\n"
@@ -633,9 +647,11 @@ config_check_consistency(const PyConfig *config)
     assert(config->tracemalloc >= 0);
     assert(config->import_time >= 0);
     assert(config->code_debug_ranges >= 0);
+    assert(config->jit >= 0);
     assert(config->show_ref_count >= 0);
     assert(config->dump_refs >= 0);
     assert(config->malloc_stats >= 0);
+    assert(config->malloc_hugepages >= 0);
     assert(config->site_import >= 0);
     assert(config->bytes_warning >= 0);
     assert(config->warn_default_encoding >= 0);
@@ -690,6 +706,7 @@ PyConfig_Clear(PyConfig *config)
     } while (0)
 
     CLEAR(config->pycache_prefix);
+    CLEAR(config->freelist_limits);
     CLEAR(config->pythonpath_env);
     CLEAR(config->home);
     CLEAR(config->program_name);
@@ -933,10 +950,13 @@ _PyConfig_Copy(PyConfig *config, const PyConfig *config2)
     COPY_ATTR(tracemalloc);
     COPY_ATTR(import_time);
     COPY_ATTR(code_debug_ranges);
+    COPY_ATTR(jit);
     COPY_ATTR(show_ref_count);
     COPY_ATTR(dump_refs);
     COPY_ATTR(dump_refs_file);
     COPY_ATTR(malloc_stats);
+    COPY_ATTR(malloc_hugepages);
+    COPY_WSTR_ATTR(freelist_limits);
 
     COPY_WSTR_ATTR(pycache_prefix);
     COPY_WSTR_ATTR(pythonpath_env);
@@ -1043,9 +1063,12 @@ _PyConfig_AsDict(const PyConfig *config)
     SET_ITEM_INT(tracemalloc);
     SET_ITEM_INT(import_time);
     SET_ITEM_INT(code_debug_ranges);
+    SET_ITEM_INT(jit);
     SET_ITEM_INT(show_ref_count);
     SET_ITEM_INT(dump_refs);
     SET_ITEM_INT(malloc_stats);
+    SET_ITEM_INT(malloc_hugepages);
+    SET_ITEM_WSTR(freelist_limits);
     SET_ITEM_WSTR(filesystem_encoding);
     SET_ITEM_WSTR(filesystem_errors);
     SET_ITEM_WSTR(pycache_prefix);
@@ -1324,9 +1347,12 @@ _PyConfig_FromDict(PyConfig *config, PyObject *dict)
     GET_UINT(tracemalloc);
     GET_UINT(import_time);
     GET_UINT(code_debug_ranges);
+    GET_UINT(jit);
     GET_UINT(show_ref_count);
     GET_UINT(dump_refs);
     GET_UINT(malloc_stats);
+    GET_UINT(malloc_hugepages);
+    GET_WSTR_OPT(freelist_limits);
     GET_WSTR(filesystem_encoding);
     GET_WSTR(filesystem_errors);
     GET_WSTR_OPT(pycache_prefix);
@@ -1746,6 +1772,42 @@ config_init_pycache_prefix(PyConfig *config)
 }
 
 
+static PyStatus
+config_init_freelist_limits(PyConfig *config)
+{
+    assert(config->freelist_limits == NULL);
+
+    const wchar_t *xoption = config_get_xoption(config, L"freelist_limits");
+    if (xoption) {
+        const wchar_t *sep = wcschr(xoption, L'=');
+        if (sep == NULL) {
+            return _PyStatus_ERR("-X freelist_limits: missing limits");
+        }
+        config->freelist_limits = _PyMem_RawWcsdup(sep + 1);
+        if (config->freelist_limits == NULL) {
+            return _PyStatus_NO_MEMORY();
+        }
+    }
+    else {
+        PyStatus status = CONFIG_GET_ENV_DUP(config, &config->freelist_limits,
+                                             L"PYTHONFREELISTLIMITS",
+                                             "PYTHONFREELISTLIMITS");
+        if (_PyStatus_EXCEPTION(status)) {
+            return status;
+        }
+    }
+
+    int limits[_Py_FREELIST_KINDS];
+    if (config->freelist_limits != NULL
+        && _PyObject_ParseFreeListLimits(config->freelist_limits, limits) < 0)
+    {
+        return _PyStatus_ERR("-X freelist_limits=NAME=LIMIT,... or "
+                             "PYTHONFREELISTLIMITS: invalid free list limits");
+    }
+    return _PyStatus_OK();
+}
+
+
 static PyStatus
 config_read_complex_options(PyConfig *config)
 {
@@ -1766,6 +1828,16 @@ config_read_complex_options(PyConfig *config)
         config->code_debug_ranges = 0;
     }
 
+    if (config_get_env(config, "PYTHONJIT")
+       || config_get_xoption(config, L"jit")) {
+        config->jit = 1;
+    }
+
+    if (config_get_env(config, "PYTHONMALLOCHUGEPAGES")
+       || config_get_xoption(config, L"malloc_hugepages")) {
+        config->malloc_hugepages = 1;
+    }
+
     PyStatus status;
     if (config->tracemalloc < 0) {
         status = config_init_tracemalloc(config);
@@ -1780,6 +1852,13 @@ config_read_complex_options(PyConfig *config)
             return status;
         }
     }
+
+    if (config->freelist_limits == NULL) {
+        status = config_init_freelist_limits(config);
+        if (_PyStatus_EXCEPTION(status)) {
+            return status;
+        }
+    }
     return _PyStatus_OK();
 }
 
@@ -2060,6 +2139,9 @@ const wchar_t* known_xoptions[] = {
     L"pycache_prefix",
     L"warn_default_encoding",
     L"no_debug_ranges",
+    L"jit",
+    L"malloc_hugepages",
+    L"freelist_limits",
     L"frozen_modules",
     NULL,
 };
@@ -2239,6 +2321,8 @@ _PyConfig_Write(const PyConfig *config, _PyRuntimeState *runtime)
     preconfig->use_environment = config->use_environment;
     preconfig->dev_mode = config->dev_mode;
 
+    _PyObject_SetArenaHugePages(config->malloc_hugepages);
+
     if (_Py_SetArgcArgv(config->orig_argv.length,
                         config->orig_argv.items) < 0)
     {
@@ -0,0 +1,253 @@
+/* Machine code for optimized loops.
+ *
+ * A compiled trace is made by copying a fixed template of x86-64 code for
+ * each step and patching the holes in it: the step's argument, the address
+ * of its function and the offsets of its jumps.  The functions themselves
+ * are ordinary C compiled with the interpreter (see the uop implementations
+ * in Python/executor_cases.h), so the templates only do what an interpreter
+ * cannot do cheaply: go from one step to the next, and to a jump target,
+ * without dispatching.
+ *
+ * The generated function follows the System V calling convention.  It keeps
+ * the state pointer in rbx and the value passed from step to step in r12,
+ * both saved on entry.  The functions return the value in rax and the status
+ * in rdx, as the two words of a _PyJITResult, which the generated function
+ * returns in turn.
+ */
+
+#include "Python.h"
+#include "pycore_jit.h"
+
+#ifdef _Py_JIT
+
+#include <sys/mman.h>
+#include <unistd.h>               // sysconf()
+
+/* push rbx; push r12; push rbp (to keep the stack aligned);
+ * mov rbx, rdi; mov r12, rsi */
+static const unsigned char prologue[] = {
+    0x53,
+    0x41, 0x54,
+    0x55,
+    0x48, 0x89, 0xFB,
+    0x49, 0x89, 0xF4,
+};
+
+/* mov rdi, rbx; movabs rsi, <arg>; mov rdx, r12; movabs rax, <function>;
+ * call rax; mov r12, rax */
+static const unsigned char call[] = {
+    0x48, 0x89, 0xDF,
+    0x48, 0xBE, 0, 0, 0, 0, 0, 0, 0, 0,
+    0x4C, 0x89, 0xE2,
+    0x48, 0xB8, 0, 0, 0, 0, 0, 0, 0, 0,
+    0xFF, 0xD0,
+    0x49, 0x89, 0xC4,
+};
+#define CALL_ARG 5
+#define CALL_FUNCTION 18
+
+/* mov rdi, rbx; movabs rsi, <arg>; mov rdx, r12; call <function>;
+ * mov r12, rax */
+static const unsigned char near_call[] = {
+    0x48, 0x89, 0xDF,
+    0x48, 0xBE, 0, 0, 0, 0, 0, 0, 0, 0,
+    0x4C, 0x89, 0xE2,
+    0xE8, 0, 0, 0, 0,
+    0x49, 0x89, 0xC4,
+};
+#define NEAR_CALL_ARG 5
+#define NEAR_CALL_FUNCTION 17
+
+/* test edx, edx; jnz <epilogue> */
+static const unsigned char check[] = {
+    0x85, 0xD2,
+    0x0F, 0x85, 0, 0, 0, 0,
+};
+#define CHECK_EPILOGUE 4
+
+/* test edx, edx; jz <next step>; cmp edx, _PyJIT_JUMP; je <jump>;
+ * jmp <epilogue> */
+static const unsigned char check_jump[] = {
+    0x85, 0xD2,
+    0x74, 0x0E,
+    0x83, 0xFA, _PyJIT_JUMP,
+    0x0F, 0x84, 0, 0, 0, 0,
+    0xE9, 0, 0, 0, 0,
+};
+#define CHECK_JUMP_JUMP 9
+#define CHECK_JUMP_EPILOGUE 14
+
+/* jmp <jump> */
+static const unsigned char jump[] = {
+    0xE9, 0, 0, 0, 0,
+};
+#define JUMP_JUMP 1
+
+/* pop rbp; pop r12; pop rbx; ret
+ *
+ * It is only reached from a check, so rax and rdx still hold the result of
+ * the last step. */
+static const unsigned char epilogue[] = {
+    0x5D,
+    0x41, 0x5C,
+    0x5B,
+    0xC3,
+};
+
+/* Can code anywhere in [code, code + size) call function directly? */
+static int
+is_near(const unsigned char *code, size_t size, _PyJITFunction function)
+{
+    intptr_t distance = (intptr_t)function - (intptr_t)code;
+    intptr_t limit = INT32_MAX - (intptr_t)size;
+    return -limit < distance && distance < limit;
+}
+
+static size_t
+step_size(const _PyJITStep *step, int near)
+{
+    size_t size = near ? sizeof(near_call) : sizeof(call);
+    if (step->function == NULL) {
+        return sizeof(jump);
+    }
+    if (step->jump < 0) {
+        return size + sizeof(check);
+    }
+    return size + sizeof(check_jump);
+}
+
+/* Where the next code is mapped, if possible: below the executable (with
+ * room for its other segments), so that it can call the functions directly */
+#define CODE_DISTANCE ((uintptr_t)1 << 28)
+static uintptr_t next_address = 0;
+
+static unsigned char *
+allocate(size_t size)
+{
+    if (next_address == 0) {
+        uintptr_t text = (uintptr_t)&_PyJIT_Compile;
+        if (text > 2 * CODE_DISTANCE) {
+            next_address = (text - CODE_DISTANCE) & ~(CODE_DISTANCE - 1);
+        }
+    }
+    void *hint = NULL;
+    if (next_address > CODE_DISTANCE) {
+        hint = (void *)(next_address - size);
+    }
+    unsigned char *code = mmap(hint, size, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (code == MAP_FAILED) {
+        return NULL;
+    }
+    if (code == hint) {
+        next_address = (uintptr_t)code;
+    }
+    return code;
+}
+
+static void
+patch_64(unsigned char *hole, const void *value)
+{
+    uint64_t bits = (uintptr_t)value;
+    memcpy(hole, &bits, sizeof(bits));
+}
+
+/* Patch the rel32 operand ending the instruction at hole + 4 */
+static void
+patch_rel32(unsigned char *hole, const unsigned char *target)
+{
+    int32_t offset = (int32_t)(target - (hole + 4));
+    memcpy(hole, &offset, sizeof(offset));
+}
+
+_PyJITCode
+_PyJIT_Compile(const _PyJITStep *steps, int length, size_t *size)
+{
+    /* Map enough memory for the largest templates... */
+    size_t code_size = sizeof(prologue) + sizeof(epilogue);
+    for (int i = 0; i < length; i++) {
+        code_size += step_size(&steps[i], 0);
+    }
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size <= 0) {
+        page_size = 4096;
+    }
+    code_size = _Py_SIZE_ROUND_UP(code_size, (size_t)page_size);
+    unsigned char *code = allocate(code_size);
+    if (code == NULL) {
+        return NULL;
+    }
+
+    /* ...work out where everything goes... */
+    size_t *offsets = PyMem_Malloc((length + 1) * sizeof(size_t));
+    char *near = PyMem_Malloc(length);
+    if (offsets == NULL || near == NULL) {
+        PyMem_Free(offsets);
+        PyMem_Free(near);
+        munmap(code, code_size);
+        return NULL;
+    }
+    size_t offset = sizeof(prologue);
+    for (int i = 0; i < length; i++) {
+        near[i] = is_near(code, code_size, steps[i].function);
+        offsets[i] = offset;
+        offset += step_size(&steps[i], near[i]);
+    }
+    offsets[length] = offset;
+    unsigned char *end = code + offsets[length];
+
+    /* ...then copy and patch the templates */
+    memcpy(code, prologue, sizeof(prologue));
+    for (int i = 0; i < length; i++) {
+        const _PyJITStep *step = &steps[i];
+        unsigned char *p = code + offsets[i];
+        if (step->function == NULL) {
+            assert(step->jump >= 0 && step->jump < length);
+            memcpy(p, jump, sizeof(jump));
+            patch_rel32(p + JUMP_JUMP, code + offsets[step->jump]);
+            continue;
+        }
+        if (near[i]) {
+            memcpy(p, near_call, sizeof(near_call));
+            patch_64(p + NEAR_CALL_ARG, step->arg);
+            patch_rel32(p + NEAR_CALL_FUNCTION,
+                        (const unsigned char *)step->function);
+            p += sizeof(near_call);
+        }
+        else {
+            memcpy(p, call, sizeof(call));
+            patch_64(p + CALL_ARG, step->arg);
+            patch_64(p + CALL_FUNCTION, (void *)step->function);
+            p += sizeof(call);
+        }
+        if (step->jump < 0) {
+            memcpy(p, check, sizeof(check));
+            patch_rel32(p + CHECK_EPILOGUE, end);
+        }
+        else {
+            assert(step->jump < length);
+            memcpy(p, check_jump, sizeof(check_jump));
+            patch_rel32(p + CHECK_JUMP_JUMP, code + offsets[step->jump]);
+            patch_rel32(p + CHECK_JUMP_EPILOGUE, end);
+        }
+    }
+    memcpy(end, epilogue, sizeof(epilogue));
+    PyMem_Free(offsets);
+    PyMem_Free(near);
+
+    if (mprotect(code, code_size, PROT_READ | PROT_EXEC) < 0) {
+        munmap(code, code_size);
+        return NULL;
+    }
+    __builtin___clear_cache((char *)code, (char *)end + sizeof(epilogue));
+    *size = code_size;
+    return (_PyJITCode)code;
+}
+
+void
+_PyJIT_Free(_PyJITCode code, size_t size)
+{
+    munmap((void *)code, size);
+}
+
+#endif  /* _Py_JIT */
@@ -0,0 +1,1472 @@
+/* Loop optimizer.
+ *
+ * The specializing interpreter guards every specialized instruction on its
+ * own, so a hot loop keeps re-checking types it has already checked.  When
+ * a JUMP_BACKWARD_QUICK gets hot, the loop body it closes is projected into
+ * a trace of micro-ops (uops): each specialized instruction is split into
+ * the type guards it performs and the action that follows them.  The trace
+ * is then optimized as a whole:
+ *
+ *  - guards on values whose type is already known (constants, results of
+ *    int and float arithmetic, range loop variables, values that an earlier
+ *    guard in the trace has checked) are removed;
+ *  - guards on locals that are loop invariant, or that the loop only ever
+ *    stores values of the guarded type to, and guards on values lying below
+ *    the loop's stack (its iterator) are hoisted into a preamble that runs
+ *    once each time the executor is entered;
+ *  - a value that is loaded and immediately popped is dropped, together
+ *    with the reference count changes that came with it.
+ *
+ * The executor runs the trace on the frame's own locals and value stack, so
+ * that on any exit the frame is exactly in the state the interpreter expects
+ * at the instruction the exit belongs to.  Guard failures resume at the
+ * start of the failing instruction, which the interpreter then executes
+ * (and deoptimizes) as usual.  An executor that keeps failing its guards is
+ * discarded.
+ *
+ * Only loop bodies made of the simple instructions handled in
+ * project_trace() are optimized; anything else is left to the interpreter.
+ * Jumps forward within the body, and conditional jumps back to the loop head,
+ * stay in the trace; other jumps leave it.
+ */
+
+#include "Python.h"
+#include "pycore_code.h"
+#include "pycore_floatobject.h"   // _PyFloat_ExactDealloc()
+#include "pycore_frame.h"
+#include "pycore_jit.h"           // _PyJIT_Compile()
+#include "pycore_list.h"          // _PyListIterObject
+#include "pycore_long.h"          // _PyLong_Add()
+#include "pycore_object.h"        // _Py_DECREF_SPECIALIZED()
+#include "pycore_opcode.h"        // _PyOpcode_Deopt
+#include "pycore_optimizer.h"
+#include "pycore_pystate.h"       // _PyThreadState_GET()
+#include "pycore_range.h"         // _PyRangeIterObject
+#include "pycore_tuple.h"         // _PyTuple_ITEMS()
+
+#include <stdbool.h>
+
+/* Longest trace the optimizer builds, in uops. */
+#define MAX_TRACE_LENGTH 256
+
+/* Code objects with more locals or a deeper stack are not optimized. */
+#define MAX_LOCALS 256
+#define MAX_STACK_DEPTH 64
+
+/* Forward branches inside the loop body that may be pending at once */
+#define MAX_BRANCHES 4
+
+/* Micro-ops */
+enum {
+    UOP_LOAD_FAST = 1,
+    UOP_LOAD_CONST,
+    UOP_STORE_FAST,
+    UOP_POP_TOP,
+    UOP_GUARD_STACK,
+    UOP_GUARD_LOCAL,
+    UOP_ADD_INT,
+    UOP_SUBTRACT_INT,
+    UOP_MULTIPLY_INT,
+    UOP_ADD_FLOAT,
+    UOP_SUBTRACT_FLOAT,
+    UOP_MULTIPLY_FLOAT,
+    UOP_SUBSCR_LIST_INT,
+    UOP_COMPARE_INT_JUMP,       /* Leaves the trace if the jump is taken */
+    UOP_COMPARE_FLOAT_JUMP,
+    UOP_COMPARE_INT_BRANCH,     /* Jumps forward within the trace */
+    UOP_COMPARE_FLOAT_BRANCH,
+    UOP_JUMP_FORWARD,
+    UOP_FOR_ITER_RANGE,
+    UOP_FOR_ITER_LIST,
+    UOP_JUMP_TO_BODY,
+    UOP_POP_JUMP_TO_BODY,       /* Conditional jump back, see project_trace() */
+};
+
+/* Where the operands of a uop come from, kept in its type field: the stack,
+ * or the local or constant whose index is in its left and right fields.
+ * Uops with a single operand use the right one. */
+#define OPERAND_STACK 0
+#define OPERAND_LOCAL 1
+#define OPERAND_CONST 2
+#define OPERANDS(left, right) ((left) | ((right) << 2))
+#define LEFT_OPERAND(uop) ((uop)->type & 3)
+#define RIGHT_OPERAND(uop) ((uop)->type >> 2)
+#define OPERAND_KIND(load) \
+    ((load)->opcode == UOP_LOAD_FAST ? OPERAND_LOCAL : OPERAND_CONST)
+
+/* Types known to, or checked by, the optimizer */
+enum {
+    TYPE_UNKNOWN = 0,
+    TYPE_INT,
+    TYPE_COMPACT_INT,       /* int with at most one digit */
+    TYPE_FLOAT,
+    TYPE_LIST,
+    TYPE_RANGE_ITER,
+    TYPE_LIST_ITER,
+};
+
+static inline bool
+type_implies(int have, int need)
+{
+    return have == need || (have == TYPE_COMPACT_INT && need == TYPE_INT);
+}
+
+static inline int
+type_meet(int a, int b)
+{
+    if (type_implies(a, b)) {
+        return b;
+    }
+    if (type_implies(b, a)) {
+        return a;
+    }
+    return TYPE_UNKNOWN;
+}
+
+static inline bool
+type_check(PyObject *value, int type)
+{
+    switch (type) {
+        case TYPE_INT:
+            return PyLong_CheckExact(value);
+        case TYPE_COMPACT_INT:
+            return PyLong_CheckExact(value) &&
+                   (size_t)(Py_SIZE(value) + 1) <= 2;
+        case TYPE_FLOAT:
+            return PyFloat_CheckExact(value);
+        case TYPE_LIST:
+            return PyList_CheckExact(value);
+        case TYPE_RANGE_ITER:
+            return Py_IS_TYPE(value, &PyRangeIter_Type);
+        case TYPE_LIST_ITER:
+            return Py_IS_TYPE(value, &PyListIter_Type);
+    }
+    Py_UNREACHABLE();
+}
+
+static int
+type_of_constant(PyObject *value)
+{
+    if (PyLong_CheckExact(value)) {
+        if ((size_t)(Py_SIZE(value) + 1) <= 2) {
+            return TYPE_COMPACT_INT;
+        }
+        return TYPE_INT;
+    }
+    if (PyFloat_CheckExact(value)) {
+        return TYPE_FLOAT;
+    }
+    return TYPE_UNKNOWN;
+}
+
+
+/* Projection */
+
+typedef struct {
+    _PyUOpInstruction uops[MAX_TRACE_LENGTH];
+    int length;
+} Trace;
+
+static int
+emit(Trace *trace, int opcode, int type, int oparg, int target, int exit)
+{
+    if (trace->length == MAX_TRACE_LENGTH) {
+        return -1;
+    }
+    _PyUOpInstruction *uop = &trace->uops[trace->length++];
+    uop->opcode = opcode;
+    uop->type = type;
+    uop->oparg = oparg;
+    uop->left = 0;
+    uop->right = 0;
+    uop->target = target;
+    uop->exit = exit;
+    return 0;
+}
+
+#define EMIT(opcode, type, oparg, target, exit) \
+    do { \
+        if (emit(trace, (opcode), (type), (oparg), (target), (exit)) < 0) { \
+            return -1; \
+        } \
+    } while (0)
+
+#define GUARD(depth, type) EMIT(UOP_GUARD_STACK, (type), (depth), i, 0)
+
+static inline bool
+is_back_edge_to(_Py_CODEUNIT *instructions, int i, int head)
+{
+    return _PyOpcode_Deopt[_Py_OPCODE(instructions[i])] == JUMP_BACKWARD &&
+           i + 1 - _Py_OPARG(instructions[i]) == head;
+}
+
+/* Translate the loop starting at head and closed by the JUMP_BACKWARD at
+ * backedge into uops.  Returns -1 if the loop body cannot be handled. */
+static int
+project_trace(PyCodeObject *code, int head, int backedge, Trace *trace)
+{
+    _Py_CODEUNIT *instructions = _PyCode_CODE(code);
+    if (Py_SIZE(code) > INT32_MAX) {
+        return -1;
+    }
+    /* The compiler gives each path through the body of a for loop its own
+     * back edge; the last one comes right before the loop exit. */
+    int end = backedge;
+    int head_opcode = _PyOpcode_Deopt[_Py_OPCODE(instructions[head])];
+    if (head_opcode == FOR_ITER) {
+        int last = head + INLINE_CACHE_ENTRIES_FOR_ITER +
+                   _Py_OPARG(instructions[head]);
+        if (last > backedge && last < Py_SIZE(code) &&
+            is_back_edge_to(instructions, last, head))
+        {
+            end = last;
+        }
+    }
+    trace->length = 0;
+    int i = head;
+    while (i <= end) {
+        int opcode = _Py_OPCODE(instructions[i]);
+        int oparg = _Py_OPARG(instructions[i]);
+        /* A superinstruction is handled as its first half; the second half
+         * is the following code unit, which is left unchanged. */
+        if (_PyOpcode_SuperinstructionSecond[opcode]) {
+            opcode = _PyOpcode_Deopt[opcode];
+        }
+        int next = i + 1 + _PyOpcode_Caches[_PyOpcode_Deopt[opcode]];
+        switch (opcode) {
+            case NOP:
+                break;
+            case LOAD_FAST:
+                EMIT(UOP_LOAD_FAST, 0, oparg, i, 0);
+                break;
+            case LOAD_CONST:
+                EMIT(UOP_LOAD_CONST, 0, oparg, i, 0);
+                break;
+            case STORE_FAST:
+                EMIT(UOP_STORE_FAST, 0, oparg, i, next);
+                break;
+            case POP_TOP:
+                EMIT(UOP_POP_TOP, 0, 0, i, next);
+                break;
+            case BINARY_OP_ADD_INT:
+                GUARD(2, TYPE_INT);
+                GUARD(1, TYPE_INT);
+                EMIT(UOP_ADD_INT, 0, 0, i, 0);
+                break;
+            case BINARY_OP_SUBTRACT_INT:
+                GUARD(2, TYPE_INT);
+                GUARD(1, TYPE_INT);
+                EMIT(UOP_SUBTRACT_INT, 0, 0, i, 0);
+                break;
+            case BINARY_OP_MULTIPLY_INT:
+                GUARD(2, TYPE_INT);
+                GUARD(1, TYPE_INT);
+                EMIT(UOP_MULTIPLY_INT, 0, 0, i, 0);
+                break;
+            case BINARY_OP_ADD_FLOAT:
+                GUARD(2, TYPE_FLOAT);
+                GUARD(1, TYPE_FLOAT);
+                EMIT(UOP_ADD_FLOAT, 0, 0, i, 0);
+                break;
+            case BINARY_OP_SUBTRACT_FLOAT:
+                GUARD(2, TYPE_FLOAT);
+                GUARD(1, TYPE_FLOAT);
+                EMIT(UOP_SUBTRACT_FLOAT, 0, 0, i, 0);
+                break;
+            case BINARY_OP_MULTIPLY_FLOAT:
+                GUARD(2, TYPE_FLOAT);
+                GUARD(1, TYPE_FLOAT);
+                EMIT(UOP_MULTIPLY_FLOAT, 0, 0, i, 0);
+                break;
+            case BINARY_SUBSCR_LIST_INT:
+                GUARD(2, TYPE_LIST);
+                GUARD(1, TYPE_INT);
+                EMIT(UOP_SUBSCR_LIST_INT, 0, 0, i, next);
+                break;
+            case COMPARE_OP_INT_JUMP:
+            case COMPARE_OP_FLOAT_JUMP: {
+                int jump = _Py_OPCODE(instructions[next]);
+                int jump_oparg = _Py_OPARG(instructions[next]);
+                int dest;
+                switch (jump) {
+                    case POP_JUMP_FORWARD_IF_FALSE:
+                    case POP_JUMP_FORWARD_IF_TRUE:
+                        dest = next + 1 + jump_oparg;
+                        break;
+                    case POP_JUMP_BACKWARD_IF_FALSE:
+                    case POP_JUMP_BACKWARD_IF_TRUE:
+                        dest = next + 1 - jump_oparg;
+                        break;
+                    default:
+                        return -1;
+                }
+                _PyCompareOpCache *cache = (_PyCompareOpCache *)&instructions[i + 1];
+                int mask = cache->mask;
+                bool is_int = opcode == COMPARE_OP_INT_JUMP;
+                int type = is_int ? TYPE_COMPACT_INT : TYPE_FLOAT;
+                int branch = is_int ? UOP_COMPARE_INT_BRANCH
+                                    : UOP_COMPARE_FLOAT_BRANCH;
+                GUARD(2, type);
+                GUARD(1, type);
+                if (dest > next && dest <= end) {
+                    /* Branches that stay in the loop body stay in the trace;
+                     * their destination is resolved by optimize_trace(). */
+                    EMIT(branch, 0, mask, i, dest);
+                }
+                else if (dest == head && next + 1 <= end) {
+                    /* Jumping back to the head continues the loop: branch
+                     * over the jump back if it is not taken. */
+                    EMIT(branch, 0, ~(mask | mask >> 3) & 7, i, next + 1);
+                    EMIT(UOP_POP_JUMP_TO_BODY, 0,
+                         jump == POP_JUMP_BACKWARD_IF_TRUE, next, 0);
+                }
+                else {
+                    EMIT(is_int ? UOP_COMPARE_INT_JUMP : UOP_COMPARE_FLOAT_JUMP,
+                         0, mask, i, dest);
+                }
+                next++;
+                break;
+            }
+            case FOR_ITER_RANGE: {
+                _Py_CODEUNIT store = instructions[next];
+                if (_PyOpcode_Deopt[_Py_OPCODE(store)] != STORE_FAST) {
+                    return -1;
+                }
+                GUARD(1, TYPE_RANGE_ITER);
+                EMIT(UOP_FOR_ITER_RANGE, 0, _Py_OPARG(store), i, next + 1);
+                next++;
+                break;
+            }
+            case FOR_ITER_LIST:
+                GUARD(1, TYPE_LIST_ITER);
+                EMIT(UOP_FOR_ITER_LIST, 0, 0, i, 0);
+                break;
+            case JUMP_FORWARD:
+                if (next + oparg > end) {
+                    return -1;
+                }
+                EMIT(UOP_JUMP_FORWARD, 0, 0, i, next + oparg);
+                break;
+            case JUMP_BACKWARD:
+            case JUMP_BACKWARD_QUICK:
+            case JUMP_BACKWARD_EXECUTOR:
+                if (!is_back_edge_to(instructions, i, head)) {
+                    return -1;
+                }
+                EMIT(UOP_JUMP_TO_BODY, 0, 0, i, 0);
+                break;
+            default:
+                return -1;
+        }
+        i = next;
+    }
+    if (i != end + 1) {
+        return -1;
+    }
+    return 0;
+}
+
+#undef GUARD
+#undef EMIT
+
+
+/* Optimization */
+
+typedef struct {
+    uint8_t type;       /* Known type, unless linked to a local */
+    int local;          /* Local still holding the same object, or -1 */
+    int entry;          /* Index in the stack on entry, or -1 */
+} AbstractValue;
+
+typedef struct {
+    uint8_t locals[MAX_LOCALS];
+    bool stored[MAX_LOCALS];    /* Locals stored to since entering the loop */
+    AbstractValue stack[MAX_STACK_DEPTH];
+    int depth;
+} AbstractState;
+
+typedef struct {
+    /* Inputs: types assumed when the trace is entered */
+    uint8_t assumed_locals[MAX_LOCALS];
+    uint8_t assumed_entry[MAX_STACK_DEPTH];
+    /* Outputs */
+    AbstractState end;                  /* State when jumping back */
+    uint8_t needed_locals[MAX_LOCALS];  /* Guards that could be hoisted */
+    uint8_t needed_entry[MAX_STACK_DEPTH];
+    bool redundant[MAX_TRACE_LENGTH];   /* Guards known to succeed */
+    /* Scratch space */
+    AbstractState state;
+    struct {
+        int dest;
+        AbstractState state;
+    } pending[MAX_BRANCHES];
+} Analysis;
+
+static inline int
+value_type(AbstractValue *value, uint8_t *locals)
+{
+    if (value->local >= 0) {
+        return locals[value->local];
+    }
+    return value->type;
+}
+
+static inline uint8_t
+stronger(uint8_t current, int type)
+{
+    if (current == TYPE_UNKNOWN || type_implies(type, current)) {
+        return type;
+    }
+    return current;
+}
+
+/* Values still on the stack keep the object a local held before a store */
+static void
+unlink_local(AbstractState *state, int local)
+{
+    for (int i = 0; i < state->depth; i++) {
+        if (state->stack[i].local == local) {
+            state->stack[i].type = state->locals[local];
+            state->stack[i].local = -1;
+        }
+    }
+}
+
+/* Merge the state of a branch into the state of the path it joins. */
+static int
+merge_states(AbstractState *state, AbstractState *other, int nlocals)
+{
+    if (state->depth != other->depth) {
+        return -1;
+    }
+    for (int i = 0; i < state->depth; i++) {
+        AbstractValue *value = &state->stack[i];
+        AbstractValue *other_value = &other->stack[i];
+        if (value->local >= 0 && value->local == other_value->local) {
+            continue;
+        }
+        value->type = type_meet(value_type(value, state->locals),
+                                value_type(other_value, other->locals));
+        value->local = -1;
+        if (value->entry != other_value->entry) {
+            value->entry = -1;
+        }
+    }
+    for (int i = 0; i < nlocals; i++) {
+        state->locals[i] = type_meet(state->locals[i], other->locals[i]);
+        state->stored[i] |= other->stored[i];
+    }
+    return 0;
+}
+
+/* Abstract interpretation of the trace, one iteration of the loop.
+ * Returns -1 if the trace does something the analysis cannot follow. */
+static int
+analyze(Trace *trace, PyCodeObject *code, int entry_depth, Analysis *a)
+{
+    int nlocals = code->co_nlocalsplus;
+    int max_depth = code->co_stacksize;
+    AbstractState *state = &a->state;
+    AbstractValue *stack = state->stack;
+    int npending = 0;
+    bool reachable = true;
+    bool jumped_back = false;
+    assert(nlocals <= MAX_LOCALS && max_depth <= MAX_STACK_DEPTH);
+    assert(entry_depth <= max_depth);
+    state->depth = entry_depth;
+    for (int i = 0; i < entry_depth; i++) {
+        stack[i].type = a->assumed_entry[i];
+        stack[i].local = -1;
+        stack[i].entry = i;
+        a->needed_entry[i] = TYPE_UNKNOWN;
+    }
+    for (int i = 0; i < nlocals; i++) {
+        state->locals[i] = a->assumed_locals[i];
+        state->stored[i] = false;
+        a->needed_locals[i] = TYPE_UNKNOWN;
+    }
+
+#define PUSH_VALUE(TYPE, LOCAL) \
+    do { \
+        if (state->depth == max_depth) { \
+            return -1; \
+        } \
+        stack[state->depth].type = (TYPE); \
+        stack[state->depth].local = (LOCAL); \
+        stack[state->depth].entry = -1; \
+        state->depth++; \
+    } while (0)
+#define POP_VALUES(N) \
+    do { \
+        if (state->depth - (N) < entry_depth) { \
+            return -1; \
+        } \
+        state->depth -= (N); \
+    } while (0)
+
+    for (int pc = 0; pc < trace->length; pc++) {
+        _PyUOpInstruction *uop = &trace->uops[pc];
+        a->redundant[pc] = false;
+        /* Join the branches that land here */
+        for (int i = 0; i < npending; ) {
+            if (a->pending[i].dest <= uop->target) {
+                if (!reachable) {
+                    *state = a->pending[i].state;
+                    reachable = true;
+                }
+                else if (merge_states(state, &a->pending[i].state,
+                                      nlocals) < 0) {
+                    return -1;
+                }
+                npending--;
+                if (i != npending) {
+                    a->pending[i].dest = a->pending[npending].dest;
+                    a->pending[i].state = a->pending[npending].state;
+                }
+            }
+            else {
+                i++;
+            }
+        }
+        if (!reachable) {
+            return -1;
+        }
+        switch (uop->opcode) {
+            case UOP_LOAD_FAST:
+                PUSH_VALUE(TYPE_UNKNOWN, uop->oparg);
+                break;
+            case UOP_LOAD_CONST: {
+                PyObject *value = PyTuple_GET_ITEM(code->co_consts, uop->oparg);
+                PUSH_VALUE(type_of_constant(value), -1);
+                break;
+            }
+            case UOP_STORE_FAST: {
+                int local = uop->oparg;
+                POP_VALUES(1);
+                int type = value_type(&stack[state->depth], state->locals);
+                unlink_local(state, local);
+                state->locals[local] = type;
+                state->stored[local] = true;
+                break;
+            }
+            case UOP_POP_TOP:
+                POP_VALUES(1);
+                break;
+            case UOP_GUARD_STACK: {
+                if (uop->oparg > state->depth) {
+                    return -1;
+                }
+                AbstractValue *value = &stack[state->depth - uop->oparg];
+                int type = uop->type;
+                if (type_implies(value_type(value, state->locals), type)) {
+                    a->redundant[pc] = true;
+                    break;
+                }
+                if (value->local >= 0) {
+                    if (!state->stored[value->local]) {
+                        a->needed_locals[value->local] =
+                            stronger(a->needed_locals[value->local], type);
+                    }
+                    state->locals[value->local] = type;
+                }
+                else {
+                    if (value->entry >= 0) {
+                        a->needed_entry[value->entry] =
+                            stronger(a->needed_entry[value->entry], type);
+                    }
+                    value->type = type;
+                }
+                break;
+            }
+            case UOP_ADD_INT:
+            case UOP_SUBTRACT_INT:
+            case UOP_MULTIPLY_INT:
+                POP_VALUES(2);
+                PUSH_VALUE(TYPE_INT, -1);
+                break;
+            case UOP_ADD_FLOAT:
+            case UOP_SUBTRACT_FLOAT:
+            case UOP_MULTIPLY_FLOAT:
+                POP_VALUES(2);
+                PUSH_VALUE(TYPE_FLOAT, -1);
+                break;
+            case UOP_SUBSCR_LIST_INT:
+                POP_VALUES(2);
+                PUSH_VALUE(TYPE_UNKNOWN, -1);
+                break;
+            case UOP_COMPARE_INT_JUMP:
+            case UOP_COMPARE_FLOAT_JUMP:
+                POP_VALUES(2);
+                break;
+            case UOP_COMPARE_INT_BRANCH:
+            case UOP_COMPARE_FLOAT_BRANCH:
+                POP_VALUES(2);
+                if (npending == MAX_BRANCHES) {
+                    return -1;
+                }
+                a->pending[npending].dest = uop->exit;
+                a->pending[npending].state = *state;
+                npending++;
+                break;
+            case UOP_JUMP_FORWARD:
+                if (npending == MAX_BRANCHES) {
+                    return -1;
+                }
+                a->pending[npending].dest = uop->exit;
+                a->pending[npending].state = *state;
+                npending++;
+                reachable = false;
+                break;
+            case UOP_FOR_ITER_RANGE:
+                unlink_local(state, uop->oparg);
+                state->locals[uop->oparg] = TYPE_INT;
+                state->stored[uop->oparg] = true;
+                break;
+            case UOP_FOR_ITER_LIST:
+                PUSH_VALUE(TYPE_UNKNOWN, -1);
+                break;
+            case UOP_JUMP_TO_BODY:
+            case UOP_POP_JUMP_TO_BODY:
+                if (state->depth != entry_depth) {
+                    return -1;
+                }
+                if (!jumped_back) {
+                    a->end = *state;
+                    jumped_back = true;
+                }
+                else if (merge_states(&a->end, state, nlocals) < 0) {
+                    return -1;
+                }
+                reachable = false;
+                break;
+            default:
+                Py_UNREACHABLE();
+        }
+    }
+#undef PUSH_VALUE
+#undef POP_VALUES
+    if (reachable || npending != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+static inline bool
+is_branch(_PyUOpInstruction *uop)
+{
+    return uop->opcode == UOP_COMPARE_INT_BRANCH ||
+           uop->opcode == UOP_COMPARE_FLOAT_BRANCH ||
+           uop->opcode == UOP_JUMP_FORWARD;
+}
+
+/* Does a branch land after the instruction at start, up to end? */
+static bool
+branch_lands_in(Trace *trace, int start, int end)
+{
+    for (int pc = 0; pc < trace->length; pc++) {
+        _PyUOpInstruction *uop = &trace->uops[pc];
+        if (is_branch(uop) && uop->exit > start && uop->exit <= end) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Drop values that are loaded only to be popped straight away. */
+static void
+remove_dead_loads(Trace *trace)
+{
+    int out = 0;
+    for (int pc = 0; pc < trace->length; pc++) {
+        _PyUOpInstruction *uop = &trace->uops[pc];
+        if ((uop->opcode == UOP_LOAD_FAST || uop->opcode == UOP_LOAD_CONST) &&
+            pc + 1 < trace->length &&
+            trace->uops[pc + 1].opcode == UOP_POP_TOP &&
+            !branch_lands_in(trace, uop->target, trace->uops[pc + 1].target))
+        {
+            pc++;
+            continue;
+        }
+        trace->uops[out++] = *uop;
+    }
+    trace->length = out;
+}
+
+/* Number of operands a uop can take directly from locals and constants */
+static int
+foldable_operands(int opcode)
+{
+    switch (opcode) {
+        case UOP_STORE_FAST:
+            return 1;
+        case UOP_ADD_INT:
+        case UOP_SUBTRACT_INT:
+        case UOP_MULTIPLY_INT:
+        case UOP_ADD_FLOAT:
+        case UOP_SUBTRACT_FLOAT:
+        case UOP_MULTIPLY_FLOAT:
+        case UOP_SUBSCR_LIST_INT:
+        case UOP_COMPARE_INT_JUMP:
+        case UOP_COMPARE_FLOAT_JUMP:
+        case UOP_COMPARE_INT_BRANCH:
+        case UOP_COMPARE_FLOAT_BRANCH:
+            return 2;
+    }
+    return 0;
+}
+
+/* Fold the loads emitted just before uop (uops[..out], followed by uop's own
+ * guards) into its operands.  Returns the new end of uops. */
+static int
+fold_loads(_PyUOpInstruction *uops, int out, _PyUOpInstruction *uop,
+           int max_fold, int *dests, int ndests, PyObject *consts)
+{
+    int guards = out;
+    while (guards > 0 && uops[guards - 1].opcode == UOP_GUARD_STACK &&
+           uops[guards - 1].target == uop->target)
+    {
+        guards--;
+    }
+    int loads = guards;
+    while (loads > 0 && guards - loads < max_fold &&
+           (uops[loads - 1].opcode == UOP_LOAD_FAST ||
+            uops[loads - 1].opcode == UOP_LOAD_CONST))
+    {
+        loads--;
+    }
+    int nfold = guards - loads;
+    if (nfold == 0 || out - guards > 2) {
+        return out;
+    }
+    /* Without the loads, the uop starts where the first load did */
+    int start = uops[loads].target;
+    for (int i = 0; i < ndests; i++) {
+        if (dests[i] > start && dests[i] <= uop->target) {
+            return out;
+        }
+    }
+    /* The guards now run before the loads: those on folded values check
+     * the local directly, or go if the value is a constant. */
+    _PyUOpInstruction moved[2];
+    int nmoved = 0;
+    for (int pc = guards; pc < out; pc++) {
+        _PyUOpInstruction guard = uops[pc];
+        if (guard.oparg > nfold) {
+            guard.oparg -= nfold;
+        }
+        else {
+            _PyUOpInstruction *load = &uops[guards - guard.oparg];
+            if (load->opcode == UOP_LOAD_CONST) {
+                if (!type_check(PyTuple_GET_ITEM(consts, load->oparg),
+                                guard.type)) {
+                    return out;
+                }
+                continue;
+            }
+            guard.opcode = UOP_GUARD_LOCAL;
+            guard.oparg = load->oparg;
+        }
+        guard.target = start;
+        moved[nmoved++] = guard;
+    }
+    /* The last load is the right operand */
+    _PyUOpInstruction *right = &uops[guards - 1];
+    uop->type = OPERANDS(OPERAND_STACK, OPERAND_KIND(right));
+    uop->right = right->oparg;
+    if (nfold == 2) {
+        _PyUOpInstruction *left = &uops[loads];
+        uop->type = OPERANDS(OPERAND_KIND(left), OPERAND_KIND(right));
+        uop->left = left->oparg;
+    }
+    out = loads;
+    for (int i = 0; i < nmoved; i++) {
+        uops[out++] = moved[i];
+    }
+    return out;
+}
+
+/* Let uops read the locals and constants that are loaded only to be passed
+ * to them, instead of having them pushed to and popped from the stack. */
+static void
+fold_operands(Trace *trace, PyCodeObject *code)
+{
+    _PyUOpInstruction *uops = trace->uops;
+    int dests[MAX_TRACE_LENGTH];
+    int ndests = 0;
+    for (int pc = 0; pc < trace->length; pc++) {
+        if (is_branch(&uops[pc])) {
+            dests[ndests++] = uops[pc].exit;
+        }
+    }
+    int out = 0;
+    for (int pc = 0; pc < trace->length; pc++) {
+        _PyUOpInstruction uop = uops[pc];
+        int max_fold = foldable_operands(uop.opcode);
+        if (max_fold > 0) {
+            out = fold_loads(uops, out, &uop, max_fold, dests, ndests,
+                             code->co_consts);
+        }
+        uops[out++] = uop;
+    }
+    trace->length = out;
+}
+
+static _PyExecutor *
+optimize_trace(Trace *trace, Analysis *a, PyCodeObject *code,
+               int head, int backedge, int entry_depth)
+{
+    int nlocals = code->co_nlocalsplus;
+    if (nlocals > MAX_LOCALS || code->co_stacksize > MAX_STACK_DEPTH) {
+        return NULL;
+    }
+    uint8_t *assumed_locals = a->assumed_locals;
+    uint8_t *assumed_entry = a->assumed_entry;
+
+    remove_dead_loads(trace);
+
+    /* Find the guards that could move to the preamble... */
+    memset(assumed_locals, TYPE_UNKNOWN, nlocals);
+    memset(assumed_entry, TYPE_UNKNOWN, entry_depth);
+    if (analyze(trace, code, entry_depth, a) < 0) {
+        return NULL;
+    }
+    memcpy(assumed_locals, a->needed_locals, nlocals);
+    memcpy(assumed_entry, a->needed_entry, entry_depth);
+    /* ...then keep assuming only what the loop itself preserves: a local
+     * the loop stores to must hold a value of the assumed type again when
+     * it jumps back. */
+    for (;;) {
+        if (analyze(trace, code, entry_depth, a) < 0) {
+            return NULL;
+        }
+        bool changed = false;
+        for (int i = 0; i < nlocals; i++) {
+            if (a->end.stored[i]) {
+                int type = type_meet(assumed_locals[i], a->end.locals[i]);
+                if (type != assumed_locals[i]) {
+                    assumed_locals[i] = type;
+                    changed = true;
+                }
+            }
+        }
+        if (!changed) {
+            break;
+        }
+    }
+
+    /* Drop the guards known to succeed */
+    int length = 0;
+    for (int pc = 0; pc < trace->length; pc++) {
+        if (!a->redundant[pc]) {
+            trace->uops[length++] = trace->uops[pc];
+        }
+    }
+    trace->length = length;
+    fold_operands(trace, code);
+
+    int preamble = 0;
+    for (int i = 0; i < nlocals; i++) {
+        preamble += assumed_locals[i] != TYPE_UNKNOWN;
+    }
+    for (int i = 0; i < entry_depth; i++) {
+        preamble += assumed_entry[i] != TYPE_UNKNOWN;
+    }
+    length = preamble + trace->length;
+    _PyExecutor *executor = PyMem_Malloc(
+        offsetof(_PyExecutor, trace) + length * sizeof(_PyUOpInstruction));
+    if (executor == NULL) {
+        return NULL;
+    }
+    executor->backedge = backedge;
+    executor->deopts_left = EXECUTOR_DEOPT_LIMIT;
+    executor->body = preamble;
+    executor->length = length;
+    executor->jit_code = NULL;
+    executor->jit_size = 0;
+    _PyUOpInstruction *out = executor->trace;
+    for (int i = 0; i < nlocals; i++) {
+        if (assumed_locals[i] != TYPE_UNKNOWN) {
+            *out++ = (_PyUOpInstruction){
+                UOP_GUARD_LOCAL, assumed_locals[i], i, 0, 0, head, 0};
+        }
+    }
+    for (int i = 0; i < entry_depth; i++) {
+        if (assumed_entry[i] != TYPE_UNKNOWN) {
+            *out++ = (_PyUOpInstruction){
+                UOP_GUARD_STACK, assumed_entry[i], entry_depth - i, 0, 0,
+                head, 0};
+        }
+    }
+    memcpy(out, trace->uops, trace->length * sizeof(_PyUOpInstruction));
+    out += trace->length;
+    assert(out == executor->trace + length);
+    /* Branches go to the first uop of their destination instruction */
+    for (int pc = preamble; pc < length; pc++) {
+        _PyUOpInstruction *uop = &executor->trace[pc];
+        if (is_branch(uop)) {
+            int dest = pc + 1;
+            while (executor->trace[dest].target < uop->exit) {
+                dest++;
+            }
+            assert(dest < length);
+            uop->exit = dest;
+        }
+    }
+    return executor;
+}
+
+static _PyExecutor *
+find_executor(PyCodeObject *code, int backedge)
+{
+    struct _PyExecutorArray *array = code->_co_executors;
+    if (array != NULL) {
+        for (int i = 0; i < array->size; i++) {
+            if (array->executors[i]->backedge == backedge) {
+                return array->executors[i];
+            }
+        }
+    }
+    return NULL;
+}
+
+static int
+add_executor(PyCodeObject *code, _PyExecutor *executor)
+{
+    struct _PyExecutorArray *array = code->_co_executors;
+    int size = array == NULL ? 0 : array->size;
+    array = PyMem_Realloc(array, offsetof(struct _PyExecutorArray, executors) +
+                                 (size + 1) * sizeof(_PyExecutor *));
+    if (array == NULL) {
+        return -1;
+    }
+    array->executors[size] = executor;
+    array->size = size + 1;
+    code->_co_executors = array;
+    return 0;
+}
+
+#ifdef _Py_JIT
+static void compile_executor(_PyExecutor *executor);
+#endif
+
+void
+_PyOptimizer_BackEdge(_PyInterpreterFrame *frame, _Py_CODEUNIT *backedge,
+                      int oparg, PyObject **stack_pointer)
+{
+    PyCodeObject *code = frame->f_code;
+    if (_Py_OPCODE(*backedge) != JUMP_BACKWARD_QUICK) {
+        /* Not quickened yet */
+        code->co_optimizer_warmup = OPTIMIZER_WARMUP;
+        return;
+    }
+    code->co_optimizer_warmup = OPTIMIZER_BACKOFF;
+    int offset = (int)(backedge - _PyCode_CODE(code));
+    if (find_executor(code, offset) != NULL) {
+        /* This loop has been optimized before and discarded */
+        return;
+    }
+    int head = offset + 1 - oparg;
+    int entry_depth = (int)(stack_pointer - _PyFrame_Stackbase(frame));
+    /* Too big for the C stack */
+    struct {
+        Trace trace;
+        Analysis analysis;
+    } *scratch = PyMem_Malloc(sizeof(*scratch));
+    if (scratch == NULL) {
+        return;
+    }
+    _PyExecutor *executor = NULL;
+    if (project_trace(code, head, offset, &scratch->trace) == 0) {
+        executor = optimize_trace(&scratch->trace, &scratch->analysis, code,
+                                  head, offset, entry_depth);
+    }
+    PyMem_Free(scratch);
+    if (executor == NULL) {
+        return;
+    }
+    if (add_executor(code, executor) < 0) {
+        PyMem_Free(executor);
+        return;
+    }
+#ifdef _Py_JIT
+    if (_PyInterpreterState_GetConfig(_PyInterpreterState_GET())->jit) {
+        compile_executor(executor);
+    }
+#endif
+    _Py_SET_OPCODE(*backedge, JUMP_BACKWARD_EXECUTOR);
+    code->co_optimizer_warmup = OPTIMIZER_WARMUP;
+}
+
+static void
+invalidate_executor(PyCodeObject *code, _PyExecutor *executor)
+{
+    /* Executors are never freed before their code object, since an
+     * outer activation of the same code may still be running one. */
+    executor->deopts_left = 0;
+    _Py_CODEUNIT *backedge = &_PyCode_CODE(code)[executor->backedge];
+    if (_Py_OPCODE(*backedge) == JUMP_BACKWARD_EXECUTOR) {
+        _Py_SET_OPCODE(*backedge, JUMP_BACKWARD_QUICK);
+    }
+}
+
+void
+_PyCode_InvalidateExecutors(PyCodeObject *code)
+{
+    struct _PyExecutorArray *array = code->_co_executors;
+    if (array != NULL) {
+        for (int i = 0; i < array->size; i++) {
+            invalidate_executor(code, array->executors[i]);
+        }
+    }
+}
+
+void
+_PyCode_ClearExecutors(PyCodeObject *code)
+{
+    struct _PyExecutorArray *array = code->_co_executors;
+    if (array != NULL) {
+        for (int i = 0; i < array->size; i++) {
+            _PyExecutor *executor = array->executors[i];
+#ifdef _Py_JIT
+            if (executor->jit_code != NULL) {
+                _PyJIT_Free((_PyJITCode)executor->jit_code,
+                            executor->jit_size);
+            }
+#endif
+            PyMem_Free(executor);
+        }
+        PyMem_Free(array);
+        code->_co_executors = NULL;
+    }
+}
+
+
+/* Execution */
+
+#define GETLOCAL(i)     (frame->localsplus[i])
+#define SETLOCAL(i, value)      do { PyObject *tmp = GETLOCAL(i); \
+                                     GETLOCAL(i) = value; \
+                                     Py_XDECREF(tmp); } while (0)
+#define TOP()             (stack_pointer[-1])
+#define PEEK(n)           (stack_pointer[-(n)])
+#define PUSH(v)           (*stack_pointer++ = (v))
+#define POP()             (*--stack_pointer)
+#define STACK_SHRINK(n)   (stack_pointer -= (n))
+
+/* The kinds of a uop's operands, or the type checked by a guard */
+#define UOP_TYPE(uop)     ((uop)->type)
+
+/* Operand taken from a local or constant */
+#define FOLDED(kind, i) \
+    ((kind) == OPERAND_LOCAL ? GETLOCAL(i) : consts[i])
+
+/* Fetch the operands of a binary uop, and the number of them on the stack */
+#define BINARY_OPERANDS() \
+    int nstack = (LEFT_OPERAND(uop) == OPERAND_STACK) + \
+                 (RIGHT_OPERAND(uop) == OPERAND_STACK); \
+    PyObject *right = RIGHT_OPERAND(uop) == OPERAND_STACK ? \
+        TOP() : FOLDED(RIGHT_OPERAND(uop), uop->right); \
+    PyObject *left = LEFT_OPERAND(uop) == OPERAND_STACK ? \
+        PEEK(nstack) : FOLDED(LEFT_OPERAND(uop), uop->left)
+
+/* Release the operands that came from the stack */
+#define DECREF_OPERANDS(dealloc) \
+    do { \
+        if (RIGHT_OPERAND(uop) == OPERAND_STACK) { \
+            _Py_DECREF_SPECIALIZED(right, dealloc); \
+        } \
+        if (LEFT_OPERAND(uop) == OPERAND_STACK) { \
+            _Py_DECREF_SPECIALIZED(left, dealloc); \
+        } \
+        STACK_SHRINK(nstack); \
+    } while (0)
+
+/* The instruction expects the operands that were folded on the stack */
+#define PUSH_FOLDED_OPERANDS() \
+    do { \
+        if (LEFT_OPERAND(uop) != OPERAND_STACK) { \
+            PyObject *left = FOLDED(LEFT_OPERAND(uop), uop->left); \
+            Py_INCREF(left); \
+            PUSH(left); \
+        } \
+        if (RIGHT_OPERAND(uop) != OPERAND_STACK) { \
+            PyObject *right = FOLDED(RIGHT_OPERAND(uop), uop->right); \
+            Py_INCREF(right); \
+            PUSH(right); \
+        } \
+    } while (0)
+
+/* Leave the trace if something made the frame visible to a tracer */
+#define CHECK_TRACING() \
+    if (tstate->cframe->use_tracing) { \
+        EXIT_TRACE(uop->exit); \
+    }
+
+static void
+count_deopt(PyCodeObject *code, _PyExecutor *executor)
+{
+    if (--executor->deopts_left <= 0) {
+        invalidate_executor(code, executor);
+    }
+}
+
+static void
+set_resume_point(_PyInterpreterFrame *frame, int offset,
+                 PyObject **stack_pointer)
+{
+    frame->prev_instr = _PyCode_CODE(frame->f_code) + offset - 1;
+    _PyFrame_SetStackPointer(frame, stack_pointer);
+}
+
+#ifdef _Py_JIT
+
+/* Compiled traces: each uop becomes a step of the machine code, calling the
+ * function implementing it.  The stack pointer is the value passed from step
+ * to step, the executor's other variables live in JITState. */
+
+typedef struct {
+    _PyInterpreterFrame *frame;
+    PyObject **consts;
+    PyThreadState *tstate;
+    _Py_atomic_int *eval_breaker;
+    _PyExecutor *executor;
+    int resume;             /* Offset to resume at when leaving the trace */
+} JITState;
+
+#define JIT_EXIT 2
+#define JIT_ERROR 3
+
+#define JIT_RESULT(STATUS) \
+    ((_PyJITResult){.value = stack_pointer, .status = (STATUS)})
+
+static _PyJITResult
+jit_deopt(JITState *state, _PyUOpInstruction *uop, PyObject **stack_pointer)
+{
+    count_deopt(state->frame->f_code, state->executor);
+    state->resume = uop->target;
+    return JIT_RESULT(JIT_EXIT);
+}
+
+#define frame (state->frame)
+#define consts (state->consts)
+#define tstate (state->tstate)
+#define eval_breaker (state->eval_breaker)
+
+/* What a uop does depends on its type, which is an argument of the
+ * implementations: each variant below is compiled for one of the values it
+ * can take, without the checks for the others. */
+#undef UOP_TYPE
+#undef LEFT_OPERAND
+#undef RIGHT_OPERAND
+#define UOP_TYPE(uop) type
+#define LEFT_OPERAND(uop) (type & 3)
+#define RIGHT_OPERAND(uop) (type >> 2)
+
+#define TARGET(op) \
+    static inline Py_ALWAYS_INLINE _PyJITResult \
+    jit_##op##_impl(JITState *state, _PyUOpInstruction *uop, \
+                    PyObject **stack_pointer, int type)
+#define TARGET_ALIAS(op)
+#define NEXT_UOP() return JIT_RESULT(_PyJIT_CONTINUE)
+/* The jump target is resolved by compile_executor() */
+#define JUMP_TO_UOP(index) return JIT_RESULT(_PyJIT_JUMP)
+#define EXIT_TRACE(offset) \
+    do { \
+        state->resume = (offset); \
+        return JIT_RESULT(JIT_EXIT); \
+    } while (0)
+#define DEOPT() return jit_deopt(state, uop, stack_pointer)
+#define DEOPT_OPERANDS() \
+    do { \
+        PUSH_FOLDED_OPERANDS(); \
+        return jit_deopt(state, uop, stack_pointer); \
+    } while (0)
+#define ERROR() \
+    do { \
+        state->resume = uop->target; \
+        return JIT_RESULT(JIT_ERROR); \
+    } while (0)
+
+#include "executor_cases.h"
+
+#undef JIT_RESULT
+#undef frame
+#undef consts
+#undef tstate
+#undef eval_breaker
+#undef TARGET
+#undef TARGET_ALIAS
+#undef NEXT_UOP
+#undef JUMP_TO_UOP
+#undef EXIT_TRACE
+#undef DEOPT
+#undef DEOPT_OPERANDS
+#undef ERROR
+#undef UOP_TYPE
+#undef LEFT_OPERAND
+#undef RIGHT_OPERAND
+#define UOP_TYPE(uop) ((uop)->type)
+#define LEFT_OPERAND(uop) ((uop)->type & 3)
+#define RIGHT_OPERAND(uop) ((uop)->type >> 2)
+
+/* The variants of each uop: V(op, name, type) */
+#define NO_VARIANTS(V, op) \
+    V(op, ANY, 0)
+#define RIGHT_OPERAND_VARIANTS(V, op) \
+    V(op, STACK_STACK, OPERANDS(OPERAND_STACK, OPERAND_STACK)) \
+    V(op, STACK_LOCAL, OPERANDS(OPERAND_STACK, OPERAND_LOCAL)) \
+    V(op, STACK_CONST, OPERANDS(OPERAND_STACK, OPERAND_CONST))
+#define OPERAND_VARIANTS(V, op) \
+    RIGHT_OPERAND_VARIANTS(V, op) \
+    V(op, LOCAL_STACK, OPERANDS(OPERAND_LOCAL, OPERAND_STACK)) \
+    V(op, LOCAL_LOCAL, OPERANDS(OPERAND_LOCAL, OPERAND_LOCAL)) \
+    V(op, LOCAL_CONST, OPERANDS(OPERAND_LOCAL, OPERAND_CONST)) \
+    V(op, CONST_STACK, OPERANDS(OPERAND_CONST, OPERAND_STACK)) \
+    V(op, CONST_LOCAL, OPERANDS(OPERAND_CONST, OPERAND_LOCAL)) \
+    V(op, CONST_CONST, OPERANDS(OPERAND_CONST, OPERAND_CONST))
+#define GUARD_VARIANTS(V, op) \
+    V(op, INT, TYPE_INT) \
+    V(op, COMPACT_INT, TYPE_COMPACT_INT) \
+    V(op, FLOAT, TYPE_FLOAT) \
+    V(op, LIST, TYPE_LIST) \
+    V(op, RANGE_ITER, TYPE_RANGE_ITER) \
+    V(op, LIST_ITER, TYPE_LIST_ITER)
+
+/* UOP_JUMP_FORWARD is a plain jump, and the COMPARE_*_JUMP uops share the
+ * functions of COMPARE_*_BRANCH */
+#define JIT_UOPS(X) \
+    X(UOP_LOAD_FAST, NO_VARIANTS) \
+    X(UOP_LOAD_CONST, NO_VARIANTS) \
+    X(UOP_STORE_FAST, RIGHT_OPERAND_VARIANTS) \
+    X(UOP_POP_TOP, NO_VARIANTS) \
+    X(UOP_GUARD_STACK, GUARD_VARIANTS) \
+    X(UOP_GUARD_LOCAL, GUARD_VARIANTS) \
+    X(UOP_ADD_INT, OPERAND_VARIANTS) \
+    X(UOP_SUBTRACT_INT, OPERAND_VARIANTS) \
+    X(UOP_MULTIPLY_INT, OPERAND_VARIANTS) \
+    X(UOP_ADD_FLOAT, OPERAND_VARIANTS) \
+    X(UOP_SUBTRACT_FLOAT, OPERAND_VARIANTS) \
+    X(UOP_MULTIPLY_FLOAT, OPERAND_VARIANTS) \
+    X(UOP_SUBSCR_LIST_INT, OPERAND_VARIANTS) \
+    X(UOP_COMPARE_INT_BRANCH, OPERAND_VARIANTS) \
+    X(UOP_COMPARE_FLOAT_BRANCH, OPERAND_VARIANTS) \
+    X(UOP_FOR_ITER_RANGE, NO_VARIANTS) \
+    X(UOP_FOR_ITER_LIST, NO_VARIANTS) \
+    X(UOP_JUMP_TO_BODY, NO_VARIANTS) \
+    X(UOP_POP_JUMP_TO_BODY, NO_VARIANTS)
+
+#define DEFINE_VARIANT(op, name, type) \
+    static _PyJITResult \
+    jit_##op##_##name(JITState *state, _PyUOpInstruction *uop, \
+                      PyObject **stack_pointer) \
+    { \
+        return jit_##op##_impl(state, uop, stack_pointer, (type)); \
+    }
+#define DEFINE_FUNCTIONS(op, VARIANTS) VARIANTS(DEFINE_VARIANT, op)
+
+JIT_UOPS(DEFINE_FUNCTIONS)
+
+#define VARIANT_ENTRY(op, name, type) \
+    [type] = (_PyJITFunction)jit_##op##_##name,
+#define FUNCTIONS_ENTRY(op, VARIANTS) [op] = { VARIANTS(VARIANT_ENTRY, op) },
+
+#define JIT_TYPES (OPERANDS(OPERAND_CONST, OPERAND_CONST) + 1)
+
+static const _PyJITFunction jit_functions[][JIT_TYPES] = {
+    JIT_UOPS(FUNCTIONS_ENTRY)
+    [UOP_COMPARE_INT_JUMP] = {
+        OPERAND_VARIANTS(VARIANT_ENTRY, UOP_COMPARE_INT_BRANCH)
+    },
+    [UOP_COMPARE_FLOAT_JUMP] = {
+        OPERAND_VARIANTS(VARIANT_ENTRY, UOP_COMPARE_FLOAT_BRANCH)
+    },
+};
+
+#undef NO_VARIANTS
+#undef RIGHT_OPERAND_VARIANTS
+#undef OPERAND_VARIANTS
+#undef GUARD_VARIANTS
+#undef JIT_UOPS
+#undef DEFINE_VARIANT
+#undef DEFINE_FUNCTIONS
+#undef VARIANT_ENTRY
+#undef FUNCTIONS_ENTRY
+
+static void
+compile_executor(_PyExecutor *executor)
+{
+    _PyJITStep *steps = PyMem_Malloc(executor->length * sizeof(_PyJITStep));
+    if (steps == NULL) {
+        return;
+    }
+    for (int i = 0; i < executor->length; i++) {
+        _PyUOpInstruction *uop = &executor->trace[i];
+        _PyJITStep *step = &steps[i];
+        step->function = NULL;
+        step->arg = uop;
+        switch (uop->opcode) {
+            case UOP_JUMP_FORWARD:
+                /* No need to call anything to jump */
+                step->jump = uop->exit;
+                break;
+            case UOP_COMPARE_INT_BRANCH:
+            case UOP_COMPARE_FLOAT_BRANCH:
+                step->jump = uop->exit;
+                break;
+            case UOP_JUMP_TO_BODY:
+            case UOP_POP_JUMP_TO_BODY:
+                step->jump = executor->body;
+                break;
+            default:
+                step->jump = -1;
+        }
+        if (uop->opcode != UOP_JUMP_FORWARD) {
+            assert(uop->type < JIT_TYPES);
+            step->function = jit_functions[uop->opcode][uop->type];
+            assert(step->function != NULL);
+        }
+    }
+    executor->jit_code = (void *)_PyJIT_Compile(steps, executor->length,
+                                                &executor->jit_size);
+    PyMem_Free(steps);
+}
+
+static int
+execute_compiled(_PyExecutor *executor, _PyInterpreterFrame *frame,
+                 PyObject **stack_pointer)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    JITState state = {
+        .frame = frame,
+        .consts = _PyTuple_ITEMS(frame->f_code->co_consts),
+        .tstate = tstate,
+        .eval_breaker = &tstate->interp->ceval.eval_breaker,
+        .executor = executor,
+    };
+    _PyJITResult result = ((_PyJITCode)executor->jit_code)(&state,
+                                                           stack_pointer);
+    stack_pointer = result.value;
+    if (result.status == JIT_ERROR) {
+        frame->prev_instr = _PyCode_CODE(frame->f_code) + state.resume;
+        _PyFrame_SetStackPointer(frame, stack_pointer);
+        return -1;
+    }
+    assert(result.status == JIT_EXIT);
+    set_resume_point(frame, state.resume, stack_pointer);
+    return 0;
+}
+
+#endif  /* _Py_JIT */
+
+/* Interpreted traces */
+
+#ifdef HAVE_COMPUTED_GOTOS
+    #ifndef USE_COMPUTED_GOTOS
+    #define USE_COMPUTED_GOTOS 1
+    #endif
+#else
+    #if defined(USE_COMPUTED_GOTOS) && USE_COMPUTED_GOTOS
+    #error "Computed gotos are not supported on this compiler."
+    #endif
+    #undef USE_COMPUTED_GOTOS
+    #define USE_COMPUTED_GOTOS 0
+#endif
+
+#if USE_COMPUTED_GOTOS
+#define TARGET(op) TARGET_##op:
+#define DISPATCH() goto *uop_targets[uop->opcode]
+#else
+#define TARGET(op) case op:
+#define DISPATCH() goto dispatch
+#endif
+#define TARGET_ALIAS(op) TARGET(op)
+
+#define NEXT_UOP() \
+    do { \
+        uop++; \
+        DISPATCH(); \
+    } while (0)
+#define JUMP_TO_UOP(index) \
+    do { \
+        uop = &executor->trace[index]; \
+        DISPATCH(); \
+    } while (0)
+#define EXIT_TRACE(offset) \
+    do { \
+        resume = (offset); \
+        goto exit; \
+    } while (0)
+#define DEOPT() goto deopt
+#define DEOPT_OPERANDS() goto deopt_operands
+#define ERROR() goto error
+
+int
+_PyExecutor_Execute(_PyExecutor *executor, _PyInterpreterFrame *frame,
+                    PyObject **stack_pointer)
+{
+#ifdef _Py_JIT
+    if (executor->jit_code != NULL) {
+        return execute_compiled(executor, frame, stack_pointer);
+    }
+#endif
+#if USE_COMPUTED_GOTOS
+    static void *uop_targets[] = {
+        [UOP_LOAD_FAST] = &&TARGET_UOP_LOAD_FAST,
+        [UOP_LOAD_CONST] = &&TARGET_UOP_LOAD_CONST,
+        [UOP_STORE_FAST] = &&TARGET_UOP_STORE_FAST,
+        [UOP_POP_TOP] = &&TARGET_UOP_POP_TOP,
+        [UOP_GUARD_STACK] = &&TARGET_UOP_GUARD_STACK,
+        [UOP_GUARD_LOCAL] = &&TARGET_UOP_GUARD_LOCAL,
+        [UOP_ADD_INT] = &&TARGET_UOP_ADD_INT,
+        [UOP_SUBTRACT_INT] = &&TARGET_UOP_SUBTRACT_INT,
+        [UOP_MULTIPLY_INT] = &&TARGET_UOP_MULTIPLY_INT,
+        [UOP_ADD_FLOAT] = &&TARGET_UOP_ADD_FLOAT,
+        [UOP_SUBTRACT_FLOAT] = &&TARGET_UOP_SUBTRACT_FLOAT,
+        [UOP_MULTIPLY_FLOAT] = &&TARGET_UOP_MULTIPLY_FLOAT,
+        [UOP_SUBSCR_LIST_INT] = &&TARGET_UOP_SUBSCR_LIST_INT,
+        [UOP_COMPARE_INT_JUMP] = &&TARGET_UOP_COMPARE_INT_JUMP,
+        [UOP_COMPARE_FLOAT_JUMP] = &&TARGET_UOP_COMPARE_FLOAT_JUMP,
+        [UOP_COMPARE_INT_BRANCH] = &&TARGET_UOP_COMPARE_INT_BRANCH,
+        [UOP_COMPARE_FLOAT_BRANCH] = &&TARGET_UOP_COMPARE_FLOAT_BRANCH,
+        [UOP_JUMP_FORWARD] = &&TARGET_UOP_JUMP_FORWARD,
+        [UOP_FOR_ITER_RANGE] = &&TARGET_UOP_FOR_ITER_RANGE,
+        [UOP_FOR_ITER_LIST] = &&TARGET_UOP_FOR_ITER_LIST,
+        [UOP_JUMP_TO_BODY] = &&TARGET_UOP_JUMP_TO_BODY,
+        [UOP_POP_JUMP_TO_BODY] = &&TARGET_UOP_POP_JUMP_TO_BODY,
+    };
+#endif
+    PyThreadState *tstate = _PyThreadState_GET();
+    _Py_atomic_int * const eval_breaker = &tstate->interp->ceval.eval_breaker;
+    PyObject **consts = _PyTuple_ITEMS(frame->f_code->co_consts);
+    _PyUOpInstruction *uop = executor->trace;
+    int resume;
+
+#if USE_COMPUTED_GOTOS
+    DISPATCH();
+#else
+dispatch:
+    switch (uop->opcode) {
+#endif
+
+#include "executor_cases.h"
+
+#if !USE_COMPUTED_GOTOS
+        default:
+            Py_UNREACHABLE();
+    }
+#endif
+    Py_UNREACHABLE();
+
+deopt_operands:
+    PUSH_FOLDED_OPERANDS();
+deopt:
+    count_deopt(frame->f_code, executor);
+    resume = uop->target;
+exit:
+    set_resume_point(frame, resume, stack_pointer);
+    return 0;
+error:
+    frame->prev_instr = _PyCode_CODE(frame->f_code) + uop->target;
+    _PyFrame_SetStackPointer(frame, stack_pointer);
+    return -1;
+}
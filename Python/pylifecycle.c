@@ -9,6 +9,7 @@
 #include "pycore_dict.h"          // _PyDict_Fini()
 #include "pycore_fileutils.h"     // _Py_ResetForceASCII()
 #include "pycore_floatobject.h"   // _PyFloat_InitTypes()
+#include "pycore_freelist.h"      // _PyObject_InitFreeLists()
 #include "pycore_genobject.h"     // _PyAsyncGen_Fini()
 #include "pycore_import.h"        // _PyImport_BootstrapImp()
 #include "pycore_initconfig.h"    // _PyStatus_OK()
@@ -610,7 +611,7 @@ pycore_init_runtime(_PyRuntimeState *runtime,
 
 
 static PyStatus
-init_interp_create_gil(PyThreadState *tstate)
+init_interp_create_gil(PyThreadState *tstate, int own_gil)
 {
     PyStatus status;
 
@@ -624,8 +625,9 @@ init_interp_create_gil(PyThreadState *tstate)
         return status;
     }
 
-    /* Create the GIL and take it */
-    status = _PyEval_InitGIL(tstate);
+    /* Create the GIL, or share the one of the main interpreter, and take
+       it */
+    status = _PyEval_InitGIL(tstate, own_gil);
     if (_PyStatus_EXCEPTION(status)) {
         return status;
     }
@@ -662,7 +664,7 @@ pycore_create_interpreter(_PyRuntimeState *runtime,
     }
     (void) PyThreadState_Swap(tstate);
 
-    status = init_interp_create_gil(tstate);
+    status = init_interp_create_gil(tstate, 1);
     if (_PyStatus_EXCEPTION(status)) {
         return status;
     }
@@ -822,6 +824,11 @@ pycore_interp_init(PyThreadState *tstate)
     PyStatus status;
     PyObject *sysmod = NULL;
 
+    status = _PyObject_InitFreeLists(interp);
+    if (_PyStatus_EXCEPTION(status)) {
+        return status;
+    }
+
     // Create singletons before the first PyType_Ready() call, since
     // PyType_Ready() uses singletons like the Unicode empty string (tp_doc)
     // and the empty tuple singletons (tp_bases).
@@ -1695,6 +1702,11 @@ finalize_interp_clear(PyThreadState *tstate)
 {
     int is_main_interp = _Py_IsMainInterpreter(tstate->interp);
 
+    if (is_main_interp) {
+        /* The shared objects can be deallocated again */
+        _PyRuntimeState_DisableOwnGILs(tstate->interp->runtime);
+    }
+
     _PyExc_ClearExceptionGroupType(tstate->interp);
 
     /* Clear interpreter state and all thread states */
@@ -1998,7 +2010,14 @@ new_interpreter(PyThreadState **tstate_p, int isolated_subinterpreter)
     }
     interp->config._isolated_interpreter = isolated_subinterpreter;
 
-    status = init_interp_create_gil(tstate);
+    /* An isolated subinterpreter cannot create threads nor fork: it runs
+       under its own GIL, in parallel with the other interpreters. */
+#ifdef HAVE_THREAD_LOCAL
+    int own_gil = isolated_subinterpreter;
+#else
+    int own_gil = 0;
+#endif
+    status = init_interp_create_gil(tstate, own_gil);
     if (_PyStatus_EXCEPTION(status)) {
         goto error;
     }
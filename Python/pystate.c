@@ -37,11 +37,22 @@ to avoid the expense of doing their own locking).
 extern "C" {
 #endif
 
+#ifdef HAVE_THREAD_LOCAL
+/* The current thread state of each thread: with a GIL per interpreter,
+   several threads can run Python code at once. */
+_Py_thread_local PyThreadState *_Py_tss_tstate = NULL;
+
+#define _PyRuntimeGILState_GetThreadState(gilstate) \
+    ((void)(gilstate), _Py_tss_tstate)
+#define _PyRuntimeGILState_SetThreadState(gilstate, value) \
+    ((void)(gilstate), _Py_tss_tstate = (value))
+#else
 #define _PyRuntimeGILState_GetThreadState(gilstate) \
     ((PyThreadState*)_Py_atomic_load_relaxed(&(gilstate)->tstate_current))
 #define _PyRuntimeGILState_SetThreadState(gilstate, value) \
     _Py_atomic_store_relaxed(&(gilstate)->tstate_current, \
                              (uintptr_t)(value))
+#endif
 
 /* Forward declarations */
 static PyThreadState *_PyGILState_GetThisThreadState(struct _gilstate_runtime_state *gilstate);
@@ -111,8 +122,6 @@ init_runtime(_PyRuntimeState *runtime,
     runtime->open_code_userdata = open_code_userdata;
     runtime->audit_hook_head = audit_hook_head;
 
-    _PyEval_InitRuntimeState(&runtime->ceval);
-
     PyPreConfig_InitPythonConfig(&runtime->preconfig);
 
     runtime->interpreters.mutex = interpreters_mutex;
@@ -172,11 +181,60 @@ _PyRuntimeState_Fini(_PyRuntimeState *runtime)
     FREE_LOCK(runtime->interpreters.mutex);
     FREE_LOCK(runtime->xidregistry.mutex);
     FREE_LOCK(runtime->unicode_ids.lock);
+    runtime->ceval.own_gils = 0;
+    FREE_LOCK(runtime->shared_locks.obmalloc);
+    FREE_LOCK(runtime->shared_locks.objects);
 
 #undef FREE_LOCK
     PyMem_SetAllocator(PYMEM_DOMAIN_RAW, &old_alloc);
 }
 
+PyStatus
+_PyRuntimeState_EnableOwnGILs(_PyRuntimeState *runtime)
+{
+    assert(!runtime->ceval.own_gils);
+
+    /* The locks are kept until _PyRuntimeState_Fini() */
+    if (runtime->shared_locks.obmalloc == NULL) {
+        /* Force default allocator, since _PyRuntimeState_Fini() must
+           use the same allocator than this function. */
+        PyMemAllocatorEx old_alloc;
+        _PyMem_SetDefaultAllocator(PYMEM_DOMAIN_RAW, &old_alloc);
+
+        PyThread_type_lock obmalloc_lock = PyThread_allocate_lock();
+        PyThread_type_lock objects_lock = PyThread_allocate_lock();
+        if (obmalloc_lock == NULL || objects_lock == NULL) {
+            if (obmalloc_lock != NULL) {
+                PyThread_free_lock(obmalloc_lock);
+            }
+            if (objects_lock != NULL) {
+                PyThread_free_lock(objects_lock);
+            }
+            PyMem_SetAllocator(PYMEM_DOMAIN_RAW, &old_alloc);
+            return _PyStatus_NO_MEMORY();
+        }
+
+        PyMem_SetAllocator(PYMEM_DOMAIN_RAW, &old_alloc);
+        runtime->shared_locks.obmalloc = obmalloc_lock;
+        runtime->shared_locks.objects = objects_lock;
+    }
+
+    /* No other interpreter runs in parallel yet */
+    _PyObject_SetSharedObjectsPinned(1);
+    runtime->ceval.own_gils = 1;
+    return _PyStatus_OK();
+}
+
+void
+_PyRuntimeState_DisableOwnGILs(_PyRuntimeState *runtime)
+{
+    if (!runtime->ceval.own_gils) {
+        return;
+    }
+    runtime->ceval.own_gils = 0;
+    _PyObject_SetSharedObjectsPinned(0);
+}
+
 #ifdef HAVE_FORK
 /* This function is called from PyOS_AfterFork_Child to ensure that
    newly created child processes do not share locks with the parent. */
@@ -194,6 +252,14 @@ _PyRuntimeState_ReInitThreads(_PyRuntimeState *runtime)
     int reinit_interp = _PyThread_at_fork_reinit(&runtime->interpreters.mutex);
     int reinit_xidregistry = _PyThread_at_fork_reinit(&runtime->xidregistry.mutex);
     int reinit_unicode_ids = _PyThread_at_fork_reinit(&runtime->unicode_ids.lock);
+    int reinit_shared = 0;
+    if (runtime->shared_locks.obmalloc != NULL) {
+        if (_PyThread_at_fork_reinit(&runtime->shared_locks.obmalloc) < 0
+            || _PyThread_at_fork_reinit(&runtime->shared_locks.objects) < 0)
+        {
+            reinit_shared = -1;
+        }
+    }
 
     PyMem_SetAllocator(PYMEM_DOMAIN_RAW, &old_alloc);
 
@@ -204,7 +270,8 @@ _PyRuntimeState_ReInitThreads(_PyRuntimeState *runtime)
     if (reinit_interp < 0
         || reinit_main_id < 0
         || reinit_xidregistry < 0
-        || reinit_unicode_ids < 0)
+        || reinit_unicode_ids < 0
+        || reinit_shared < 0)
     {
         return _PyStatus_ERR("Failed to reinitialize runtime locks");
 
@@ -257,6 +324,7 @@ alloc_interpreter(void)
 static void
 free_interpreter(PyInterpreterState *interp)
 {
+    _PyMem_ClearCache(&interp->obmalloc);
     if (!interp->_static) {
         PyMem_RawFree(interp);
     }
@@ -290,8 +358,9 @@ init_interpreter(PyInterpreterState *interp,
     assert(next != NULL || (interp == runtime->interpreters.main));
     interp->next = next;
 
-    _PyEval_InitState(&interp->ceval, pending_lock);
+    _PyEval_InitState(interp, pending_lock);
     _PyGC_InitState(&interp->gc);
+    _PyMem_InitCache(&interp->obmalloc);
     PyConfig_InitPythonConfig(&interp->config);
     _PyType_InitCache(interp);
 
@@ -481,6 +550,11 @@ PyInterpreterState_Delete(PyInterpreterState *interp)
     zapthreads(interp, 0);
 
     _PyEval_FiniState(&interp->ceval);
+    if (interp != interpreters->main) {
+        /* The GIL of the main interpreter is destroyed by
+           init_interp_create_gil(), see finalize_interp_delete() */
+        _PyEval_FiniGIL(interp);
+    }
 
     /* Delete current thread. After this, many C API calls become crashy. */
     _PyThreadState_Swap(&runtime->gilstate, NULL);
@@ -1186,6 +1260,10 @@ _PyThreadState_Swap(struct _gilstate_runtime_state *gilstate, PyThreadState *new
 {
     PyThreadState *oldts = _PyRuntimeGILState_GetThreadState(gilstate);
 
+    if (newts != NULL) {
+        /* newts can belong to an interpreter which has another GIL */
+        _PyEval_SwitchGIL(oldts, newts);
+    }
     _PyRuntimeGILState_SetThreadState(gilstate, newts);
     /* It should not be possible for more than one thread state
        to be used for a thread.  Check this the best we can in debug
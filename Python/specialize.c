@@ -1,5 +1,6 @@
 #include "Python.h"
 #include "pycore_code.h"
+#include "pycore_descrobject.h"   // _PyPropertyObject
 #include "pycore_dict.h"
 #include "pycore_function.h"      // _PyFunction_GetVersionForCurrentState()
 #include "pycore_global_strings.h"  // _Py_ID()
@@ -7,6 +8,7 @@
 #include "pycore_moduleobject.h"
 #include "pycore_object.h"
 #include "pycore_opcode.h"        // _PyOpcode_Caches
+#include "pycore_typeobject.h"    // _Py_slot_tp_getattro()
 #include "structmember.h"         // struct PyMemberDef, T_OFFSET_EX
 
 #include <stdlib.h> // rand()
@@ -28,6 +30,9 @@ uint8_t _PyOpcode_Adaptive[256] = {
     [BINARY_OP] = BINARY_OP_ADAPTIVE,
     [COMPARE_OP] = COMPARE_OP_ADAPTIVE,
     [UNPACK_SEQUENCE] = UNPACK_SEQUENCE_ADAPTIVE,
+    [FOR_ITER] = FOR_ITER_ADAPTIVE,
+    [SEND] = SEND_ADAPTIVE,
+    [CONTAINS_OP] = CONTAINS_OP_ADAPTIVE,
 };
 
 Py_ssize_t _Py_QuickenedCount = 0;
@@ -120,6 +125,9 @@ _Py_GetSpecializationStats(void) {
     err += add_stat_dict(stats, BINARY_OP, "binary_op");
     err += add_stat_dict(stats, COMPARE_OP, "compare_op");
     err += add_stat_dict(stats, UNPACK_SEQUENCE, "unpack_sequence");
+    err += add_stat_dict(stats, FOR_ITER, "for_iter");
+    err += add_stat_dict(stats, SEND, "send");
+    err += add_stat_dict(stats, CONTAINS_OP, "contains_op");
     if (err < 0) {
         Py_DECREF(stats);
         return NULL;
@@ -137,9 +145,6 @@ _Py_GetSpecializationStats(void) {
 static void
 print_spec_stats(FILE *out, OpcodeStats *stats)
 {
-    /* Mark some opcodes as specializable for stats,
-     * even though we don't specialize them yet. */
-    fprintf(out, "opcode[%d].specializable : 1\n", FOR_ITER);
     for (int i = 0; i < 256; i++) {
         if (_PyOpcode_Adaptive[i]) {
             fprintf(out, "opcode[%d].specializable : 1\n", i);
@@ -286,34 +291,14 @@ _PyCode_Quicken(PyCodeObject *code)
                 case RESUME:
                     _Py_SET_OPCODE(instructions[i], RESUME_QUICK);
                     break;
-                case LOAD_FAST:
-                    switch(previous_opcode) {
-                        case LOAD_FAST:
-                            _Py_SET_OPCODE(instructions[i - 1],
-                                           LOAD_FAST__LOAD_FAST);
-                            break;
-                        case STORE_FAST:
-                            _Py_SET_OPCODE(instructions[i - 1],
-                                           STORE_FAST__LOAD_FAST);
-                            break;
-                        case LOAD_CONST:
-                            _Py_SET_OPCODE(instructions[i - 1],
-                                           LOAD_CONST__LOAD_FAST);
-                            break;
-                    }
-                    break;
-                case STORE_FAST:
-                    if (previous_opcode == STORE_FAST) {
-                        _Py_SET_OPCODE(instructions[i - 1],
-                                       STORE_FAST__STORE_FAST);
-                    }
-                    break;
-                case LOAD_CONST:
-                    if (previous_opcode == LOAD_FAST) {
-                        _Py_SET_OPCODE(instructions[i - 1],
-                                       LOAD_FAST__LOAD_CONST);
+                default: {
+                    int super = _PyOpcode_Superinstruction(previous_opcode,
+                                                           opcode);
+                    if (super) {
+                        _Py_SET_OPCODE(instructions[i - 1], super);
                     }
                     break;
+                }
             }
             previous_opcode = opcode;
         }
@@ -359,6 +344,12 @@ miss_counter_start(void) {
 #define SPEC_FAIL_ATTR_NOT_MANAGED_DICT 17
 #define SPEC_FAIL_ATTR_NON_STRING_OR_SPLIT 18
 #define SPEC_FAIL_ATTR_MODULE_ATTR_NOT_FOUND 19
+#define SPEC_FAIL_ATTR_GETTER_NOT_PY_FUNCTION 20
+#define SPEC_FAIL_ATTR_GETTER_COMPLEX_PARAMETERS 21
+#define SPEC_FAIL_ATTR_GETATTR_HOOK 22
+#define SPEC_FAIL_ATTR_CLASS_ATTR_DESCRIPTOR 23
+#define SPEC_FAIL_ATTR_METACLASS_DESCRIPTOR 24
+#define SPEC_FAIL_ATTR_METACLASS_OVERRIDDEN 25
 
 /* Methods */
 
@@ -421,6 +412,9 @@ miss_counter_start(void) {
 #define SPEC_FAIL_BINARY_OP_TRUE_DIVIDE_FLOAT           25
 #define SPEC_FAIL_BINARY_OP_TRUE_DIVIDE_OTHER           26
 #define SPEC_FAIL_BINARY_OP_XOR                         27
+#define SPEC_FAIL_BINARY_OP_BIG_INT                     28
+#define SPEC_FAIL_BINARY_OP_ZERO_DIVISOR                29
+#define SPEC_FAIL_BINARY_OP_SHIFT_COUNT                 30
 
 /* Calls */
 #define SPEC_FAIL_CALL_COMPLEX_PARAMETERS 9
@@ -446,6 +440,8 @@ miss_counter_start(void) {
 #define SPEC_FAIL_CALL_OPERATOR_WRAPPER 27
 #define SPEC_FAIL_CALL_PYFUNCTION 28
 #define SPEC_FAIL_CALL_PEP_523 29
+#define SPEC_FAIL_CALL_METACLASS 30
+#define SPEC_FAIL_CALL_INIT_NOT_PYTHON 31
 
 /* COMPARE_OP */
 #define SPEC_FAIL_COMPARE_OP_DIFFERENT_TYPES 12
@@ -484,6 +480,16 @@ miss_counter_start(void) {
 #define SPEC_FAIL_FOR_ITER_CALLABLE 28
 #define SPEC_FAIL_FOR_ITER_ASCII_STRING 29
 
+/* CONTAINS_OP */
+#define SPEC_FAIL_CONTAINS_OP_STR_NON_STR 8
+#define SPEC_FAIL_CONTAINS_OP_BIG_TUPLE 9
+#define SPEC_FAIL_CONTAINS_OP_LIST 10
+#define SPEC_FAIL_CONTAINS_OP_BYTES 11
+#define SPEC_FAIL_CONTAINS_OP_RANGE 12
+#define SPEC_FAIL_CONTAINS_OP_DICT_VIEW 13
+#define SPEC_FAIL_CONTAINS_OP_SUBCLASS 14
+#define SPEC_FAIL_CONTAINS_OP_PYTHON_CLASS 15
+
 // UNPACK_SEQUENCE
 
 #define SPEC_FAIL_UNPACK_SEQUENCE_ITERATOR 8
@@ -533,6 +539,20 @@ specialize_module_load_attr(PyObject *owner, _Py_CODEUNIT *instr,
 
 
 
+#define SIMPLE_FUNCTION 0
+
+static int
+function_kind(PyCodeObject *code) {
+    int flags = code->co_flags;
+    if ((flags & (CO_VARKEYWORDS | CO_VARARGS)) || code->co_kwonlyargcount) {
+        return SPEC_FAIL_CALL_COMPLEX_PARAMETERS;
+    }
+    if ((flags & CO_OPTIMIZED) == 0) {
+        return SPEC_FAIL_CALL_CO_NOT_OPTIMIZED;
+    }
+    return SIMPLE_FUNCTION;
+}
+
 /* Attribute specialization */
 
 typedef enum {
@@ -660,6 +680,172 @@ specialize_dict_access(
     return 1;
 }
 
+/* Record a Python function that LOAD_ATTR will call by pushing its frame
+ * directly, passing exactly `argcount` positional arguments. */
+static int
+specialize_py_getter(_PyLoadMethodCache *cache, PyObject *func, int argcount)
+{
+    if (!Py_IS_TYPE(func, &PyFunction_Type)) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_GETTER_NOT_PY_FUNCTION);
+        return -1;
+    }
+    PyCodeObject *code = (PyCodeObject *)((PyFunctionObject *)func)->func_code;
+    if (function_kind(code) != SIMPLE_FUNCTION ||
+        code->co_argcount != argcount)
+    {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_GETTER_COMPLEX_PARAMETERS);
+        return -1;
+    }
+    /* Don't specialize if PEP 523 is active */
+    if (_PyInterpreterState_GET()->eval_frame) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OTHER);
+        return -1;
+    }
+    uint32_t version =
+        _PyFunction_GetVersionForCurrentState((PyFunctionObject *)func);
+    if (version == 0) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    /* `func` is borrowed: the type (whose version is checked first) keeps
+     * it alive, and the function version catches changes to __code__. */
+    write_u32(cache->keys_version, version);
+    write_obj(cache->descr, func);
+    return 0;
+}
+
+/* A property with a Python getter. `type` is the type whose dictionary
+ * holds the property: Py_TYPE(owner), or the metaclass for class owners. */
+static int
+specialize_property_load(PyTypeObject *type, PyObject *descr,
+                         _Py_CODEUNIT *instr)
+{
+    _PyLoadMethodCache *cache = (_PyLoadMethodCache *)(instr + 1);
+    assert(Py_IS_TYPE(descr, &PyProperty_Type));
+    PyObject *fget = ((_PyPropertyObject *)descr)->prop_get;
+    if (fget == NULL) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_EXPECTED_ERROR);
+        return -1;
+    }
+    if (type->tp_version_tag == 0) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    if (specialize_py_getter(cache, fget, 1)) {
+        return -1;
+    }
+    write_u32(cache->type_version, type->tp_version_tag);
+    _Py_SET_OPCODE(*instr, LOAD_ATTR_PROPERTY);
+    return 0;
+}
+
+/* A class that overrides __getattribute__ in Python, without __getattr__. */
+static int
+specialize_getattribute_load(PyTypeObject *type, _Py_CODEUNIT *instr)
+{
+    _PyLoadMethodCache *cache = (_PyLoadMethodCache *)(instr + 1);
+    if (type->tp_getattro != _Py_slot_tp_getattro &&
+        type->tp_getattro != _Py_slot_tp_getattr_hook)
+    {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OVERRIDDEN);
+        return -1;
+    }
+    if (_PyType_Lookup(type, &_Py_ID(__getattr__)) != NULL) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_GETATTR_HOOK);
+        return -1;
+    }
+    PyObject *getattribute = _PyType_Lookup(type,
+                                            &_Py_ID(__getattribute__));
+    if (getattribute == NULL) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OTHER);
+        return -1;
+    }
+    if (type->tp_version_tag == 0) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    if (specialize_py_getter(cache, getattribute, 2)) {
+        return -1;
+    }
+    write_u32(cache->type_version, type->tp_version_tag);
+    _Py_SET_OPCODE(*instr, LOAD_ATTR_GETATTRIBUTE_OVERRIDDEN);
+    return 0;
+}
+
+/* Attribute loads on class objects, following type_getattro(): data
+ * descriptors on the metaclass win, then the class's own MRO, then
+ * anything else found on the metaclass.
+ *
+ * LOAD_ATTR_CLASS handles classes whose metaclass is exactly `type`, which
+ * cannot change, so the class version alone guards the lookup.
+ * LOAD_ATTR_METACLASS handles custom metaclasses and also checks the
+ * metaclass version. */
+static int
+specialize_class_load_attr(PyObject *owner, _Py_CODEUNIT *instr,
+                           PyObject *name)
+{
+    _PyLoadMethodCache *cache = (_PyLoadMethodCache *)(instr + 1);
+    PyTypeObject *cls = (PyTypeObject *)owner;
+    PyTypeObject *metaclass = Py_TYPE(owner);
+    if (metaclass->tp_getattro != PyType_Type.tp_getattro) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_METACLASS_OVERRIDDEN);
+        return -1;
+    }
+    PyObject *meta_attr = _PyType_Lookup(metaclass, name);
+    if (meta_attr != NULL && Py_TYPE(meta_attr)->tp_descr_set != NULL) {
+        if (Py_IS_TYPE(meta_attr, &PyProperty_Type)) {
+            return specialize_property_load(metaclass, meta_attr, instr);
+        }
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_METACLASS_DESCRIPTOR);
+        return -1;
+    }
+    PyObject *descr = _PyType_Lookup(cls, name);
+    int opcode;
+    if (descr != NULL) {
+        PyTypeObject *desc_cls = Py_TYPE(descr);
+        if (!(desc_cls->tp_flags & Py_TPFLAGS_IMMUTABLETYPE)) {
+            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_MUTABLE_CLASS);
+            return -1;
+        }
+        /* Functions and method descriptors return themselves when
+         * looked up on a class. */
+        if (desc_cls->tp_descr_get != NULL &&
+            !(desc_cls->tp_flags & Py_TPFLAGS_METHOD_DESCRIPTOR))
+        {
+            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_CLASS_ATTR_DESCRIPTOR);
+            return -1;
+        }
+        opcode = metaclass == &PyType_Type ? LOAD_ATTR_CLASS
+                                           : LOAD_ATTR_METACLASS;
+    }
+    else if (meta_attr != NULL) {
+        PyTypeObject *desc_cls = Py_TYPE(meta_attr);
+        if (!(desc_cls->tp_flags & Py_TPFLAGS_IMMUTABLETYPE)) {
+            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_MUTABLE_CLASS);
+            return -1;
+        }
+        if (desc_cls->tp_descr_get != NULL) {
+            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_METACLASS_DESCRIPTOR);
+            return -1;
+        }
+        descr = meta_attr;
+        opcode = LOAD_ATTR_METACLASS;
+    }
+    else {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_EXPECTED_ERROR);
+        return -1;
+    }
+    if (cls->tp_version_tag == 0 || metaclass->tp_version_tag == 0) {
+        SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    write_u32(cache->type_version, cls->tp_version_tag);
+    write_u32(cache->keys_version, metaclass->tp_version_tag);
+    write_obj(cache->descr, descr);
+    _Py_SET_OPCODE(*instr, opcode);
+    return 0;
+}
+
 int
 _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
 {
@@ -679,6 +865,12 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
             return -1;
         }
     }
+    if (PyType_Check(owner)) {
+        if (specialize_class_load_attr(owner, instr, name)) {
+            goto fail;
+        }
+        goto success;
+    }
     PyObject *descr;
     DescriptorClassification kind = analyze_descriptor(type, name, &descr, 0);
     switch(kind) {
@@ -689,8 +881,10 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_METHOD);
             goto fail;
         case PROPERTY:
-            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_PROPERTY);
-            goto fail;
+            if (specialize_property_load(type, descr, instr)) {
+                goto fail;
+            }
+            goto success;
         case OBJECT_SLOT:
         {
             PyMemberDescrObject *member = (PyMemberDescrObject *)descr;
@@ -727,8 +921,10 @@ _Py_Specialize_LoadAttr(PyObject *owner, _Py_CODEUNIT *instr, PyObject *name)
             SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_ATTR_MUTABLE_CLASS);
             goto fail;
         case GETSET_OVERRIDDEN:
-            SPECIALIZATION_FAIL(LOAD_ATTR, SPEC_FAIL_OVERRIDDEN);
-            goto fail;
+            if (specialize_getattribute_load(type, instr)) {
+                goto fail;
+            }
+            goto success;
         case BUILTIN_CLASSMETHOD:
         case PYTHON_CLASSMETHOD:
         case NON_OVERRIDING:
@@ -1176,20 +1372,6 @@ binary_subscr_fail_kind(PyTypeObject *container_type, PyObject *sub)
 #endif
 
 
-#define SIMPLE_FUNCTION 0
-
-static int
-function_kind(PyCodeObject *code) {
-    int flags = code->co_flags;
-    if ((flags & (CO_VARKEYWORDS | CO_VARARGS)) || code->co_kwonlyargcount) {
-        return SPEC_FAIL_CALL_COMPLEX_PARAMETERS;
-    }
-    if ((flags & CO_OPTIMIZED) == 0) {
-        return SPEC_FAIL_CALL_CO_NOT_OPTIMIZED;
-    }
-    return SIMPLE_FUNCTION;
-}
-
 int
 _Py_Specialize_BinarySubscr(
      PyObject *container, PyObject *sub, _Py_CODEUNIT *instr)
@@ -1368,6 +1550,74 @@ _Py_Specialize_StoreSubscr(PyObject *container, PyObject *sub, _Py_CODEUNIT *ins
     return 0;
 }
 
+/* Instances of Python classes that use object.__new__ and a Python
+ * __init__ are allocated inline, and the __init__ frame is pushed directly.
+ * The cache holds the class version in func_version and the (16 bit)
+ * version of __init__ in min_args; __init__ itself is kept in the
+ * class's _spec_cache. */
+static int
+specialize_class_init(PyTypeObject *tp, _Py_CODEUNIT *instr, int nargs,
+                      PyObject *kwnames)
+{
+    _PyCallCache *cache = (_PyCallCache *)(instr + 1);
+    if (!(tp->tp_flags & Py_TPFLAGS_HEAPTYPE) ||
+        tp->tp_alloc != PyType_GenericAlloc ||
+        (tp->tp_flags & Py_TPFLAGS_IS_ABSTRACT))
+    {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_PYTHON_CLASS);
+        return -1;
+    }
+    /* A custom metaclass may override __call__ */
+    if (!Py_IS_TYPE(tp, &PyType_Type)) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_METACLASS);
+        return -1;
+    }
+    if (kwnames) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_KWNAMES);
+        return -1;
+    }
+    if (_Py_OPARG(*instr) != nargs) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_BOUND_METHOD);
+        return -1;
+    }
+    /* Don't specialize if PEP 523 is active */
+    if (_PyInterpreterState_GET()->eval_frame) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_PEP_523);
+        return -1;
+    }
+    PyObject *init = _PyType_Lookup(tp, &_Py_ID(__init__));
+    if (init == NULL || !Py_IS_TYPE(init, &PyFunction_Type)) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_INIT_NOT_PYTHON);
+        return -1;
+    }
+    PyCodeObject *code = (PyCodeObject *)((PyFunctionObject *)init)->func_code;
+    int kind = function_kind(code);
+    if (kind != SIMPLE_FUNCTION) {
+        SPECIALIZATION_FAIL(CALL, kind);
+        return -1;
+    }
+    if (code->co_flags & (CO_GENERATOR | CO_COROUTINE | CO_ASYNC_GENERATOR)) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_INIT_NOT_PYTHON);
+        return -1;
+    }
+    if (code->co_argcount != nargs + 1) {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_WRONG_NUMBER_ARGUMENTS);
+        return -1;
+    }
+    int version = _PyFunction_GetVersionForCurrentState((PyFunctionObject *)init);
+    if (version == 0 || version != (uint16_t)version ||
+        tp->tp_version_tag == 0)
+    {
+        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_OUT_OF_VERSIONS);
+        return -1;
+    }
+    write_u32(cache->func_version, tp->tp_version_tag);
+    cache->min_args = version;
+    ((PyHeapTypeObject *)tp)->_spec_cache.init = init;
+    _Py_SET_OPCODE(*instr, CALL_ALLOC_AND_ENTER_INIT);
+    return 0;
+}
+
 static int
 specialize_class_call(PyObject *callable, _Py_CODEUNIT *instr, int nargs,
                       PyObject *kwnames)
@@ -1375,8 +1625,7 @@ specialize_class_call(PyObject *callable, _Py_CODEUNIT *instr, int nargs,
     assert(_Py_OPCODE(*instr) == CALL_ADAPTIVE);
     PyTypeObject *tp = _PyType_CAST(callable);
     if (tp->tp_new == PyBaseObject_Type.tp_new) {
-        SPECIALIZATION_FAIL(CALL, SPEC_FAIL_CALL_PYTHON_CLASS);
-        return -1;
+        return specialize_class_init(tp, instr, nargs, kwnames);
     }
     if (tp->tp_flags & Py_TPFLAGS_IMMUTABLETYPE) {
         int oparg = _Py_OPARG(*instr);
@@ -1686,7 +1935,79 @@ _Py_Specialize_Call(PyObject *callable, _Py_CODEUNIT *instr, int nargs,
     return 0;
 }
 
+static int
+is_compact_int(PyObject *o)
+{
+    return PyLong_CheckExact(o) && _PyLong_IsCompact((PyLongObject *)o);
+}
+
+/* A float and a compact int, in either order */
+static int
+is_mixed_int_float(PyObject *lhs, PyObject *rhs)
+{
+    return (PyFloat_CheckExact(lhs) && is_compact_int(rhs)) ||
+           (is_compact_int(lhs) && PyFloat_CheckExact(rhs));
+}
+
+/* The specialized form of a bitwise, shift, floor division or modulo
+ * operation on compact ints, or 0 if the right operand is a shift count
+ * or divisor that it does not handle. */
+static int
+compact_int_binary_op(int oparg, PyObject *rhs)
+{
+    Py_ssize_t value = _PyLong_CompactValue((PyLongObject *)rhs);
+    switch (oparg) {
+        case NB_AND:
+        case NB_INPLACE_AND:
+            return BINARY_OP_AND_INT;
+        case NB_OR:
+        case NB_INPLACE_OR:
+            return BINARY_OP_OR_INT;
+        case NB_XOR:
+        case NB_INPLACE_XOR:
+            return BINARY_OP_XOR_INT;
+        case NB_LSHIFT:
+        case NB_INPLACE_LSHIFT:
+            if (value < 0 || value > _PyLong_MAX_COMPACT_LSHIFT) {
+                return 0;
+            }
+            return BINARY_OP_LSHIFT_INT;
+        case NB_RSHIFT:
+        case NB_INPLACE_RSHIFT:
+            return value < 0 ? 0 : BINARY_OP_RSHIFT_INT;
+        case NB_FLOOR_DIVIDE:
+        case NB_INPLACE_FLOOR_DIVIDE:
+            return value == 0 ? 0 : BINARY_OP_FLOOR_DIVIDE_INT;
+        case NB_REMAINDER:
+        case NB_INPLACE_REMAINDER:
+            return value == 0 ? 0 : BINARY_OP_REMAINDER_INT;
+    }
+    Py_UNREACHABLE();
+}
+
 #ifdef Py_STATS
+/* Why an int/float mix was not specialized */
+static int
+binary_op_mixed_fail_kind(PyObject *lhs, PyObject *rhs, int other)
+{
+    if ((PyFloat_CheckExact(lhs) && PyLong_CheckExact(rhs)) ||
+        (PyLong_CheckExact(lhs) && PyFloat_CheckExact(rhs)))
+    {
+        return SPEC_FAIL_BINARY_OP_BIG_INT;
+    }
+    return other;
+}
+
+/* Why an operation on ints was not specialized */
+static int
+binary_op_int_fail_kind(PyObject *lhs, PyObject *rhs, int other)
+{
+    if (!PyLong_CheckExact(lhs) || !PyLong_CheckExact(rhs)) {
+        return other;
+    }
+    return SPEC_FAIL_BINARY_OP_BIG_INT;
+}
+
 static int
 binary_op_fail_kind(int oparg, PyObject *lhs, PyObject *rhs)
 {
@@ -1694,7 +2015,8 @@ binary_op_fail_kind(int oparg, PyObject *lhs, PyObject *rhs)
         case NB_ADD:
         case NB_INPLACE_ADD:
             if (!Py_IS_TYPE(lhs, Py_TYPE(rhs))) {
-                return SPEC_FAIL_BINARY_OP_ADD_DIFFERENT_TYPES;
+                return binary_op_mixed_fail_kind(lhs, rhs,
+                    SPEC_FAIL_BINARY_OP_ADD_DIFFERENT_TYPES);
             }
             return SPEC_FAIL_BINARY_OP_ADD_OTHER;
         case NB_AND:
@@ -1703,40 +2025,51 @@ binary_op_fail_kind(int oparg, PyObject *lhs, PyObject *rhs)
                 return SPEC_FAIL_BINARY_OP_AND_DIFFERENT_TYPES;
             }
             if (PyLong_CheckExact(lhs)) {
-                return SPEC_FAIL_BINARY_OP_AND_INT;
+                return SPEC_FAIL_BINARY_OP_BIG_INT;
             }
             return SPEC_FAIL_BINARY_OP_AND_OTHER;
         case NB_FLOOR_DIVIDE:
         case NB_INPLACE_FLOOR_DIVIDE:
-            return SPEC_FAIL_BINARY_OP_FLOOR_DIVIDE;
+        case NB_REMAINDER:
+        case NB_INPLACE_REMAINDER:
+            if (is_compact_int(lhs) && is_compact_int(rhs)) {
+                return SPEC_FAIL_BINARY_OP_ZERO_DIVISOR;
+            }
+            return binary_op_int_fail_kind(lhs, rhs,
+                oparg == NB_FLOOR_DIVIDE || oparg == NB_INPLACE_FLOOR_DIVIDE ?
+                SPEC_FAIL_BINARY_OP_FLOOR_DIVIDE :
+                SPEC_FAIL_BINARY_OP_REMAINDER);
         case NB_LSHIFT:
         case NB_INPLACE_LSHIFT:
-            return SPEC_FAIL_BINARY_OP_LSHIFT;
+        case NB_RSHIFT:
+        case NB_INPLACE_RSHIFT:
+            if (is_compact_int(lhs) && is_compact_int(rhs)) {
+                return SPEC_FAIL_BINARY_OP_SHIFT_COUNT;
+            }
+            return binary_op_int_fail_kind(lhs, rhs,
+                oparg == NB_LSHIFT || oparg == NB_INPLACE_LSHIFT ?
+                SPEC_FAIL_BINARY_OP_LSHIFT : SPEC_FAIL_BINARY_OP_RSHIFT);
         case NB_MATRIX_MULTIPLY:
         case NB_INPLACE_MATRIX_MULTIPLY:
             return SPEC_FAIL_BINARY_OP_MATRIX_MULTIPLY;
         case NB_MULTIPLY:
         case NB_INPLACE_MULTIPLY:
             if (!Py_IS_TYPE(lhs, Py_TYPE(rhs))) {
-                return SPEC_FAIL_BINARY_OP_MULTIPLY_DIFFERENT_TYPES;
+                return binary_op_mixed_fail_kind(lhs, rhs,
+                    SPEC_FAIL_BINARY_OP_MULTIPLY_DIFFERENT_TYPES);
             }
             return SPEC_FAIL_BINARY_OP_MULTIPLY_OTHER;
         case NB_OR:
         case NB_INPLACE_OR:
-            return SPEC_FAIL_BINARY_OP_OR;
+            return binary_op_int_fail_kind(lhs, rhs, SPEC_FAIL_BINARY_OP_OR);
         case NB_POWER:
         case NB_INPLACE_POWER:
             return SPEC_FAIL_BINARY_OP_POWER;
-        case NB_REMAINDER:
-        case NB_INPLACE_REMAINDER:
-            return SPEC_FAIL_BINARY_OP_REMAINDER;
-        case NB_RSHIFT:
-        case NB_INPLACE_RSHIFT:
-            return SPEC_FAIL_BINARY_OP_RSHIFT;
         case NB_SUBTRACT:
         case NB_INPLACE_SUBTRACT:
             if (!Py_IS_TYPE(lhs, Py_TYPE(rhs))) {
-                return SPEC_FAIL_BINARY_OP_SUBTRACT_DIFFERENT_TYPES;
+                return binary_op_mixed_fail_kind(lhs, rhs,
+                    SPEC_FAIL_BINARY_OP_SUBTRACT_DIFFERENT_TYPES);
             }
             return SPEC_FAIL_BINARY_OP_SUBTRACT_OTHER;
         case NB_TRUE_DIVIDE:
@@ -1750,7 +2083,7 @@ binary_op_fail_kind(int oparg, PyObject *lhs, PyObject *rhs)
             return SPEC_FAIL_BINARY_OP_TRUE_DIVIDE_OTHER;
         case NB_XOR:
         case NB_INPLACE_XOR:
-            return SPEC_FAIL_BINARY_OP_XOR;
+            return binary_op_int_fail_kind(lhs, rhs, SPEC_FAIL_BINARY_OP_XOR);
     }
     Py_UNREACHABLE();
 }
@@ -1766,12 +2099,15 @@ _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
         case NB_ADD:
         case NB_INPLACE_ADD:
             if (!Py_IS_TYPE(lhs, Py_TYPE(rhs))) {
+                if (is_mixed_int_float(lhs, rhs)) {
+                    _Py_SET_OPCODE(*instr, BINARY_OP_MIXED_INT_FLOAT);
+                    goto success;
+                }
                 break;
             }
             if (PyUnicode_CheckExact(lhs)) {
                 _Py_CODEUNIT next = instr[INLINE_CACHE_ENTRIES_BINARY_OP + 1];
-                bool to_store = (_Py_OPCODE(next) == STORE_FAST ||
-                                 _Py_OPCODE(next) == STORE_FAST__LOAD_FAST);
+                bool to_store = _PyOpcode_Deopt[_Py_OPCODE(next)] == STORE_FAST;
                 if (to_store && locals[_Py_OPARG(next)] == lhs) {
                     _Py_SET_OPCODE(*instr, BINARY_OP_INPLACE_ADD_UNICODE);
                     goto success;
@@ -1791,6 +2127,10 @@ _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
         case NB_MULTIPLY:
         case NB_INPLACE_MULTIPLY:
             if (!Py_IS_TYPE(lhs, Py_TYPE(rhs))) {
+                if (is_mixed_int_float(lhs, rhs)) {
+                    _Py_SET_OPCODE(*instr, BINARY_OP_MIXED_INT_FLOAT);
+                    goto success;
+                }
                 break;
             }
             if (PyLong_CheckExact(lhs)) {
@@ -1805,6 +2145,10 @@ _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
         case NB_SUBTRACT:
         case NB_INPLACE_SUBTRACT:
             if (!Py_IS_TYPE(lhs, Py_TYPE(rhs))) {
+                if (is_mixed_int_float(lhs, rhs)) {
+                    _Py_SET_OPCODE(*instr, BINARY_OP_MIXED_INT_FLOAT);
+                    goto success;
+                }
                 break;
             }
             if (PyLong_CheckExact(lhs)) {
@@ -1816,6 +2160,31 @@ _Py_Specialize_BinaryOp(PyObject *lhs, PyObject *rhs, _Py_CODEUNIT *instr,
                 goto success;
             }
             break;
+        case NB_AND:
+        case NB_INPLACE_AND:
+        case NB_OR:
+        case NB_INPLACE_OR:
+        case NB_XOR:
+        case NB_INPLACE_XOR:
+        case NB_LSHIFT:
+        case NB_INPLACE_LSHIFT:
+        case NB_RSHIFT:
+        case NB_INPLACE_RSHIFT:
+        case NB_FLOOR_DIVIDE:
+        case NB_INPLACE_FLOOR_DIVIDE:
+        case NB_REMAINDER:
+        case NB_INPLACE_REMAINDER:
+        {
+            if (!is_compact_int(lhs) || !is_compact_int(rhs)) {
+                break;
+            }
+            int opcode = compact_int_binary_op(oparg, rhs);
+            if (opcode) {
+                _Py_SET_OPCODE(*instr, opcode);
+                goto success;
+            }
+            break;
+        }
 #ifndef Py_STATS
         default:
             // These operators don't have any available specializations. Rather
@@ -2083,3 +2452,147 @@ int
 }
 
 #endif
+
+void
+_Py_Specialize_ForIter(PyObject *iter, _Py_CODEUNIT *instr, int oparg)
+{
+    assert(_PyOpcode_Caches[FOR_ITER] == INLINE_CACHE_ENTRIES_FOR_ITER);
+    _PyForIterCache *cache = (_PyForIterCache *)(instr + 1);
+    PyTypeObject *tp = Py_TYPE(iter);
+    _Py_CODEUNIT next = instr[1 + INLINE_CACHE_ENTRIES_FOR_ITER];
+    int next_op = _PyOpcode_Deopt[_Py_OPCODE(next)];
+    if (tp == &PyListIter_Type) {
+        _Py_SET_OPCODE(*instr, FOR_ITER_LIST);
+        goto success;
+    }
+    else if (tp == &PyTupleIter_Type) {
+        _Py_SET_OPCODE(*instr, FOR_ITER_TUPLE);
+        goto success;
+    }
+    else if (tp == &PyRangeIter_Type && next_op == STORE_FAST) {
+        _Py_SET_OPCODE(*instr, FOR_ITER_RANGE);
+        goto success;
+    }
+    else if (tp == &PyGen_Type &&
+             _PyInterpreterState_GET()->eval_frame == NULL)
+    {
+        /* When the generator returns, the loop exit is found from the
+         * oparg of this instruction, which must fit in a single code unit */
+        if (oparg > 255) {
+            SPECIALIZATION_FAIL(FOR_ITER, SPEC_FAIL_OUT_OF_RANGE);
+            goto failure;
+        }
+        _Py_SET_OPCODE(*instr, FOR_ITER_GEN);
+        goto success;
+    }
+    SPECIALIZATION_FAIL(FOR_ITER,
+                        _PySpecialization_ClassifyIterator(iter));
+failure:
+    STAT_INC(FOR_ITER, failure);
+    cache->counter = adaptive_counter_backoff(cache->counter);
+    return;
+success:
+    STAT_INC(FOR_ITER, success);
+    cache->counter = miss_counter_start();
+}
+
+void
+_Py_Specialize_Send(PyObject *receiver, _Py_CODEUNIT *instr, int oparg)
+{
+    assert(_PyOpcode_Caches[SEND] == INLINE_CACHE_ENTRIES_SEND);
+    _PySendCache *cache = (_PySendCache *)(instr + 1);
+    PyTypeObject *tp = Py_TYPE(receiver);
+    if (tp == &PyGen_Type || tp == &PyCoro_Type) {
+        if (_PyInterpreterState_GET()->eval_frame) {
+            SPECIALIZATION_FAIL(SEND, SPEC_FAIL_OTHER);
+            goto failure;
+        }
+        /* As for FOR_ITER_GEN, the jump taken when the delegate returns
+         * is read from the oparg of this instruction */
+        if (oparg > 255) {
+            SPECIALIZATION_FAIL(SEND, SPEC_FAIL_OUT_OF_RANGE);
+            goto failure;
+        }
+        _Py_SET_OPCODE(*instr, SEND_GEN);
+        goto success;
+    }
+    SPECIALIZATION_FAIL(SEND,
+                        _PySpecialization_ClassifyIterator(receiver));
+failure:
+    STAT_INC(SEND, failure);
+    cache->counter = adaptive_counter_backoff(cache->counter);
+    return;
+success:
+    STAT_INC(SEND, success);
+    cache->counter = miss_counter_start();
+}
+
+#ifdef Py_STATS
+static int
+contains_op_fail_kind(PyObject *container)
+{
+    PyTypeObject *tp = Py_TYPE(container);
+    if (PyUnicode_CheckExact(container)) {
+        return SPEC_FAIL_CONTAINS_OP_STR_NON_STR;
+    }
+    if (PyTuple_CheckExact(container)) {
+        return SPEC_FAIL_CONTAINS_OP_BIG_TUPLE;
+    }
+    if (PyList_CheckExact(container)) {
+        return SPEC_FAIL_CONTAINS_OP_LIST;
+    }
+    if (PyBytes_CheckExact(container) || PyByteArray_CheckExact(container)) {
+        return SPEC_FAIL_CONTAINS_OP_BYTES;
+    }
+    if (PyRange_Check(container)) {
+        return SPEC_FAIL_CONTAINS_OP_RANGE;
+    }
+    if (PyDictKeys_Check(container) || PyDictItems_Check(container) ||
+        PyDictValues_Check(container))
+    {
+        return SPEC_FAIL_CONTAINS_OP_DICT_VIEW;
+    }
+    if (PyDict_Check(container) || PyAnySet_Check(container) ||
+        PyUnicode_Check(container) || PyTuple_Check(container))
+    {
+        return SPEC_FAIL_CONTAINS_OP_SUBCLASS;
+    }
+    if (tp->tp_flags & Py_TPFLAGS_HEAPTYPE) {
+        return SPEC_FAIL_CONTAINS_OP_PYTHON_CLASS;
+    }
+    return SPEC_FAIL_OTHER;
+}
+#endif
+
+void
+_Py_Specialize_ContainsOp(PyObject *item, PyObject *container,
+                          _Py_CODEUNIT *instr)
+{
+    assert(_PyOpcode_Caches[CONTAINS_OP] == INLINE_CACHE_ENTRIES_CONTAINS_OP);
+    _PyContainsOpCache *cache = (_PyContainsOpCache *)(instr + 1);
+    if (PyDict_CheckExact(container)) {
+        _Py_SET_OPCODE(*instr, CONTAINS_OP_DICT);
+        goto success;
+    }
+    if (PySet_CheckExact(container) || PyFrozenSet_CheckExact(container)) {
+        _Py_SET_OPCODE(*instr, CONTAINS_OP_SET);
+        goto success;
+    }
+    if (PyUnicode_CheckExact(container) && PyUnicode_CheckExact(item)) {
+        _Py_SET_OPCODE(*instr, CONTAINS_OP_STR);
+        goto success;
+    }
+    if (PyTuple_CheckExact(container) &&
+        PyTuple_GET_SIZE(container) <= CONTAINS_OP_TUPLE_MAX_SIZE)
+    {
+        _Py_SET_OPCODE(*instr, CONTAINS_OP_TUPLE);
+        goto success;
+    }
+    SPECIALIZATION_FAIL(CONTAINS_OP, contains_op_fail_kind(container));
+    STAT_INC(CONTAINS_OP, failure);
+    cache->counter = adaptive_counter_backoff(cache->counter);
+    return;
+success:
+    STAT_INC(CONTAINS_OP, success);
+    cache->counter = miss_counter_start();
+}
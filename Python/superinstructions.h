@@ -0,0 +1,110 @@
+// Auto-generated by Tools/scripts/generate_superinstructions.py from Lib/opcode.py
+// Included by Python/ceval.c inside the instruction switch.
+
+        TARGET(LOAD_CONST__LOAD_FAST) {
+            {
+                PyObject *value = GETITEM(consts, oparg);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NEXTOPARG();
+            next_instr++;
+            {
+                PyObject *value = GETLOCAL(oparg);
+                assert(value != NULL);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_CONST__STORE_FAST) {
+            PyObject *value = GETITEM(consts, oparg);
+            NEXTOPARG();
+            next_instr++;
+            Py_INCREF(value);
+            SETLOCAL(oparg, value);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_FAST__LOAD_CONST) {
+            {
+                PyObject *value = GETLOCAL(oparg);
+                assert(value != NULL);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NEXTOPARG();
+            next_instr++;
+            {
+                PyObject *value = GETITEM(consts, oparg);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_FAST__LOAD_FAST) {
+            {
+                PyObject *value = GETLOCAL(oparg);
+                assert(value != NULL);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NEXTOPARG();
+            next_instr++;
+            {
+                PyObject *value = GETLOCAL(oparg);
+                assert(value != NULL);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_FAST__POP_TOP) {
+            /* Reading a local that is known to be bound has no effect */
+            assert(GETLOCAL(oparg) != NULL);
+            next_instr++;
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(LOAD_FAST__STORE_FAST) {
+            PyObject *value = GETLOCAL(oparg);
+            assert(value != NULL);
+            NEXTOPARG();
+            next_instr++;
+            Py_INCREF(value);
+            SETLOCAL(oparg, value);
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(STORE_FAST__LOAD_FAST) {
+            {
+                PyObject *value = POP();
+                SETLOCAL(oparg, value);
+            }
+            NEXTOPARG();
+            next_instr++;
+            {
+                PyObject *value = GETLOCAL(oparg);
+                assert(value != NULL);
+                Py_INCREF(value);
+                PUSH(value);
+            }
+            NOTRACE_DISPATCH();
+        }
+
+        TARGET(STORE_FAST__STORE_FAST) {
+            {
+                PyObject *value = POP();
+                SETLOCAL(oparg, value);
+            }
+            NEXTOPARG();
+            next_instr++;
+            {
+                PyObject *value = POP();
+                SETLOCAL(oparg, value);
+            }
+            NOTRACE_DISPATCH();
+        }
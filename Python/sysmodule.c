@@ -19,6 +19,7 @@ Data members:
 #include "pycore_ceval.h"         // _PyEval_SetAsyncGenFinalizer()
 #include "pycore_code.h"          // _Py_QuickenedCount
 #include "pycore_frame.h"         // _PyInterpreterFrame
+#include "pycore_freelist.h"      // _PyObject_GetFreeList()
 #include "pycore_initconfig.h"    // _PyStatus_EXCEPTION()
 #include "pycore_namespace.h"     // _PyNamespace_New()
 #include "pycore_object.h"        // _PyObject_IS_GC()
@@ -1867,6 +1868,209 @@ sys__debugmallocstats_impl(PyObject *module)
     Py_RETURN_NONE;
 }
 
+static int
+set_size_item(PyObject *dict, const char *name, size_t value)
+{
+    PyObject *obj = PyLong_FromSize_t(value);
+    if (obj == NULL) {
+        return -1;
+    }
+    int res = PyDict_SetItemString(dict, name, obj);
+    Py_DECREF(obj);
+    return res;
+}
+
+/* Occupancy, limit and counters of the free lists of the interpreter */
+static PyObject *
+get_freelist_stats(PyInterpreterState *interp)
+{
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+    for (int kind = 0; kind < _Py_FREELIST_KINDS; kind++) {
+        Py_ssize_t numfree;
+        struct _Py_freelist_info *info = _PyObject_GetFreeList(interp, kind,
+                                                               &numfree);
+        if (info == NULL) {
+            continue;
+        }
+        PyObject *value = Py_BuildValue("{sn,si,sn,sn}",
+                                        "numfree", Py_MAX(numfree, 0),
+                                        "limit", info->limit,
+                                        "hits", (Py_ssize_t)info->hits,
+                                        "misses", (Py_ssize_t)info->misses);
+        if (value == NULL) {
+            goto error;
+        }
+        int res = PyDict_SetItemString(dict, _PyObject_GetFreeListName(kind),
+                                       value);
+        Py_DECREF(value);
+        if (res < 0) {
+            goto error;
+        }
+    }
+    return dict;
+
+error:
+    Py_DECREF(dict);
+    return NULL;
+}
+
+/*[clinic input]
+sys._set_freelist_limit
+
+    name: str
+    limit: int
+    /
+
+Set the maximum number of objects kept for reuse by a free list.
+
+The objects above the new limit are freed.  See _get_malloc_stats()
+for the names of the free lists.
+[clinic start generated code]*/
+
+static PyObject *
+sys__set_freelist_limit_impl(PyObject *module, const char *name, int limit)
+/*[clinic end generated code: output=c63b3a25a0bea717 input=bf1e87e0c2ea3e5e]*/
+{
+    if (limit < 0) {
+        PyErr_SetString(PyExc_ValueError, "limit must be >= 0");
+        return NULL;
+    }
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    for (int kind = 0; kind < _Py_FREELIST_KINDS; kind++) {
+        Py_ssize_t numfree;
+        if (strcmp(_PyObject_GetFreeListName(kind), name) != 0
+            || _PyObject_GetFreeList(interp, kind, &numfree) == NULL)
+        {
+            continue;
+        }
+        if (_PyObject_SetFreeListLimit(interp, kind, limit) < 0) {
+            return PyErr_NoMemory();
+        }
+        Py_RETURN_NONE;
+    }
+    PyErr_Format(PyExc_ValueError, "unknown free list: %s", name);
+    return NULL;
+}
+
+/*[clinic input]
+sys._get_malloc_stats
+
+Return a dict of statistics of pymalloc and of the free lists.
+
+The pymalloc keys are missing if pymalloc is not used.  Unlike
+_debugmallocstats(), this only visits the pool headers.
+[clinic start generated code]*/
+
+static PyObject *
+sys__get_malloc_stats_impl(PyObject *module)
+/*[clinic end generated code: output=2502670df34d4e73 input=a3da96491787b721]*/
+{
+    struct _PyObject_MallocStats stats;
+    PyObject *dict = PyDict_New();
+    if (dict == NULL) {
+        return NULL;
+    }
+
+    PyObject *freelists = get_freelist_stats(_PyInterpreterState_GET());
+    if (freelists == NULL) {
+        goto error;
+    }
+    int res = PyDict_SetItemString(dict, "freelists", freelists);
+    Py_DECREF(freelists);
+    if (res < 0) {
+        goto error;
+    }
+
+    if (!_PyObject_GetMallocStats(&stats)) {
+        return dict;
+    }
+
+#define SET_ITEM(NAME) \
+    do { \
+        if (set_size_item(dict, #NAME, stats.NAME) < 0) { \
+            goto error; \
+        } \
+    } while (0)
+
+    SET_ITEM(arenas_allocated);
+    SET_ITEM(arenas_allocated_total);
+    SET_ITEM(arenas_highwater);
+    SET_ITEM(arenas_hugepages);
+    SET_ITEM(pools_released);
+    SET_ITEM(pools_released_total);
+    SET_ITEM(release_passes);
+    SET_ITEM(bytes_released);
+    SET_ITEM(arena_size);
+    SET_ITEM(pool_size);
+    SET_ITEM(pools_free);
+    SET_ITEM(bytes_allocated);
+    SET_ITEM(bytes_available);
+    SET_ITEM(bytes_cached);
+    SET_ITEM(bytes_pool_headers);
+    SET_ITEM(bytes_quantization);
+    SET_ITEM(bytes_arena_alignment);
+    SET_ITEM(bytes_arena_map);
+    SET_ITEM(arena_map_mid_nodes);
+    SET_ITEM(arena_map_bot_nodes);
+#undef SET_ITEM
+
+    /* Share of the resident arena memory not used by blocks in use */
+    double fragmentation = 0.0;
+    size_t resident = (stats.arenas_allocated * stats.arena_size
+                       - stats.bytes_released);
+    if (resident != 0) {
+        fragmentation = 1.0 - (double)stats.bytes_allocated / resident;
+    }
+    PyObject *value = PyFloat_FromDouble(fragmentation);
+    if (value == NULL) {
+        goto error;
+    }
+    res = PyDict_SetItemString(dict, "fragmentation", value);
+    Py_DECREF(value);
+    if (res < 0) {
+        goto error;
+    }
+
+    /* {block size: (pools, blocks in use, free blocks)} */
+    PyObject *classes = PyDict_New();
+    if (classes == NULL) {
+        goto error;
+    }
+    res = PyDict_SetItemString(dict, "size_classes", classes);
+    Py_DECREF(classes);
+    if (res < 0) {
+        goto error;
+    }
+    for (size_t i = 0; i < stats.nsize_classes; i++) {
+        PyObject *key = PyLong_FromSize_t(stats.size_classes[i].block_size);
+        if (key == NULL) {
+            goto error;
+        }
+        value = Py_BuildValue("(nnn)",
+                              (Py_ssize_t)stats.size_classes[i].pools,
+                              (Py_ssize_t)stats.size_classes[i].blocks,
+                              (Py_ssize_t)stats.size_classes[i].free_blocks);
+        if (value == NULL) {
+            Py_DECREF(key);
+            goto error;
+        }
+        res = PyDict_SetItem(classes, key, value);
+        Py_DECREF(key);
+        Py_DECREF(value);
+        if (res < 0) {
+            goto error;
+        }
+    }
+    return dict;
+
+error:
+    Py_DECREF(dict);
+    return NULL;
+}
+
 #ifdef Py_TRACE_REFS
 /* Defined in objects.c because it uses static globals in that file */
 extern PyObject *_Py_GetObjects(PyObject *, PyObject *);
@@ -1971,6 +2175,8 @@ static PyMethodDef sys_methods[] = {
     SYS_GETTRACE_METHODDEF
     SYS_CALL_TRACING_METHODDEF
     SYS__DEBUGMALLOCSTATS_METHODDEF
+    SYS__GET_MALLOC_STATS_METHODDEF
+    SYS__SET_FREELIST_LIMIT_METHODDEF
     SYS_SET_COROUTINE_ORIGIN_TRACKING_DEPTH_METHODDEF
     SYS_GET_COROUTINE_ORIGIN_TRACKING_DEPTH_METHODDEF
     {"set_asyncgen_hooks", _PyCFunction_CAST(sys_set_asyncgen_hooks),
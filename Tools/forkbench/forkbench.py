@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+"""Measure how much memory forked worker processes share with their parent.
+
+A prefork server loads its data in a parent process, then forks workers
+which serve requests.  The pages of the parent stay shared with the workers
+until either side writes to them (copy-on-write).  This benchmark builds such
+a heap, forks N children which each serve requests touching part of it, and
+reports the memory shared with the other processes and the memory private to
+each child, as seen in /proc/<pid>/smaps_rollup (Linux only).
+
+The heap is prepared in one of several ways (see --mode):
+
+    plain       nothing special, the collector is enabled in the children
+    freeze      gc.freeze() before forking
+    isolate     gc.freeze(isolate=True) before forking
+
+Each mode runs in a fresh interpreter, so they can be compared in one call:
+
+    ./python Tools/forkbench/forkbench.py -n 4 --mode plain freeze isolate
+"""
+
+import argparse
+import gc
+import os
+import random
+import subprocess
+import sys
+import time
+
+
+def read_smaps(pid="self"):
+    """Return a dict of the memory counters of a process, in KiB."""
+    path = f"/proc/{pid}/smaps_rollup"
+    if not os.path.exists(path):
+        path = f"/proc/{pid}/smaps"
+    counters = {}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if len(fields) == 3 and fields[2] == "kB":
+                key = fields[0].rstrip(":")
+                counters[key] = counters.get(key, 0) + int(fields[1])
+    return counters
+
+
+def build_heap(nobjects, garbage):
+    """Build the parent's data, as loaded at startup by a server."""
+    rng = random.Random(0)
+    records = []
+    temporary = []
+    for i in range(nobjects):
+        records.append({
+            "id": i,
+            "name": f"user{i}",
+            "score": rng.random(),
+            "tags": [f"tag{rng.randrange(100)}" for j in range(3)],
+            "history": (i, i * 2, str(i)),
+        })
+        # Startup also creates objects which die before the fork, leaving
+        # holes between the long lived ones.
+        if rng.random() < garbage:
+            temporary.append([str(i), {"i": i}])
+    del temporary
+    return records
+
+
+def serve(records, nrequests, touch, nlocal):
+    """Serve requests: read part of the shared data, allocate temporaries
+    and keep some objects of the child's own in a cache."""
+    rng = random.Random(os.getpid())
+    cache = {}
+    count = max(1, int(len(records) * touch / nrequests))
+    nlocal = max(1, nlocal // nrequests)
+    for r in range(nrequests):
+        response = []
+        for record in rng.sample(records, count):
+            response.append({"id": record["id"], "name": record["name"],
+                             "tags": list(record["tags"])})
+        for i in range(nlocal):
+            cache[r, i] = [f"session{r}-{i}", {"request": r}]
+    return cache
+
+
+def child(records, args, result_w, release_r):
+    gc.enable()
+    start = time.perf_counter()
+    cache = serve(records, args.requests, args.touch, args.local)
+    gc.collect()
+    elapsed = time.perf_counter() - start
+    counters = read_smaps()
+    shared = counters.get("Shared_Clean", 0) + counters.get("Shared_Dirty", 0)
+    private = (counters.get("Private_Clean", 0)
+               + counters.get("Private_Dirty", 0))
+    os.write(result_w, f"{shared} {private} {elapsed}\n".encode())
+    # Stay alive until every child is measured
+    os.read(release_r, 1)
+    del cache
+    os._exit(0)
+
+
+def run_mode(args):
+    gc.disable()
+    records = build_heap(args.objects, args.garbage)
+    if args.mode[0] == "freeze":
+        gc.freeze()
+    elif args.mode[0] == "isolate":
+        gc.freeze(isolate=True)
+    elif args.mode[0] == "plain":
+        gc.enable()
+    parent = read_smaps()
+
+    result_r, result_w = os.pipe()
+    release_r, release_w = os.pipe()
+    pids = []
+    for i in range(args.nchildren):
+        pid = os.fork()
+        if pid == 0:
+            os.close(result_r)
+            os.close(release_w)
+            try:
+                child(records, args, result_w, release_r)
+            finally:
+                os._exit(1)
+        pids.append(pid)
+    os.close(result_w)
+    os.close(release_r)
+
+    results = []
+    with os.fdopen(result_r) as f:
+        for i in range(args.nchildren):
+            shared, private, elapsed = f.readline().split()
+            results.append((int(shared), int(private), float(elapsed)))
+    os.close(release_w)
+    for pid in pids:
+        os.waitpid(pid, 0)
+
+    n = len(results)
+    shared = sum(r[0] for r in results) / n
+    private = sum(r[1] for r in results) / n
+    elapsed = sum(r[2] for r in results) / n
+    print(f"{args.mode[0]:8} parent rss {parent.get('Rss', 0) / 1024:8.1f} MiB"
+          f"  child shared {shared / 1024:8.1f} MiB"
+          f"  private {private / 1024:8.1f} MiB"
+          f"  ({100 * private / (shared + private):4.1f}% private)"
+          f"  requests {elapsed:6.2f} s")
+    sys.stdout.flush()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--nchildren", type=int, default=4,
+                        help="number of forked children (default: 4)")
+    parser.add_argument("--objects", type=int, default=200_000,
+                        help="number of records in the parent (default: "
+                             "200000)")
+    parser.add_argument("--garbage", type=float, default=0.5,
+                        help="temporary objects created at startup per "
+                             "record (default: 0.5)")
+    parser.add_argument("--requests", type=int, default=1000,
+                        help="requests served by each child (default: 1000)")
+    parser.add_argument("--touch", type=float, default=0.2,
+                        help="fraction of the records read by all the "
+                             "requests of a child (default: 0.2)")
+    parser.add_argument("--local", type=int, default=50_000,
+                        help="objects created and kept by each child "
+                             "(default: 50000)")
+    parser.add_argument("--mode", nargs="+", default=["plain", "freeze",
+                                                       "isolate"],
+                        choices=["plain", "freeze", "isolate"],
+                        help="how to prepare the heap before forking "
+                             "(default: all)")
+    args = parser.parse_args()
+
+    if not hasattr(os, "fork") or not os.path.exists("/proc/self/smaps"):
+        sys.exit("this benchmark needs fork() and /proc/<pid>/smaps")
+
+    if len(args.mode) == 1:
+        run_mode(args)
+        return
+    for mode in args.mode:
+        cmd = [sys.executable, __file__, "--mode", mode]
+        for name in ("nchildren", "objects", "garbage", "requests", "touch",
+                     "local"):
+            cmd += [f"--{name}", str(getattr(args, name))]
+        subprocess.run(cmd, check=True)
+
+
+if __name__ == "__main__":
+    main()
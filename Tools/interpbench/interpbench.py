@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Measure how CPU-bound code scales over threads running subinterpreters.
+
+Isolated subinterpreters run under their own GIL, so threads running them
+execute Python code in parallel, while threads of a single interpreter take
+turns holding its GIL.  This benchmark runs the same CPU-bound work in N
+threads, each either in its own subinterpreter or all in the main
+interpreter (see --mode), and reports the wall clock time and the speedup
+over a single thread:
+
+    isolated    one isolated subinterpreter per thread (own GIL)
+    shared      one non-isolated subinterpreter per thread (shared GIL)
+    threads     plain threads of the main interpreter
+
+The speedup of the isolated mode is bounded by the number of CPUs:
+
+    ./python Tools/interpbench/interpbench.py -n 1 2 4 --mode isolated threads
+"""
+
+import argparse
+import os
+import sys
+import threading
+import time
+from textwrap import dedent
+
+try:
+    import _xxsubinterpreters as interpreters
+except ImportError:
+    interpreters = None
+
+
+WORK = dedent("""
+    def work(loops):
+        total = 0
+        for i in range(loops):
+            total += i * i % 7
+        items = {}
+        for i in range(loops // 10):
+            items[str(i)] = [i, (i, str(i))]
+        return total + len(items)
+    """)
+
+
+def run_threads(nthreads, loops, mode):
+    """Return the wall clock time to run the work once in each of nthreads
+    threads."""
+    if mode == "threads":
+        ns = {}
+        exec(WORK, ns)
+        def target(id):
+            ns["work"](loops)
+        ids = list(range(nthreads))
+    else:
+        isolated = (mode == "isolated")
+        ids = [interpreters.create(isolated=isolated) for _ in range(nthreads)]
+        for id in ids:
+            interpreters.run_string(id, WORK)
+        script = f"work({loops})"
+        def target(id):
+            interpreters.run_string(id, script)
+
+    threads = [threading.Thread(target=target, args=(id,)) for id in ids]
+    start = time.perf_counter()
+    for t in threads:
+        t.start()
+    for t in threads:
+        t.join()
+    elapsed = time.perf_counter() - start
+
+    if mode != "threads":
+        for id in ids:
+            interpreters.destroy(id)
+    return elapsed
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("-n", "--nthreads", type=int, nargs="+",
+                        default=[1, 2, 4],
+                        help="numbers of threads to compare (default: 1 2 4)")
+    parser.add_argument("--loops", type=int, default=2_000_000,
+                        help="iterations of the work in each thread "
+                             "(default: 2000000)")
+    parser.add_argument("--repeat", type=int, default=3,
+                        help="runs of each configuration, the best one is "
+                             "kept (default: 3)")
+    parser.add_argument("--mode", nargs="+",
+                        default=["isolated", "shared", "threads"],
+                        choices=["isolated", "shared", "threads"],
+                        help="how to run the threads (default: all)")
+    args = parser.parse_args()
+
+    if interpreters is None:
+        sys.exit("this benchmark needs the _xxsubinterpreters module")
+
+    print(f"{os.cpu_count()} CPUs, {args.loops} loops per thread")
+    for mode in args.mode:
+        base = None
+        for n in args.nthreads:
+            elapsed = min(run_threads(n, args.loops, mode)
+                          for _ in range(args.repeat))
+            if base is None:
+                base = elapsed / n
+            # Serial time of the work of n threads over the parallel time
+            speedup = base * n / elapsed
+            print(f"{mode:8} {n:3} threads  {elapsed:7.3f} s"
+                  f"  speedup {speedup:5.2f}x")
+            sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -250,6 +250,7 @@ def generate_code(self, name: str, code: types.CodeType) -> str:
             self.write(f".co_exceptiontable = {co_exceptiontable},")
             self.field(code, "co_flags")
             self.write(".co_warmup = QUICKENING_INITIAL_WARMUP_VALUE,")
+            self.write(".co_optimizer_warmup = OPTIMIZER_WARMUP,")
             self.field(code, "co_argcount")
             self.field(code, "co_posonlyargcount")
             self.field(code, "co_kwonlyargcount")
@@ -118,6 +118,7 @@ def main(opcode_py, outfile='Include/opcode.h', internaloutfile='Include/interna
         iobj.write("\nextern const uint8_t _PyOpcode_Caches[256];\n")
         iobj.write("\nextern const uint8_t _PyOpcode_Deopt[256];\n")
         iobj.write("\nextern const uint8_t _PyOpcode_Original[256];\n")
+        iobj.write("\nextern const uint8_t _PyOpcode_SuperinstructionSecond[256];\n")
         iobj.write("\n#ifdef NEED_OPCODE_TABLES\n")
         write_int_array_from_ops("_PyOpcode_RelativeJump", opcode['hasjrel'], iobj)
         write_int_array_from_ops("_PyOpcode_Jump", opcode['hasjrel'] + opcode['hasjabs'], iobj)
@@ -144,8 +145,32 @@ def main(opcode_py, outfile='Include/opcode.h', internaloutfile='Include/interna
                 deopt = "EXTENDED_ARG_QUICK"
             iobj.write(f"    [{opt}] = {deopt},\n")
         iobj.write("};\n")
+        iobj.write("\nconst uint8_t _PyOpcode_SuperinstructionSecond[256] = {\n")
+        for first, second in sorted(opcode["_superinstructions"]):
+            iobj.write(f"    [{first}__{second}] = {second},\n")
+        iobj.write("};\n")
         iobj.write("#endif   // NEED_OPCODE_TABLES\n")
 
+        iobj.write("\n")
+        iobj.write("static inline int\n")
+        iobj.write("_PyOpcode_Superinstruction(int first, int second)\n")
+        iobj.write("{\n")
+        iobj.write("    switch (first) {\n")
+        seconds = {}
+        for first, second in opcode["_superinstructions"]:
+            seconds.setdefault(first, []).append(second)
+        for first in sorted(seconds):
+            iobj.write(f"        case {first}:\n")
+            iobj.write("            switch (second) {\n")
+            for second in sorted(seconds[first]):
+                iobj.write(f"                case {second}:\n")
+                iobj.write(f"                    return {first}__{second};\n")
+            iobj.write("            }\n")
+            iobj.write("            break;\n")
+        iobj.write("    }\n")
+        iobj.write("    return 0;\n")
+        iobj.write("}\n")
+
         fobj.write("\n")
         fobj.write("#define HAS_CONST(op) (false\\")
         for op in hasconst:
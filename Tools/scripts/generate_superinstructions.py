@@ -0,0 +1,263 @@
+"""Select and generate the superinstructions used by the interpreter.
+
+A superinstruction fuses two adjacent simple instructions so that the
+second one runs without going through dispatch.  The set of pairs is kept
+in the ``_superinstructions`` list in Lib/opcode.py; everything else
+(opcode numbers, the deopt tables, the quickening lookup in
+Include/internal/pycore_opcode.h and the instruction bodies in
+Python/superinstructions.h) is derived from that list.
+
+To pick the pairs from a profile, build with --enable-pystats, run a
+representative workload (for example pyperformance) so that the stats are
+dumped into the default stats folder, then run:
+
+    python Tools/scripts/generate_superinstructions.py --stats -n 5 \\
+        Lib/opcode.py Python/superinstructions.h
+    make regen-opcode regen-opcode-targets
+
+The stats must come from a build of the same Lib/opcode.py, since they
+record opcodes by number.  Without --stats the list in Lib/opcode.py is
+left alone and only Python/superinstructions.h is regenerated; this is
+what "make regen-superinstructions" does.
+"""
+
+import argparse
+import collections
+import os
+import re
+import sys
+import tokenize
+
+SCRIPT_NAME = "Tools/scripts/generate_superinstructions.py"
+PYTHON_OPCODE = "Lib/opcode.py"
+
+if os.name == "nt":
+    DEFAULT_DIR = "c:\\temp\\py_stats\\"
+else:
+    DEFAULT_DIR = "/tmp/py_stats/"
+
+# Bodies of the instructions that may appear in a superinstruction.
+# Only instructions without inline caches that can neither fail nor jump
+# are eligible, so that the fused body never needs to leave in the middle.
+TEMPLATES = {
+    "LOAD_FAST": [
+        "PyObject *value = GETLOCAL(oparg);",
+        "assert(value != NULL);",
+        "Py_INCREF(value);",
+        "PUSH(value);",
+    ],
+    "LOAD_CONST": [
+        "PyObject *value = GETITEM(consts, oparg);",
+        "Py_INCREF(value);",
+        "PUSH(value);",
+    ],
+    "STORE_FAST": [
+        "PyObject *value = POP();",
+        "SETLOCAL(oparg, value);",
+    ],
+    "POP_TOP": [
+        "PyObject *value = POP();",
+        "Py_DECREF(value);",
+    ],
+    "PUSH_NULL": [
+        "BASIC_PUSH(NULL);",
+    ],
+    "COPY": [
+        "assert(oparg != 0);",
+        "PyObject *peek = PEEK(oparg);",
+        "Py_INCREF(peek);",
+        "PUSH(peek);",
+    ],
+    "SWAP": [
+        "assert(oparg != 0);",
+        "PyObject *top = TOP();",
+        "SET_TOP(PEEK(oparg));",
+        "PEEK(oparg) = top;",
+    ],
+}
+
+# Bodies for pairs where the value produced by the first instruction is
+# consumed by the second one.  The value is kept in a C local rather than
+# being pushed to and popped from the frame's value stack, and reference
+# count changes that would cancel out are left out.  Here "oparg" is the
+# argument of the first instruction until NEXTOPARG() loads the second one.
+FUSED = {
+    ("LOAD_CONST", "STORE_FAST"): [
+        "PyObject *value = GETITEM(consts, oparg);",
+        "NEXTOPARG();",
+        "next_instr++;",
+        "Py_INCREF(value);",
+        "SETLOCAL(oparg, value);",
+    ],
+    ("LOAD_FAST", "STORE_FAST"): [
+        "PyObject *value = GETLOCAL(oparg);",
+        "assert(value != NULL);",
+        "NEXTOPARG();",
+        "next_instr++;",
+        "Py_INCREF(value);",
+        "SETLOCAL(oparg, value);",
+    ],
+    ("LOAD_FAST", "POP_TOP"): [
+        "/* Reading a local that is known to be bound has no effect */",
+        "assert(GETLOCAL(oparg) != NULL);",
+        "next_instr++;",
+    ],
+}
+
+header = f"""
+// Auto-generated by {SCRIPT_NAME} from {PYTHON_OPCODE}
+// Included by Python/ceval.c inside the instruction switch.
+""".lstrip()
+
+
+def load_opcode(opcode_py):
+    opcode = {}
+    with tokenize.open(opcode_py) as fp:
+        code = fp.read()
+    exec(code, opcode)
+    return opcode
+
+
+def superinstruction_name(first, second):
+    return f"{first}__{second}"
+
+
+def full_opname(opcode):
+    """Return the name of every opcode, specialized ones included,
+    numbered the same way as Tools/scripts/generate_opcode_h.py does."""
+    opname = list(opcode["opname"])
+    specialized = iter(opcode["_specialized_instructions"])
+    for i in range(1, 255):
+        if opname[i].startswith("<"):
+            try:
+                opname[i] = next(specialized)
+            except StopIteration:
+                break
+    opname[255] = "DO_TRACING"
+    return opname
+
+
+def deopt_map(opcode):
+    deopt = {name: name for name in opcode["opmap"]}
+    for basic, family in opcode["_specializations"].items():
+        for specialized in family:
+            deopt[specialized] = basic
+    return deopt
+
+
+def gather_pair_counts(opcode, stats_dir):
+    """Sum the pair counts of all stats files in *stats_dir*, in terms of
+    unspecialized instructions."""
+    opname = full_opname(opcode)
+    deopt = deopt_map(opcode)
+    halves = {superinstruction_name(*pair): pair
+              for pair in opcode["_superinstructions"]}
+    pattern = re.compile(r"opcode\[(\d+)\]\.pair_count\[(\d+)\]")
+    pairs = collections.Counter()
+    for filename in os.listdir(stats_dir):
+        with open(os.path.join(stats_dir, filename)) as fd:
+            for line in fd:
+                key, _, value = line.partition(":")
+                match = pattern.fullmatch(key.strip())
+                if match is None:
+                    continue
+                first, second = (opname[int(n)] for n in match.groups())
+                count = int(value)
+                # A superinstruction is counted once, under its own name,
+                # for the two instructions it executes.
+                if first in halves:
+                    pairs[halves[first]] += count
+                    first = halves[first][1]
+                pairs[deopt.get(first, first), deopt.get(second, second)] += count
+    return pairs
+
+
+def select_superinstructions(pairs, limit):
+    candidates = [
+        (count, pair) for pair, count in pairs.items()
+        if pair[0] in TEMPLATES and pair[1] in TEMPLATES
+    ]
+    candidates.sort(key=lambda item: (-item[0], item[1]))
+    return sorted(pair for _, pair in candidates[:limit])
+
+
+def free_opcodes(opcode):
+    superinstructions = {superinstruction_name(*pair)
+                         for pair in opcode["_superinstructions"]}
+    specialized = [name for name in opcode["_specialized_instructions"]
+                   if name not in superinstructions]
+    # Opcode 0 and DO_TRACING (255) are never available.
+    return 254 - len(opcode["opmap"]) - len(specialized)
+
+
+def update_opcode_py(opcode_py, superinstructions):
+    with open(opcode_py, encoding="utf-8") as fp:
+        source = fp.read()
+    lines = "".join(f"    {pair!r},\n" for pair in superinstructions)
+    source, count = re.subn(r"^_superinstructions = \[\n.*?^\]\n",
+                            f"_superinstructions = [\n{lines}]\n",
+                            source, flags=re.MULTILINE | re.DOTALL)
+    if count != 1:
+        sys.exit(f"Cannot find the _superinstructions list in {opcode_py}")
+    with open(opcode_py, "w", encoding="utf-8") as fp:
+        fp.write(source)
+
+
+def write_superinstructions(superinstructions, out):
+    out.write(header)
+    for first, second in superinstructions:
+        for name in (first, second):
+            if name not in TEMPLATES:
+                sys.exit(f"{name} cannot be part of a superinstruction")
+        out.write("\n")
+        out.write(f"        TARGET({superinstruction_name(first, second)}) {{\n")
+        if (first, second) in FUSED:
+            for line in FUSED[first, second]:
+                out.write(f"            {line}\n")
+            out.write("            NOTRACE_DISPATCH();\n")
+            out.write("        }\n")
+            continue
+        out.write("            {\n")
+        for line in TEMPLATES[first]:
+            out.write(f"                {line}\n")
+        out.write("            }\n")
+        out.write("            NEXTOPARG();\n")
+        out.write("            next_instr++;\n")
+        out.write("            {\n")
+        for line in TEMPLATES[second]:
+            out.write(f"                {line}\n")
+        out.write("            }\n")
+        out.write("            NOTRACE_DISPATCH();\n")
+        out.write("        }\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("opcode_py", help="path to Lib/opcode.py")
+    parser.add_argument("output", help="path to Python/superinstructions.h")
+    parser.add_argument("--stats", nargs="?", const=DEFAULT_DIR,
+                        metavar="DIR",
+                        help="select the superinstructions from the pair "
+                             f"counts in DIR (default: {DEFAULT_DIR})")
+    parser.add_argument("-n", type=int, default=5,
+                        help="number of superinstructions to select "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    opcode = load_opcode(args.opcode_py)
+    superinstructions = opcode["_superinstructions"]
+    if args.stats is not None:
+        limit = min(args.n, free_opcodes(opcode))
+        pairs = gather_pair_counts(opcode, args.stats)
+        superinstructions = select_superinstructions(pairs, limit)
+        update_opcode_py(args.opcode_py, superinstructions)
+        print(f"{args.opcode_py} updated with {len(superinstructions)} "
+              f"superinstructions from {args.stats}")
+
+    with open(args.output, "w") as out:
+        write_superinstructions(superinstructions, out)
+    print(f"{args.output} regenerated from {args.opcode_py}")
+
+
+if __name__ == "__main__":
+    main()